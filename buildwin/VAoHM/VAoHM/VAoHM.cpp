@@ -35,6 +35,10 @@ DEFINE_bool(disable_multi_thread,       false,          "It would slightly reduc
                                                         " for 1) Cases where it is needed a low latency (e.g. webcam in real-time scenarios with"
                                                         " low-range GPU devices); and 2) Debugging OpenPose when it is crashing to locate the"
                                                         " error.");
+DEFINE_int32(num_cpu_threads,           0,              "Number of extra CPU threads used to split the CPU loops of each step (resizing, NMS,"
+                                                        " body part connection, etc.) with a work-stealing thread pool. 0 to disable it, -1 for the"
+                                                        " number of CPU cores minus 1 (the calling thread also runs part of each loop, so all the"
+                                                        " cores are used).");
 DEFINE_int32(profile_speed,             1000,           "If PROFILER_ENABLED was set in CMake or Makefile.config files, OpenPose will show some"
                                                         " runtime statistics at this frame number.");
 // Producer
@@ -48,6 +52,12 @@ DEFINE_double(camera_fps,               30.0,           "Frame rate for the webc
 DEFINE_string(video,                    "examples/media/resized/cutted/IMG_5852.mp4",             "Use a video file instead of the camera. Use `examples/media/video.avi` for our default  "
                                                         " example video.");
 DEFINE_string(video_output, "examples/media/export/IMG_5852.mp4", "");
+DEFINE_int32(video_output_queue, 64, "Number of frames buffered for the asynchronous H.264 encoding of `video_output`. Select 0"
+                                     " to encode them on the output thread.");
+DEFINE_bool(video_output_drop, false, "If the `video_output` encoding queue is full, drop the new frames instead of waiting for"
+                                      " the encoder (i.e., the encoder never slows down the pose estimation).");
+DEFINE_string(write_rep_events, "", "File path to append one JSON line per repetition (person ID, exercise, frame, time,"
+                                    " phase durations and confidence).");
 DEFINE_int32(aspect_ratio_rotate, 90, "Rotate each frame, 4 possible values: 0, 90, 180, 270.");
 DEFINE_int32(frame_rotate, 0, "Rotate each frame, 4 possible values: 0, 90, 180, 270.");
 DEFINE_string(image_dir,                "",             "Process a directory of images. Use `examples/media/` for our default example folder with 20"
@@ -61,6 +71,10 @@ DEFINE_bool(frame_flip,                 false,          "Flip/mirror each frame
 DEFINE_bool(frames_repeat,              false,          "Repeat frames when finished.");
 DEFINE_bool(process_real_time,          false,          "Enable to keep the original source frame rate (e.g. for video). If the processing time is"
                                                         " too long, it will skip frames. If it is too fast, it will slow it down.");
+DEFINE_int32(queue_policy,              0,              "What to do with new frames when OpenPose is slower than the producer (e.g. real-time"
+                                                        " webcam or IP camera). 0 to wait (all frames are processed), 1 to drop the newest frame,"
+                                                        " 2 to drop the oldest queued frame, 3 to only keep the latest frame. Options 1-3 keep the"
+                                                        " latency bounded during processing load spikes.");
 DEFINE_string(camera_parameter_folder,  "models/cameraParameters/flir/", "String with the folder where the camera parameters are located.");
 // OpenPose
 DEFINE_string(model_folder,             "models/",      "Folder path (absolute or relative) where the models (pose, face, ...) are located.");
@@ -96,6 +110,22 @@ DEFINE_int32(scale_number,              1,              "Number of scales to ave
 DEFINE_double(scale_gap,                0.3,            "Scale gap between scales. No effect unless scale_number > 1. Initial scale is always 1."
                                                         " If you want to change the initial scale, you actually want to multiply the"
                                                         " `net_resolution` by your desired initial scale.");
+DEFINE_bool(nms_coarse_to_fine,         false,          "CPU version only. If true, the NMS and body part connection will run on the net output"
+                                                        " resolution, only upsampling it around the peak candidates, rather than upsampling all"
+                                                        " the heat maps to `net_resolution`. Faster, but results are approximated. No effect if"
+                                                        " `scale_number` > 1 or if any heat map is returned.");
+DEFINE_int32(net_batch_size,            1,              "Offline processing only (e.g. recorded videos or image directories). If greater than 1,"
+                                                        " the frames will be kept until `net_batch_size` of them are received, so the net runs a"
+                                                        " single batched forward pass on all of them. Higher throughput (mainly in the CPU"
+                                                        " version) but higher latency. Ignored with the adaptive tracking interval"
+                                                        " (`tracking_max_displacement`).");
+DEFINE_int32(net_cache_size,            1,              "Number of net input sizes kept ready in memory, so alternating among them (e.g. image"
+                                                        " directories with mixed aspect ratios and `-1` in `net_resolution`) does not reshape the"
+                                                        " net on every change. Each one adds the memory of the net intermediate results (weights"
+                                                        " are shared).");
+DEFINE_string(net_cache_resolutions,    "",             "Comma-separated net input sizes (multiples of 16, no `-1`, e.g. `656x368,368x656`)"
+                                                        " prepared when the net is initialized rather than on their first frame. Use it together"
+                                                        " with `net_cache_size`.");
 // OpenPose Body Pose Heatmaps and Part Candidates
 DEFINE_bool(heatmaps_add_parts,         false,          "If true, it will fill op::Datum::poseHeatMaps array with the body part heatmaps, and"
                                                         " analogously face & hand heatmaps to op::Datum::faceHeatMaps & op::Datum::handHeatMaps."
@@ -151,7 +181,12 @@ DEFINE_int32(3d_views,                  1,              "Complementary option to
                                                         " `--camera_parameters_folder` must be set. OpenPose must find as many `xml` files in the"
                                                         " parameter folder as this number indicates.");
 // OpenPose identification
-DEFINE_bool(identification,             false,          "Whether to enable people identification across frames. Not available yet, coming soon.");
+DEFINE_bool(identification,             false,          "Whether to enable people identification across frames (consistent IDs by matching the"
+                                                        " keypoints of consecutive frames). Used by the keypoint filter and the exercise counter to"
+                                                        " keep per-person state.");
+DEFINE_bool(filter_keypoints,           false,          "Whether to smooth the body keypoints across frames and fill the keypoints missed during a"
+                                                        " few frames. It avoids counting errors when a wrist or ankle is missed for a frame. With"
+                                                        " more than 1 person, enable `identification` too (otherwise people are matched by index).");
 // OpenPose Rendering
 DEFINE_int32(part_to_show,              0,              "Prediction channel to visualize (default: 0). 0 for all the body parts, 1-18 for each body"
                                                         " part heat map, 19 for the background heat map, 20 for all the body part heat maps"
@@ -206,6 +241,12 @@ DEFINE_string(write_heatmaps,           "",             "Directory to write body
 DEFINE_string(write_heatmaps_format,    "png",          "File extension and format for `write_heatmaps`, analogous to `write_images_format`."
                                                         " For lossless compression, recommended `png` for integer `heatmaps_scale` and `float` for"
                                                         " floating values.");
+DEFINE_string(write_metrics,            "",             "Full file path to append (every 5 seconds) a JSON line with the pipeline metrics: work"
+                                                        " time of each worker, waiting times of each thread, and size and dropped frames of each"
+                                                        " queue.");
+DEFINE_string(write_trace,              "",             "Full file path to write (when OpenPose stops) a Chrome trace JSON with the timeline of the"
+                                                        " pipeline: a span per worker and frame, plus the inner steps of the pose estimation. Open"
+                                                        " it in https://ui.perfetto.dev or chrome://tracing.");
 DEFINE_string(write_keypoint,           "",             "(Deprecated, use `write_json`) Directory to write the people pose keypoint data. Set format"
                                                         " with `write_keypoint_format`.");
 DEFINE_string(write_keypoint_format,    "yml",          "(Deprecated, use `write_json`) File extension and format for `write_keypoint`: json, xml,"
@@ -216,11 +257,6 @@ DEFINE_string(write_keypoint_json,      "",             "(Deprecated, use `write
 using namespace std;
 using namespace cv;
 
-VideoWriter outputVideo;
-string filename;
-
-Size outputsize = FLAGS_aspect_ratio_rotate == 0 ? Size(640, 360) : Size(360, 640);
-
 // If the user needs his own variables, he can inherit the op::Datum struct and add them
 // UserDatum can be directly used by the OpenPose wrapper because it inherits from op::Datum, just define
 // Wrapper<UserDatum> instead of Wrapper<op::Datum>
@@ -241,41 +277,16 @@ struct UserDatum : public op::Datum
 class WUserOutput : public op::WorkerConsumer<std::shared_ptr<std::vector<UserDatum>>>
 {
 public:
+    // videoSaver/repEventSaver: nullptr to disable them. display: false for headless mode (HighGUI is never used)
+    WUserOutput(const std::shared_ptr<op::VideoSaver>& videoSaver,
+                const std::shared_ptr<op::RepEventSaver>& repEventSaver, const Size& outputSize, const bool display) :
+        spVideoSaver{videoSaver},
+        spRepEventSaver{repEventSaver},
+        mOutputSize{outputSize},
+        mDisplay{display}
+    {}
 
-	const static int maxPersons = 2;
-	bool warOben[maxPersons];
-	int hampelmannCount[maxPersons];
-
-    void initializationOnThread() {
-		for (int i = 0; i < maxPersons; i++) {
-			warOben[i] = false;
-			hampelmannCount[i] = 0;
-		}
-	}
-
-
-	string bodypartname[18] = {	"0 Nase",
-								"1 Brust",
-								"2 Rechte Schulter",
-								"3 Rechter Ellbogen",
-								"4 Rechtes Handgelenk",
-								"5 Linke Schulter",
-								"6 Linker Ellbogen",
-								"7 Linkes Handgelenk",
-								"8 Rechte Huefte",
-								"9 Rechtes Knie",
-								"10 Rechter Knoechel",
-								"11 Linke Huefte",
-								"12 Linkes Knie",
-								"13 Linker Knoechel",
-								"14 Rechtes Auge",
-								"15 Linkes Auge",
-								"16 Rechtes Ohr",
-								"17 Linkes Ohr" 
-	};
-
-	float personmapping[maxPersons];
-	int personmappingi[maxPersons];
+    void initializationOnThread() {}
 
     void workConsumer(const std::shared_ptr<std::vector<UserDatum>>& datumsPtr)
     {
@@ -284,130 +295,59 @@ public:
             // User's displaying/saving/other processing here
                 // datum.cvOutputData: rendered frame with pose or heatmaps
                 // datum.poseKeypoints: Array<float> with the estimated pose
+                // datum.repetitionCounts: Array<int> with the jumping jacks of each person (op::WExerciseCounter)
             if (datumsPtr != nullptr && !datumsPtr->empty())
             {
+				const auto& datum = datumsPtr->at(0);
+				const auto& poseKeypoints = datum.poseKeypoints;
+				const auto& poseIds = datum.poseIds;
+				const auto& repetitionCounts = datum.repetitionCounts;
+				const auto useIds = (!poseIds.empty() && poseIds.getVolume() == repetitionCounts.getVolume());
 
-
-				const auto& poseKeypoints = datumsPtr->at(0).poseKeypoints;
-
-
-
-
-				for (int i = 0; i < maxPersons; i++) {
-					personmapping[i] = 100000.0;
-					personmappingi[i] = 0;
-				}
-
-				float min = 0.0;
-				for (int i = 0; i < maxPersons; i++) {
-					for (int person = 0; person < maxPersons && person < poseKeypoints.getSize(0); person++) {
-						Point2f brust(poseKeypoints[{person, 1, 0}], poseKeypoints[{person, 1, 1}]);
-						if (brust.x > min && brust.x < personmapping[i]) {
-							cout << "i:" << i << " person:" << person << " brust.x:" << brust.x << endl;
-							personmapping[i] = brust.x;
-							personmappingi[i] = person;
-						}
-					}
-					cout << "personmappingi[" << i << "]:" << personmappingi[i] << endl;
-					min = personmapping[i];
-				}
-
-				cout << "personmappingi" << endl;
-				cout << personmappingi[0] << " " << personmappingi[1] << endl;
-
-
+				// Repetition events (analytics)
+				if (spRepEventSaver != nullptr)
+					spRepEventSaver->save(datum.repetitionEvents, datum.frameNumber);
 
 				// Display rendered output image
-				cv::Mat image = datumsPtr->at(0).cvOutputData;
+				cv::Mat image = datum.cvOutputData;
 
-				for (int person = 0; person < poseKeypoints.getSize(0) && person < maxPersons; person++)
+				const int fontFace = FONT_HERSHEY_SIMPLEX;
+				const int thickness = 3;
+				for (int person = 0; person < (int)repetitionCounts.getVolume(); person++)
 				{
-
-					Point2f nase(poseKeypoints[{person, 0, 0}], poseKeypoints[{person, 0, 1}]);
-					Point2f brust(poseKeypoints[{person, 1, 0}], poseKeypoints[{person, 1, 1}]);
-					Point2f rechteSchulter(poseKeypoints[{person, 2, 0}], poseKeypoints[{person, 2, 1}]);
-					Point2f rechterEllbogen(poseKeypoints[{person, 3, 0}], poseKeypoints[{person, 3, 1}]);
-					Point2f rechtesHandgelenk(poseKeypoints[{person, 4, 0}], poseKeypoints[{person, 4, 1}]);
-					Point2f linkeSchulter(poseKeypoints[{person, 5, 0}], poseKeypoints[{person, 5, 1}]);
-					Point2f linkerEllbogen(poseKeypoints[{person, 6, 0}], poseKeypoints[{person, 6, 1}]);
-					Point2f linkesHandgelenk(poseKeypoints[{person, 7, 0}], poseKeypoints[{person, 7, 1}]);
-					Point2f rechteHuefte(poseKeypoints[{person, 8, 0}], poseKeypoints[{person, 8, 1}]);
-					Point2f rechtesKnie(poseKeypoints[{person, 9, 0}], poseKeypoints[{person, 9, 1}]);
-					Point2f rechterKnoechel(poseKeypoints[{person, 10, 0}], poseKeypoints[{person, 10, 1}]);
-					Point2f linkeHuefte(poseKeypoints[{person, 11, 0}], poseKeypoints[{person, 11, 1}]);
-					Point2f linkesKnie(poseKeypoints[{person, 12, 0}], poseKeypoints[{person, 12, 1}]);
-					Point2f linkerKnoechel(poseKeypoints[{person, 13, 0}], poseKeypoints[{person, 13, 1}]);
-					Point2f rechtesAuge(poseKeypoints[{person, 14, 0}], poseKeypoints[{person, 14, 1}]);
-					Point2f linkesAuge(poseKeypoints[{person, 15, 0}], poseKeypoints[{person, 15, 1}]);
-					Point2f rechtesOhr(poseKeypoints[{person, 16, 0}], poseKeypoints[{person, 16, 1}]);
-					Point2f linkesOhr(poseKeypoints[{person, 17, 0}], poseKeypoints[{person, 17, 1}]);
-
-					// Position unten
-					if (
-						abs(linkesHandgelenk.x - rechtesHandgelenk.x) <= 2 * abs(linkeSchulter.x - rechteSchulter.x) &&
-						linkesHandgelenk.y > brust.y &&
-						rechtesHandgelenk.y > brust.y &&
-						abs(linkerKnoechel.x - rechterKnoechel.x) <= 1 * abs(linkeSchulter.x - rechteSchulter.x)
-						) {
-						//op::log("###########  UNTEN  ##########");
-						if (warOben[personmappingi[person]]) {
-							hampelmannCount[personmappingi[person]]++;
-							warOben[personmappingi[person]] = false;
-							op::log("Anzahl Hampelmann: " + to_string(hampelmannCount[personmappingi[person]]));
-						}
-					}
-
-					// Position oben
-					if (
-						abs(linkesHandgelenk.x - rechtesHandgelenk.x) <= 2 * abs(linkeSchulter.x - rechteSchulter.x) &&
-						linkesHandgelenk.y < nase.y &&
-						rechtesHandgelenk.y < nase.y &&
-						abs(linkerKnoechel.x - rechterKnoechel.x) > 1 * abs(linkeSchulter.x - rechteSchulter.x)
-						) {
-						//op::log("###########  OBEN  ##########");
-						warOben[personmappingi[person]] = true;
+					const auto personId = (useIds ? poseIds[person] : (long long)person);
+					const string personText = "P" + to_string(personId + 1);
+
+					// Counter list on the left side (as many people as they fit in the image)
+					const Point textOrg(10, 60 + person * 110);
+					if (textOrg.y + 35 < image.rows) {
+						putText(image, to_string(repetitionCounts[person]), textOrg, fontFace, 2, Scalar::all(255), thickness, 8);
+						putText(image, personText, Point(10, 95 + person * 110), fontFace, 1, Scalar::all(255), thickness, 8);
 					}
 
-					string text = to_string(hampelmannCount[personmappingi[person]]);
-					int fontFace = FONT_HERSHEY_SIMPLEX;
-					double fontScale = 2;
-					int thickness = 3;
-					Point textOrg(10, 60 + personmappingi[person] * 110);
-					//Point textOrg(10 + person * 560 - (person > 0 && hampelmannCount[person] >= 10 ? 60 : 0), 80);
-					//Point textOrg(10, 260);
-					putText(image, text, textOrg, fontFace, fontScale, Scalar::all(255), thickness, 8);
-
-
-					text = "P" + to_string(personmappingi[person] + 1);
-					fontScale = 1;
-					thickness = 3;
-					Point textPersonCounterOrg(10, 95 + personmappingi[person] * 110);
-					//Point textPersonCounterOrg(20 + person * 560 - (person > 0 && hampelmannCount[person] >= 10 ? 60 : 0), 120);
-
-					putText(image, text, textPersonCounterOrg, fontFace, fontScale, Scalar::all(255), thickness, 8);
-
-
-					text = "P"+to_string(personmappingi[person] +1);
-					fontScale = 1;
-					thickness = 3;
-					Point textPersonOrg(brust.x-20, brust.y+30);
-
-					putText(image, text, textPersonOrg, fontFace, fontScale, Scalar::all(255), thickness, 8);
+					// Person label under the chest
+					const Point2f brust(poseKeypoints[{person, 1, 0}], poseKeypoints[{person, 1, 1}]);
+					putText(image, personText, Point(brust.x - 20, brust.y + 30), fontFace, 1, Scalar::all(255), thickness, 8);
 				}
 
-				cv::Mat imageResized;
-				resize(image, imageResized, outputsize);
-
-
-				outputVideo.write(imageResized);
-
-                cv::imshow("User worker GUI", imageResized);
-                // Display image and sleeps at least 1 ms (it usually sleeps ~5-10 msec to display the image)
-                const char key = (char)cv::waitKey(1);
-				if (key == 27)
-					this->stop();
-
-
+				if (spVideoSaver != nullptr || mDisplay)
+				{
+					cv::Mat imageResized;
+					resize(image, imageResized, mOutputSize);
+
+					// Asynchronous encoding (it does not block this thread)
+					if (spVideoSaver != nullptr)
+						spVideoSaver->write(imageResized);
+
+					if (mDisplay)
+					{
+						cv::imshow("User worker GUI", imageResized);
+						// Display image and sleeps at least 1 ms (it usually sleeps ~5-10 msec to display the image)
+						const char key = (char)cv::waitKey(1);
+						if (key == 27)
+							this->stop();
+					}
+				}
             }
         }
         catch (const std::exception& e)
@@ -416,6 +356,12 @@ public:
             op::error(e.what(), __LINE__, __FUNCTION__, __FILE__);
         }
     }
+
+private:
+    const std::shared_ptr<op::VideoSaver> spVideoSaver;
+    const std::shared_ptr<op::RepEventSaver> spRepEventSaver;
+    const Size mOutputSize;
+    const bool mDisplay;
 };
 
 int openPoseDemo()
@@ -475,8 +421,29 @@ int openPoseDemo()
     op::Wrapper<std::vector<UserDatum>> opWrapper;
 
     // Initializing the user custom classes
-    // GUI (Display)
-    auto wUserOutput = std::make_shared<WUserOutput>();
+    // Jumping jack counter (state keyed by person ID, no limit in the number of people)
+    auto exerciseCounter = std::make_shared<op::ExerciseCounter>(
+        poseModel, FLAGS_model_folder + "exercise/exercises.txt", std::vector<std::string>{"jumping_jack"});
+    auto wExerciseCounter = std::make_shared<op::WExerciseCounter<std::shared_ptr<std::vector<UserDatum>>>>(
+        exerciseCounter);
+    const auto workerPostProcessingOnNewThread = false;
+    opWrapper.setWorkerPostProcessing(wExerciseCounter, workerPostProcessingOnNewThread);
+    // Video saving (H.264, encoded on its own thread) and GUI (Display, disabled with `--display 0`)
+    const auto userOutputSize = (FLAGS_aspect_ratio_rotate == 0 ? Size(640, 360) : Size(360, 640));
+    const auto producerFps = producerSharedPtr->get(CV_CAP_PROP_FPS);
+    const auto fps = (producerFps > 0. ? producerFps : FLAGS_camera_fps);
+    std::shared_ptr<op::VideoSaver> videoSaver;
+    if (!FLAGS_video_output.empty())
+        videoSaver = std::make_shared<op::VideoSaver>(
+            FLAGS_video_output, CV_FOURCC('H', '2', '6', '4'), fps,
+            op::Point<int>{userOutputSize.width, userOutputSize.height}, (unsigned int)FLAGS_video_output_queue,
+            FLAGS_video_output_drop);
+    // Repetition events (one JSON line per repetition)
+    std::shared_ptr<op::RepEventSaver> repEventSaver;
+    if (!FLAGS_write_rep_events.empty())
+        repEventSaver = std::make_shared<op::RepEventSaver>(FLAGS_write_rep_events,
+                                                            exerciseCounter->getExerciseNames(), fps);
+    auto wUserOutput = std::make_shared<WUserOutput>(videoSaver, repEventSaver, userOutputSize, FLAGS_display != 0);
     // Add custom processing
     const auto workerOutputOnNewThread = true;
     opWrapper.setWorkerOutput(wUserOutput, workerOutputOnNewThread);
@@ -491,7 +458,9 @@ int openPoseDemo()
                                                   heatMapTypes, heatMapScale, FLAGS_part_candidates,
                                                   (float)FLAGS_render_threshold, FLAGS_number_people_max,
                                                   enableGoogleLogging, FLAGS_3d, FLAGS_3d_min_views,
-                                                  FLAGS_identification};
+                                                  FLAGS_identification, -1, FLAGS_filter_keypoints, -1.f,
+                                                  FLAGS_nms_coarse_to_fine, FLAGS_net_batch_size, FLAGS_net_cache_size,
+                                                  op::flagsToPoints(FLAGS_net_cache_resolutions, "656x368")};
     // Face configuration (use op::WrapperStructFace{} to disable it)
     const op::WrapperStructFace wrapperStructFace{FLAGS_face, faceNetInputSize,
                                                   op::flagsToRenderMode(FLAGS_face_render, multipleView, FLAGS_render_pose),
@@ -506,7 +475,7 @@ int openPoseDemo()
     // Producer (use default to disable any input)
     const op::WrapperStructInput wrapperStructInput{producerSharedPtr, FLAGS_frame_first, FLAGS_frame_last,
                                                     FLAGS_process_real_time, FLAGS_frame_flip, FLAGS_frame_rotate,
-                                                    FLAGS_frames_repeat};
+                                                    FLAGS_frames_repeat, op::flagsToQueuePolicy(FLAGS_queue_policy)};
     // Consumer (comment or use default argument to disable any output)
     // const op::WrapperStructOutput wrapperStructOutput{op::flagsToDisplayMode(FLAGS_display, FLAGS_3d),
     //                                                   !FLAGS_no_gui_verbose, FLAGS_fullscreen, FLAGS_write_keypoint,
@@ -525,6 +494,15 @@ int openPoseDemo()
     // Set to single-thread running (to debug and/or reduce latency)
     if (FLAGS_disable_multi_thread)
         opWrapper.disableMultiThreading();
+    // Split the CPU loops of each step among the CPU cores
+    if (FLAGS_num_cpu_threads != 0)
+        opWrapper.enableThreadPool(FLAGS_num_cpu_threads);
+    // Pipeline metrics (latency histograms and queue sizes)
+    if (!FLAGS_write_metrics.empty())
+        opWrapper.enableMetrics(FLAGS_write_metrics);
+    // Pipeline timeline (Chrome trace)
+    if (!FLAGS_write_trace.empty())
+        opWrapper.enableTracing(FLAGS_write_trace);
 
     // Start processing
     // Two different ways of running the program on multithread environment
@@ -569,18 +547,6 @@ int main(int argc, char *argv[])
 {
 
 
-	int ex = CV_FOURCC('H', '2', '6', '4');// static_cast<int>(inputVideo.get(CV_CAP_PROP_FOURCC));
-	double fps = 29.948;// inputVideo.get(CV_CAP_PROP_FPS); // framerate of the created video stream
-
-	outputVideo.open(FLAGS_video_output, ex, fps, outputsize, true);
-	if (!outputVideo.isOpened())
-	{
-		cout << "Could not open the output video for write: " << endl;
-		cin >> ex;
-		return -1;
-	}
-
-
     // Parsing command line flags
     gflags::ParseCommandLineFlags(&argc, &argv, true);
 
@@ -40,6 +40,10 @@ DEFINE_bool(disable_multi_thread,       false,          "It would slightly reduc
                                                         " for 1) Cases where it is needed a low latency (e.g. webcam in real-time scenarios with"
                                                         " low-range GPU devices); and 2) Debugging OpenPose when it is crashing to locate the"
                                                         " error.");
+DEFINE_int32(num_cpu_threads,           0,              "Number of extra CPU threads used to split the CPU loops of each step (resizing, NMS,"
+                                                        " body part connection, etc.) with a work-stealing thread pool. 0 to disable it, -1 for the"
+                                                        " number of CPU cores minus 1 (the calling thread also runs part of each loop, so all the"
+                                                        " cores are used).");
 DEFINE_int32(profile_speed,             1000,           "If PROFILER_ENABLED was set in CMake or Makefile.config files, OpenPose will show some"
                                                         " runtime statistics at this frame number.");
 // Producer
@@ -64,6 +68,10 @@ DEFINE_int32(frame_rotate,              0,              "Rotate each frame, 4 po
 DEFINE_bool(frames_repeat,              false,          "Repeat frames when finished.");
 DEFINE_bool(process_real_time,          false,          "Enable to keep the original source frame rate (e.g. for video). If the processing time is"
                                                         " too long, it will skip frames. If it is too fast, it will slow it down.");
+DEFINE_int32(queue_policy,              0,              "What to do with new frames when OpenPose is slower than the producer (e.g. real-time"
+                                                        " webcam or IP camera). 0 to wait (all frames are processed), 1 to drop the newest frame,"
+                                                        " 2 to drop the oldest queued frame, 3 to only keep the latest frame. Options 1-3 keep the"
+                                                        " latency bounded during processing load spikes.");
 DEFINE_string(camera_parameter_folder,  "models/cameraParameters/flir/", "String with the folder where the camera parameters are located.");
 // OpenPose
 DEFINE_string(model_folder,             "models/",      "Folder path (absolute or relative) where the models (pose, face, ...) are located.");
@@ -99,6 +107,22 @@ DEFINE_int32(scale_number,              1,              "Number of scales to ave
 DEFINE_double(scale_gap,                0.3,            "Scale gap between scales. No effect unless scale_number > 1. Initial scale is always 1."
                                                         " If you want to change the initial scale, you actually want to multiply the"
                                                         " `net_resolution` by your desired initial scale.");
+DEFINE_bool(nms_coarse_to_fine,         false,          "CPU version only. If true, the NMS and body part connection will run on the net output"
+                                                        " resolution, only upsampling it around the peak candidates, rather than upsampling all"
+                                                        " the heat maps to `net_resolution`. Faster, but results are approximated. No effect if"
+                                                        " `scale_number` > 1 or if any heat map is returned.");
+DEFINE_int32(net_batch_size,            1,              "Offline processing only (e.g. recorded videos or image directories). If greater than 1,"
+                                                        " the frames will be kept until `net_batch_size` of them are received, so the net runs a"
+                                                        " single batched forward pass on all of them. Higher throughput (mainly in the CPU"
+                                                        " version) but higher latency. Ignored with the adaptive tracking interval"
+                                                        " (`tracking_max_displacement`).");
+DEFINE_int32(net_cache_size,            1,              "Number of net input sizes kept ready in memory, so alternating among them (e.g. image"
+                                                        " directories with mixed aspect ratios and `-1` in `net_resolution`) does not reshape the"
+                                                        " net on every change. Each one adds the memory of the net intermediate results (weights"
+                                                        " are shared).");
+DEFINE_string(net_cache_resolutions,    "",             "Comma-separated net input sizes (multiples of 16, no `-1`, e.g. `656x368,368x656`)"
+                                                        " prepared when the net is initialized rather than on their first frame. Use it together"
+                                                        " with `net_cache_size`.");
 // OpenPose Body Pose Heatmaps and Part Candidates
 DEFINE_bool(heatmaps_add_parts,         false,          "If true, it will fill op::Datum::poseHeatMaps array with the body part heatmaps, and"
                                                         " analogously face & hand heatmaps to op::Datum::faceHeatMaps & op::Datum::handHeatMaps."
@@ -154,11 +178,19 @@ DEFINE_int32(3d_views,                  1,              "Complementary option to
                                                         " `--camera_parameters_folder` must be set. OpenPose must find as many `xml` files in the"
                                                         " parameter folder as this number indicates.");
 // Extra algorithms
-DEFINE_bool(identification,             false,          "Not available yet, coming soon. Whether to enable people identification across frames.");
+DEFINE_bool(identification,             false,          "Whether to enable people identification across frames (consistent IDs by matching the"
+                                                        " keypoints of consecutive frames). Used by `filter_keypoints` to keep per-person state.");
 DEFINE_int32(tracking,                  -1,             "Not available yet, coming soon. Whether to enable people tracking across frames. The"
                                                         " value indicates the number of frames where tracking is run between each OpenPose keypoint"
                                                         " detection. Select -1 (default) to disable it or 0 to run simultaneously OpenPose keypoint"
                                                         " detector and tracking for potentially higher accurary than only OpenPose.");
+DEFINE_double(tracking_max_displacement, -1.,           "Adaptive `tracking`. If positive, `tracking` becomes the maximum number of consecutive"
+                                                        " tracked frames, and OpenPose is run earlier if the keypoints are expected to have moved more"
+                                                        " than this number of pixels since the last detection (i.e., more often when people move"
+                                                        " fast). Select -1 (default) to disable it.");
+DEFINE_bool(filter_keypoints,           false,          "Whether to smooth the body keypoints across frames and fill the keypoints missed during a"
+                                                        " few frames. It reduces the jitter, mainly useful with low `net_resolution` values. With"
+                                                        " more than 1 person, enable `identification` too (otherwise people are matched by index).");
 // OpenPose Rendering
 DEFINE_int32(part_to_show,              0,              "Prediction channel to visualize (default: 0). 0 for all the body parts, 1-18 for each body"
                                                         " part heat map, 19 for the background heat map, 20 for all the body part heat maps"
@@ -213,6 +245,12 @@ DEFINE_string(write_heatmaps,           "",             "Directory to write body
 DEFINE_string(write_heatmaps_format,    "png",          "File extension and format for `write_heatmaps`, analogous to `write_images_format`."
                                                         " For lossless compression, recommended `png` for integer `heatmaps_scale` and `float` for"
                                                         " floating values.");
+DEFINE_string(write_metrics,            "",             "Full file path to append (every 5 seconds) a JSON line with the pipeline metrics: work"
+                                                        " time of each worker, waiting times of each thread, and size and dropped frames of each"
+                                                        " queue.");
+DEFINE_string(write_trace,              "",             "Full file path to write (when OpenPose stops) a Chrome trace JSON with the timeline of the"
+                                                        " pipeline: a span per worker and frame, plus the inner steps of the pose estimation. Open"
+                                                        " it in https://ui.perfetto.dev or chrome://tracing.");
 DEFINE_string(write_keypoint,           "",             "(Deprecated, use `write_json`) Directory to write the people pose keypoint data. Set format"
                                                         " with `write_keypoint_format`.");
 DEFINE_string(write_keypoint_format,    "yml",          "(Deprecated, use `write_json`) File extension and format for `write_keypoint`: json, xml,"
@@ -283,7 +321,10 @@ int openPoseDemo()
                                                   heatMapTypes, heatMapScale, FLAGS_part_candidates,
                                                   (float)FLAGS_render_threshold, FLAGS_number_people_max,
                                                   enableGoogleLogging, FLAGS_3d, FLAGS_3d_min_views,
-                                                  FLAGS_identification, FLAGS_tracking};
+                                                  FLAGS_identification, FLAGS_tracking, FLAGS_filter_keypoints,
+                                                  (float)FLAGS_tracking_max_displacement, FLAGS_nms_coarse_to_fine,
+                                                  FLAGS_net_batch_size, FLAGS_net_cache_size,
+                                                  op::flagsToPoints(FLAGS_net_cache_resolutions, "656x368")};
     // Face configuration (use op::WrapperStructFace{} to disable it)
     const op::WrapperStructFace wrapperStructFace{FLAGS_face, faceNetInputSize,
                                                   op::flagsToRenderMode(FLAGS_face_render, multipleView, FLAGS_render_pose),
@@ -298,7 +339,7 @@ int openPoseDemo()
     // Producer (use default to disable any input)
     const op::WrapperStructInput wrapperStructInput{producerSharedPtr, FLAGS_frame_first, FLAGS_frame_last,
                                                     FLAGS_process_real_time, FLAGS_frame_flip, FLAGS_frame_rotate,
-                                                    FLAGS_frames_repeat};
+                                                    FLAGS_frames_repeat, op::flagsToQueuePolicy(FLAGS_queue_policy)};
     // Consumer (comment or use default argument to disable any output)
     const op::WrapperStructOutput wrapperStructOutput{op::flagsToDisplayMode(FLAGS_display, FLAGS_3d),
                                                       !FLAGS_no_gui_verbose, FLAGS_fullscreen, FLAGS_write_keypoint,
@@ -313,6 +354,15 @@ int openPoseDemo()
     // Set to single-thread running (to debug and/or reduce latency)
     if (FLAGS_disable_multi_thread)
         opWrapper.disableMultiThreading();
+    // Split the CPU loops of each step among the CPU cores
+    if (FLAGS_num_cpu_threads != 0)
+        opWrapper.enableThreadPool(FLAGS_num_cpu_threads);
+    // Pipeline metrics (latency histograms and queue sizes)
+    if (!FLAGS_write_metrics.empty())
+        opWrapper.enableMetrics(FLAGS_write_metrics);
+    // Pipeline timeline (Chrome trace)
+    if (!FLAGS_write_trace.empty())
+        opWrapper.enableTracing(FLAGS_write_trace);
 
     // Start processing
     // Two different ways of running the program on multithread environment
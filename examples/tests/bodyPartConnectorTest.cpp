@@ -0,0 +1,534 @@
+// ------------------------- OpenPose Body Part Connector Testing -------------------------
+// It compares connectBodyPartsCpu with a reference copy of its original implementation (before the flat per-thread
+// arena and the vectorized PAF line integral) on randomized peaks and PAFs of every pose model, with and without the
+// coarse-to-fine upsampling. The keypoints must be identical, and the person scores equal up to `score_tolerance`
+// (the line integral sums the PAF samples in a different order).
+
+#include <chrono> // `std::chrono::` functions and classes, e.g. std::chrono::milliseconds
+#include <random> // std::mt19937
+// GFlags: DEFINE_bool, _int32, _int64, _uint64, _double, _string
+#include <gflags/gflags.h>
+// Allow Google Flags in Ubuntu 14
+#ifndef GFLAGS_GFLAGS_H_
+    namespace gflags = google;
+#endif
+#include <openpose/headers.hpp>
+
+DEFINE_int32(logging_level,             3,              "The higher, the less log messages. Integer in the range [0, 255].");
+DEFINE_int32(number_tests,              60,             "Number of random PAFs and peaks tested per pose model and mode.");
+DEFINE_int32(seed,                      7,              "Seed of the random peaks.");
+DEFINE_int32(num_cpu_threads,           0,              "Number of extra CPU threads of the thread pool used by connectBodyPartsCpu. 0 to"
+                                                        " disable it, -1 for the number of CPU cores minus 1.");
+DEFINE_double(score_tolerance,          1e-4,           "Maximum relative difference of the person scores.");
+
+namespace op
+{
+    // Original connectBodyPartsCpu (reference output)
+    template <typename T>
+    void connectBodyPartsCpuReference(Array<T>& poseKeypoints, Array<T>& poseScores, const T* const heatMapPtr,
+                                      const T* const peaksPtr, const PoseModel poseModel,
+                                      const Point<int>& heatMapSize, const int maxPeaks,
+                                      const T interMinAboveThreshold, const T interThreshold,
+                                      const int minSubsetCnt, const T minSubsetScore, const T scaleFactor,
+                                      const Point<int>& upsampledHeatMapSize)
+    {
+        try
+        {
+            // Parts Connection
+            const auto& bodyPartPairs = getPosePartPairs(poseModel);
+            const auto& mapIdx = getPoseMapIndex(poseModel);
+            const auto numberBodyParts = getPoseNumberBodyParts(poseModel);
+            const auto numberBodyPartPairs = bodyPartPairs.size() / 2;
+
+            // Vector<int> = Each body part + body parts counter; double = subsetScore
+            std::vector<std::pair<std::vector<int>, double>> subset;
+            const auto subsetCounterIndex = numberBodyParts;
+            const auto subsetSize = numberBodyParts+1;
+
+            const auto peaksOffset = 3*(maxPeaks+1);
+            const auto heatMapOffset = heatMapSize.area();
+            // Coordinates of the peaks (upsampled ones if the heat maps were not upsampled)
+            const auto upsampleOnTheFly = (upsampledHeatMapSize.x > 0 && upsampledHeatMapSize.y > 0);
+            const auto peaksMapSize = (upsampleOnTheFly ? upsampledHeatMapSize : heatMapSize);
+
+            for (auto pairIndex = 0u; pairIndex < numberBodyPartPairs; pairIndex++)
+            {
+                const auto bodyPartA = bodyPartPairs[2*pairIndex];
+                const auto bodyPartB = bodyPartPairs[2*pairIndex+1];
+                const auto* candidateAPtr = peaksPtr + bodyPartA*peaksOffset;
+                const auto* candidateBPtr = peaksPtr + bodyPartB*peaksOffset;
+                const auto numberA = intRound(candidateAPtr[0]);
+                const auto numberB = intRound(candidateBPtr[0]);
+
+                // Add parts into the subset in special case
+                if (numberA == 0 || numberB == 0)
+                {
+                    // Change w.r.t. other
+                    if (numberA == 0) // numberB == 0 or not
+                    {
+                        if (numberBodyParts != 15)
+                        {
+                            for (auto i = 1; i <= numberB; i++)
+                            {
+                                bool num = false;
+                                const auto indexB = bodyPartB;
+                                for (auto j = 0u; j < subset.size(); j++)
+                                {
+                                    const auto off = (int)bodyPartB*peaksOffset + i*3 + 2;
+                                    if (subset[j].first[indexB] == off)
+                                    {
+                                        num = true;
+                                        break;
+                                    }
+                                }
+                                if (!num)
+                                {
+                                    std::vector<int> rowVector(subsetSize, 0);
+                                    // Store the index
+                                    rowVector[ bodyPartB ] = bodyPartB*peaksOffset + i*3 + 2;
+                                    // Last number in each row is the parts number of that person
+                                    rowVector[subsetCounterIndex] = 1;
+                                    const auto subsetScore = candidateBPtr[i*3+2];
+                                    // Second last number in each row is the total score
+                                    subset.emplace_back(std::make_pair(rowVector, subsetScore));
+                                }
+                            }
+                        }
+                        else
+                        {
+                            for (auto i = 1; i <= numberB; i++)
+                            {
+                                std::vector<int> rowVector(subsetSize, 0);
+                                // Store the index
+                                rowVector[ bodyPartB ] = bodyPartB*peaksOffset + i*3 + 2;
+                                // Last number in each row is the parts number of that person
+                                rowVector[subsetCounterIndex] = 1;
+                                // Second last number in each row is the total score
+                                const auto subsetScore = candidateBPtr[i*3+2];
+                                subset.emplace_back(std::make_pair(rowVector, subsetScore));
+                            }
+                        }
+                    }
+                    else // if (numberA != 0 && numberB == 0)
+                    {
+                        if (numberBodyParts != 15)
+                        {
+                            for (auto i = 1; i <= numberA; i++)
+                            {
+                                bool num = false;
+                                const auto indexA = bodyPartA;
+                                for (auto j = 0u; j < subset.size(); j++)
+                                {
+                                    const auto off = (int)bodyPartA*peaksOffset + i*3 + 2;
+                                    if (subset[j].first[indexA] == off)
+                                    {
+                                        num = true;
+                                        break;
+                                    }
+                                }
+                                if (!num)
+                                {
+                                    std::vector<int> rowVector(subsetSize, 0);
+                                    // Store the index
+                                    rowVector[ bodyPartA ] = bodyPartA*peaksOffset + i*3 + 2;
+                                    // Last number in each row is the parts number of that person
+                                    rowVector[subsetCounterIndex] = 1;
+                                    // Second last number in each row is the total score
+                                    const auto subsetScore = candidateAPtr[i*3+2];
+                                    subset.emplace_back(std::make_pair(rowVector, subsetScore));
+                                }
+                            }
+                        }
+                        else
+                        {
+                            for (auto i = 1; i <= numberA; i++)
+                            {
+                                std::vector<int> rowVector(subsetSize, 0);
+                                // Store the index
+                                rowVector[ bodyPartA ] = bodyPartA*peaksOffset + i*3 + 2;
+                                // Last number in each row is the parts number of that person
+                                rowVector[subsetCounterIndex] = 1;
+                                // Second last number in each row is the total score
+                                const auto subsetScore = candidateAPtr[i*3+2];
+                                subset.emplace_back(std::make_pair(rowVector, subsetScore));
+                            }
+                        }
+                    }
+                }
+                else // if (numberA != 0 && numberB != 0)
+                {
+                    std::vector<std::tuple<double, int, int>> temp;
+                    const auto* mapX = heatMapPtr + mapIdx[2*pairIndex] * heatMapOffset;
+                    const auto* mapY = heatMapPtr + mapIdx[2*pairIndex+1] * heatMapOffset;
+                    for (auto i = 1; i <= numberA; i++)
+                    {
+                        for (auto j = 1; j <= numberB; j++)
+                        {
+                            const auto vectorAToBX = candidateBPtr[j*3] - candidateAPtr[i*3];
+                            const auto vectorAToBY = candidateBPtr[j*3+1] - candidateAPtr[i*3+1];
+                            const auto vectorAToBMax = fastMax(std::abs(vectorAToBX), std::abs(vectorAToBY));
+                            const auto numberPointsInLine = fastMax(
+                                5, fastMin(25, intRound(std::sqrt(5*vectorAToBMax))));
+                            const auto vectorNorm = T(std::sqrt( vectorAToBX*vectorAToBX + vectorAToBY*vectorAToBY ));
+                            // If the peaksPtr are coincident. Don't connect them.
+                            if (vectorNorm > 1e-6)
+                            {
+                                const auto sX = candidateAPtr[i*3];
+                                const auto sY = candidateAPtr[i*3+1];
+                                const auto vectorAToBNormX = vectorAToBX/vectorNorm;
+                                const auto vectorAToBNormY = vectorAToBY/vectorNorm;
+
+                                auto sum = 0.;
+                                auto count = 0;
+                                const auto vectorAToBXInLine = vectorAToBX/numberPointsInLine;
+                                const auto vectorAToBYInLine = vectorAToBY/numberPointsInLine;
+                                for (auto lm = 0; lm < numberPointsInLine; lm++)
+                                {
+                                    const auto mX = fastMin(peaksMapSize.x-1, intRound(sX + lm*vectorAToBXInLine));
+                                    const auto mY = fastMin(peaksMapSize.y-1, intRound(sY + lm*vectorAToBYInLine));
+                                    checkGE(mX, 0, "", __LINE__, __FUNCTION__, __FILE__);
+                                    checkGE(mY, 0, "", __LINE__, __FUNCTION__, __FILE__);
+                                    T valueX;
+                                    T valueY;
+                                    if (upsampleOnTheFly)
+                                    {
+                                        const Rectangle<int> pixel{mX, mY, 1, 1};
+                                        resizeCubicRegionCpu(&valueX, mapX, heatMapSize, upsampledHeatMapSize, pixel);
+                                        resizeCubicRegionCpu(&valueY, mapY, heatMapSize, upsampledHeatMapSize, pixel);
+                                    }
+                                    else
+                                    {
+                                        const auto idx = mY * heatMapSize.x + mX;
+                                        valueX = mapX[idx];
+                                        valueY = mapY[idx];
+                                    }
+                                    const auto score = (vectorAToBNormX*valueX + vectorAToBNormY*valueY);
+                                    if (score > interThreshold)
+                                    {
+                                        sum += score;
+                                        count++;
+                                    }
+                                }
+
+                                // parts score + connection score
+                                if (count/(float)numberPointsInLine > interMinAboveThreshold)
+                                    temp.emplace_back(std::make_tuple(sum/count, i, j));
+                            }
+                        }
+                    }
+
+                    // select the top minAB connection, assuming that each part occur only once
+                    // sort rows in descending order based on parts + connection score
+                    if (!temp.empty())
+                        std::sort(temp.begin(), temp.end(), std::greater<std::tuple<T, int, int>>());
+
+                    std::vector<std::tuple<int, int, double>> connectionK;
+                    const auto minAB = fastMin(numberA, numberB);
+                    std::vector<int> occurA(numberA, 0);
+                    std::vector<int> occurB(numberB, 0);
+                    auto counter = 0;
+                    for (auto row = 0u; row < temp.size(); row++)
+                    {
+                        const auto score = std::get<0>(temp[row]);
+                        const auto x = std::get<1>(temp[row]);
+                        const auto y = std::get<2>(temp[row]);
+                        if (!occurA[x-1] && !occurB[y-1])
+                        {
+                            connectionK.emplace_back(std::make_tuple(bodyPartA*peaksOffset + x*3 + 2,
+                                                                     bodyPartB*peaksOffset + y*3 + 2,
+                                                                     score));
+                            counter++;
+                            if (counter==minAB)
+                                break;
+                            occurA[x-1] = 1;
+                            occurB[y-1] = 1;
+                        }
+                    }
+
+                    // Cluster all the body part candidates into subset based on the part connection
+                    if (!connectionK.empty())
+                    {
+                        // initialize first body part connection 15&16
+                        if (pairIndex==0)
+                        {
+                            for (const auto& connectionKI : connectionK)
+                            {
+                                std::vector<int> rowVector(numberBodyParts+3, 0);
+                                const auto indexA = std::get<0>(connectionKI);
+                                const auto indexB = std::get<1>(connectionKI);
+                                const auto score = std::get<2>(connectionKI);
+                                rowVector[bodyPartPairs[0]] = indexA;
+                                rowVector[bodyPartPairs[1]] = indexB;
+                                rowVector[subsetCounterIndex] = 2;
+                                // add the score of parts and the connection
+                                const auto subsetScore = peaksPtr[indexA] + peaksPtr[indexB] + score;
+                                subset.emplace_back(std::make_pair(rowVector, subsetScore));
+                            }
+                        }
+                        // Add ears connections (in case person is looking to opposite direction to camera)
+                        else if (
+                            (numberBodyParts == 18 && (pairIndex==17 || pairIndex==18))
+                            || ((numberBodyParts == 19 || numberBodyParts == 59)
+                                && (pairIndex==18 || pairIndex==19))
+                            || (numberBodyParts == 23 && (pairIndex==22 || pairIndex==23))
+                            || (poseModel == PoseModel::BODY_19b
+                                && (pairIndex == numberBodyPartPairs-1 || pairIndex == numberBodyPartPairs-2))
+                            )
+                        {
+                            for (const auto& connectionKI : connectionK)
+                            {
+                                const auto indexA = std::get<0>(connectionKI);
+                                const auto indexB = std::get<1>(connectionKI);
+                                for (auto& subsetJ : subset)
+                                {
+                                    auto& subsetJFirst = subsetJ.first[bodyPartA];
+                                    auto& subsetJFirstPlus1 = subsetJ.first[bodyPartB];
+                                    if (subsetJFirst == indexA && subsetJFirstPlus1 == 0)
+                                        subsetJFirstPlus1 = indexB;
+                                    else if (subsetJFirstPlus1 == indexB && subsetJFirst == 0)
+                                        subsetJFirst = indexA;
+                                }
+                            }
+                        }
+                        else
+                        {
+                            // A is already in the subset, find its connection B
+                            for (const auto& connectionKI : connectionK)
+                            {
+                                const auto indexA = std::get<0>(connectionKI);
+                                const auto indexB = std::get<1>(connectionKI);
+                                const auto score = std::get<2>(connectionKI);
+                                auto num = 0;
+                                for (auto& subsetJ : subset)
+                                {
+                                    if (subsetJ.first[bodyPartA] == indexA)
+                                    {
+                                        subsetJ.first[bodyPartB] = indexB;
+                                        num++;
+                                        subsetJ.first[subsetCounterIndex] = subsetJ.first[subsetCounterIndex] + 1;
+                                        subsetJ.second += peaksPtr[indexB] + score;
+                                    }
+                                }
+                                // if can not find partA in the subset, create a new subset
+                                if (num==0)
+                                {
+                                    std::vector<int> rowVector(subsetSize, 0);
+                                    rowVector[bodyPartA] = indexA;
+                                    rowVector[bodyPartB] = indexB;
+                                    rowVector[subsetCounterIndex] = 2;
+                                    const auto subsetScore = peaksPtr[indexA] + peaksPtr[indexB] + score;
+                                    subset.emplace_back(std::make_pair(rowVector, subsetScore));
+                                }
+                            }
+                        }
+                    }
+                }
+            }
+
+            // Delete people below the following thresholds:
+                // a) minSubsetCnt: removed if less than minSubsetCnt body parts
+                // b) minSubsetScore: removed if global score smaller than this
+                // c) POSE_MAX_PEOPLE: keep first POSE_MAX_PEOPLE people above thresholds
+            auto numberPeople = 0;
+            std::vector<int> validSubsetIndexes;
+            validSubsetIndexes.reserve(fastMin((size_t)POSE_MAX_PEOPLE, subset.size()));
+            for (auto index = 0u ; index < subset.size() ; index++)
+            {
+                const auto subsetCounter = subset[index].first[subsetCounterIndex];
+                const auto subsetScore = subset[index].second;
+                if (subsetCounter >= minSubsetCnt && (subsetScore/subsetCounter) >= minSubsetScore)
+                {
+                    numberPeople++;
+                    validSubsetIndexes.emplace_back(index);
+                    if (numberPeople == POSE_MAX_PEOPLE)
+                        break;
+                }
+                else if (subsetCounter < 1)
+                    error("Bad subsetCounter. Bug in this function if this happens.",
+                          __LINE__, __FUNCTION__, __FILE__);
+            }
+
+            // Fill and return poseKeypoints
+            if (numberPeople > 0)
+            {
+                poseKeypoints.reset({numberPeople, (int)numberBodyParts, 3});
+                poseScores.reset(numberPeople);
+            }
+            else
+            {
+                poseKeypoints.reset();
+                poseScores.reset();
+            }
+            const auto numberBodyPartsAndPAFs = numberBodyParts + numberBodyPartPairs;
+            for (auto person = 0u ; person < validSubsetIndexes.size() ; person++)
+            {
+                const auto& subsetPair = subset[validSubsetIndexes[person]];
+                const auto& subsetI = subsetPair.first;
+                for (auto bodyPart = 0u; bodyPart < numberBodyParts; bodyPart++)
+                {
+                    const auto baseOffset = (person*numberBodyParts + bodyPart) * 3;
+                    const auto bodyPartIndex = subsetI[bodyPart];
+                    if (bodyPartIndex > 0)
+                    {
+                        poseKeypoints[baseOffset] = peaksPtr[bodyPartIndex-2] * scaleFactor;
+                        poseKeypoints[baseOffset + 1] = peaksPtr[bodyPartIndex-1] * scaleFactor;
+                        poseKeypoints[baseOffset + 2] = peaksPtr[bodyPartIndex];
+                    }
+                    else
+                    {
+                        poseKeypoints[baseOffset] = 0.f;
+                        poseKeypoints[baseOffset + 1] = 0.f;
+                        poseKeypoints[baseOffset + 2] = 0.f;
+                    }
+                }
+                poseScores[person] = subsetPair.second / (float)(numberBodyPartsAndPAFs);
+            }
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+}
+
+// Random PAFs (constant in 10x10 blocks, so the line integrals are neither all above nor all below the thresholds) and
+// random peaks (peaksPtr format: for each body part, the number of peaks followed by #maxPeaks (x,y,score) triplets)
+void generateInput(std::vector<float>& heatMaps, std::vector<float>& peaks, std::mt19937& randomGenerator,
+                   const op::PoseModel poseModel, const op::Point<int>& heatMapSize,
+                   const op::Point<int>& peaksMapSize, const int maxPeaks, const int maxPeaksPerPart)
+{
+    std::uniform_real_distribution<float> uniform{0.f, 1.f};
+    const auto& mapIdx = op::getPoseMapIndex(poseModel);
+    const auto numberBodyParts = (int)op::getPoseNumberBodyParts(poseModel);
+    const auto numberChannels = (int)*std::max_element(mapIdx.begin(), mapIdx.end()) + 1;
+    heatMaps.resize(numberChannels * heatMapSize.area());
+    for (auto channel = 0 ; channel < numberChannels ; channel++)
+    {
+        const auto blockSeed = (unsigned int)(uniform(randomGenerator) * 1000000.f);
+        for (auto y = 0 ; y < heatMapSize.y ; y++)
+            for (auto x = 0 ; x < heatMapSize.x ; x++)
+            {
+                std::minstd_rand blockGenerator{blockSeed + 1000u*(y/10) + x/10};
+                heatMaps[(channel*heatMapSize.y + y)*heatMapSize.x + x] = (blockGenerator() % 2001) / 1000.f - 1.f;
+            }
+    }
+    peaks.assign(numberBodyParts * (maxPeaks+1) * 3, 0.f);
+    for (auto bodyPart = 0 ; bodyPart < numberBodyParts ; bodyPart++)
+    {
+        // Some body parts without peaks
+        const auto numberPeaks = (uniform(randomGenerator) < 0.1f
+                                  ? 0 : int(uniform(randomGenerator) * maxPeaksPerPart));
+        peaks[bodyPart*(maxPeaks+1)*3] = (float)numberPeaks;
+        for (auto peak = 1 ; peak <= numberPeaks ; peak++)
+        {
+            auto* peakPtr = &peaks[(bodyPart*(maxPeaks+1) + peak)*3];
+            peakPtr[0] = uniform(randomGenerator) * (peaksMapSize.x-1);
+            peakPtr[1] = uniform(randomGenerator) * (peaksMapSize.y-1);
+            peakPtr[2] = 0.05f + 0.95f * uniform(randomGenerator);
+        }
+    }
+}
+
+bool areEqual(const op::Array<float>& poseKeypoints, const op::Array<float>& poseScores,
+              const op::Array<float>& poseKeypointsReference, const op::Array<float>& poseScoresReference)
+{
+    if (poseKeypoints.getVolume() != poseKeypointsReference.getVolume()
+        || poseScores.getVolume() != poseScoresReference.getVolume())
+        return false;
+    for (auto i = 0u ; i < poseKeypoints.getVolume() ; i++)
+        if (poseKeypoints[i] != poseKeypointsReference[i])
+            return false;
+    for (auto i = 0u ; i < poseScores.getVolume() ; i++)
+        if (std::abs(poseScores[i] - poseScoresReference[i])
+            > FLAGS_score_tolerance * op::fastMax(1.f, std::abs(poseScoresReference[i])))
+            return false;
+    return true;
+}
+
+int bodyPartConnectorTest()
+{
+    // logging_level
+    op::check(0 <= FLAGS_logging_level && FLAGS_logging_level <= 255, "Wrong logging_level value.",
+              __LINE__, __FUNCTION__, __FILE__);
+    op::ConfigureLog::setPriorityThreshold((op::Priority)FLAGS_logging_level);
+    // Thread pool
+    if (FLAGS_num_cpu_threads != 0)
+        op::setDefaultThreadPool(std::make_shared<op::ThreadPool>(FLAGS_num_cpu_threads));
+
+    // Same thresholds as the default PoseExtractorNet ones, scaleFactor != 1 to also test the rescaling
+    const auto interMinAboveThreshold = 0.3f;
+    const auto interThreshold = 0.05f;
+    const auto minSubsetCnt = 3;
+    const auto minSubsetScore = 0.2f;
+    const auto scaleFactor = 1.5f;
+    const auto maxPeaks = 96;
+    const op::Point<int> heatMapSize{200, 150};
+    std::mt19937 randomGenerator{(unsigned int)FLAGS_seed};
+    std::vector<float> heatMaps;
+    std::vector<float> peaks;
+    auto numberTests = 0;
+    auto numberFailures = 0;
+    auto numberPeople = 0ull;
+    auto msReference = 0.;
+    auto msConnector = 0.;
+    for (auto model = 0 ; model < (int)op::PoseModel::Size ; model++)
+    {
+        const auto poseModel = (op::PoseModel)model;
+        // Mode 0: peaks on the heat maps. Mode 1: coarse-to-fine (peaks on their 2x upsampling)
+        for (auto upsample = 0 ; upsample < 2 ; upsample++)
+        {
+            const auto upsampledHeatMapSize = (upsample ? op::Point<int>{2*heatMapSize.x, 2*heatMapSize.y}
+                                                        : op::Point<int>{0, 0});
+            const auto& peaksMapSize = (upsample ? upsampledHeatMapSize : heatMapSize);
+            for (auto test = 0 ; test < FLAGS_number_tests ; test++)
+            {
+                // From a few to many peaks per body part (and so, to many people)
+                const auto maxPeaksPerPart = (test % 3 == 0 ? 3 : (test % 3 == 1 ? 10 : 40));
+                generateInput(heatMaps, peaks, randomGenerator, poseModel, heatMapSize, peaksMapSize, maxPeaks,
+                              maxPeaksPerPart);
+                op::Array<float> poseKeypointsReference;
+                op::Array<float> poseScoresReference;
+                op::Array<float> poseKeypoints;
+                op::Array<float> poseScores;
+                const auto start = std::chrono::high_resolution_clock::now();
+                op::connectBodyPartsCpuReference(
+                    poseKeypointsReference, poseScoresReference, heatMaps.data(), peaks.data(), poseModel,
+                    heatMapSize, maxPeaks, interMinAboveThreshold, interThreshold, minSubsetCnt, minSubsetScore,
+                    scaleFactor, upsampledHeatMapSize);
+                const auto middle = std::chrono::high_resolution_clock::now();
+                op::connectBodyPartsCpu(
+                    poseKeypoints, poseScores, heatMaps.data(), peaks.data(), poseModel, heatMapSize, maxPeaks,
+                    interMinAboveThreshold, interThreshold, minSubsetCnt, minSubsetScore, scaleFactor,
+                    upsampledHeatMapSize);
+                const auto end = std::chrono::high_resolution_clock::now();
+                msReference += std::chrono::duration<double, std::milli>(middle - start).count();
+                msConnector += std::chrono::duration<double, std::milli>(end - middle).count();
+                numberTests++;
+                numberPeople += poseScoresReference.getVolume();
+                if (!areEqual(poseKeypoints, poseScores, poseKeypointsReference, poseScoresReference))
+                {
+                    numberFailures++;
+                    op::log("Mismatch with model " + std::to_string(model) + ", upsampling "
+                            + std::to_string(upsample) + " and test " + std::to_string(test) + ": "
+                            + std::to_string(poseScores.getVolume()) + " vs. "
+                            + std::to_string(poseScoresReference.getVolume()) + " (reference) people.",
+                            op::Priority::High);
+                }
+            }
+        }
+    }
+
+    op::log(std::to_string(numberTests) + " tests (" + std::to_string(numberPeople) + " people), "
+            + std::to_string(numberFailures) + " failures. Time: " + std::to_string(msConnector) + " ms vs. "
+            + std::to_string(msReference) + " ms (reference).", op::Priority::High);
+    return (numberFailures == 0 ? 0 : -1);
+}
+
+int main(int argc, char *argv[])
+{
+    // Parsing command line flags
+    gflags::ParseCommandLineFlags(&argc, &argv, true);
+
+    // Running bodyPartConnectorTest
+    return bodyPartConnectorTest();
+}
@@ -0,0 +1,270 @@
+// ------------------------- OpenPose Exercise Counter Benchmark -------------------------
+// Accuracy and speed benchmark of the repetition counter. It replays the body keypoints saved with `--write_json`
+// (no network, so it can run on CI), counts the repetitions and compares the repetition events against labelled
+// ground-truth. It reports:
+    // 1. Precision and recall of the repetition events (an event matches a ground-truth repetition of the same person
+    //    and exercise if they are at most `tolerance_frames` frames apart)
+    // 2. Final count error of each person and exercise
+    // 3. End-to-end FPS and latency of each stage (parsing, keypoint filtering, counting)
+// It returns a non-zero value if the precision or recall are lower than `min_precision` or `min_recall`, so it can
+// guard against counting regressions. See `examples/tests/exercise_benchmark.sh` for the whole pipeline on
+// `examples/media/video.avi`, or for the replay of the labelled keypoint fixture `examples/media/exercise_keypoints/`
+// (ground-truth in `examples/media/exercise_repetitions.txt`).
+// Ground-truth file format: 1 repetition per line, `person_id exercise_name frame_number`, where frame_number is the
+// frame (0-based) on which the repetition is completed. Lines starting with `#` are ignored. The file written by
+// `write_events` follows the same format, so the current results can be used as baseline (after manual review).
+
+// C++ std library dependencies
+#include <algorithm> // std::sort
+#include <chrono> // `std::chrono::` functions and classes, e.g. std::chrono::milliseconds
+#include <cstdlib> // std::abs
+#include <fstream> // std::ifstream, std::ofstream
+#include <map>
+#include <sstream> // std::istringstream
+#include <tuple>
+// 3rdparty dependencies
+// GFlags: DEFINE_bool, _int32, _int64, _uint64, _double, _string
+#include <gflags/gflags.h>
+// Allow Google Flags in Ubuntu 14
+#ifndef GFLAGS_GFLAGS_H_
+    namespace gflags = google;
+#endif
+// OpenPose dependencies
+#include <openpose/core/headers.hpp>
+#include <openpose/exercise/headers.hpp>
+#include <openpose/filestream/headers.hpp>
+#include <openpose/pose/headers.hpp>
+#include <openpose/utilities/headers.hpp>
+
+// For info about the flags, check `examples/openpose/openpose.bin` and
+// `examples/tutorial_thread/5_replay_keypoints_and_count.cpp`.
+// Debugging/Other
+DEFINE_int32(logging_level,             3,              "The logging level. Integer in the range [0, 255]. 0 will output any log() message, while"
+                                                        " 255 will not output any. Current OpenPose library messages are in the range 0-4: 1 for"
+                                                        " low priority messages and 4 for important ones.");
+// Producer
+DEFINE_string(keypoint_dir,             "",             "Directory with the `--write_json` keypoint files.");
+DEFINE_int32(num_threads,               -1,             "Number of threads parsing the keypoint files. -1 for the number of CPU cores.");
+DEFINE_double(fps,                      30.,            "Frame rate of the original video.");
+// OpenPose
+DEFINE_string(model_folder,             "models/",      "Folder path (absolute or relative) where the models (and `exercise/exercises.txt`) are"
+                                                        " located.");
+DEFINE_string(exercise_file,            "",             "Exercise catalogue file. If empty, `model_folder` + `exercise/exercises.txt`.");
+DEFINE_string(model_pose,               "COCO",         "Model used to extract the keypoints: `COCO` (18 keypoints) or `MPI` (15 keypoints).");
+DEFINE_bool(filter_keypoints,           false,          "Whether to smooth the body keypoints across frames and fill the keypoints missed during a"
+                                                        " few frames (as `--filter_keypoints` in the OpenPose demo).");
+// Benchmark
+DEFINE_string(ground_truth,             "",             "Ground-truth repetitions. If empty, only the speed is measured.");
+DEFINE_int32(tolerance_frames,          15,             "Maximum frame difference between matched repetitions.");
+DEFINE_double(min_precision,            0.,             "Minimum precision, otherwise it returns an error code.");
+DEFINE_double(min_recall,               0.,             "Minimum recall, otherwise it returns an error code.");
+// Result Saving
+DEFINE_string(write_events,             "",             "File path to write the detected repetitions in ground-truth"
+                                                        " format.");
+
+// (person ID, exercise name) -> frame numbers of the repetitions
+typedef std::map<std::pair<long long, std::string>, std::vector<unsigned long long>> RepetitionFrames;
+
+RepetitionFrames loadGroundTruth(const std::string& filePath)
+{
+    try
+    {
+        RepetitionFrames repetitionFrames;
+        std::ifstream ifstream{filePath};
+        if (!ifstream.is_open())
+            op::error("Ground-truth file could not be opened: `" + filePath + "`.", __LINE__, __FUNCTION__, __FILE__);
+        std::string line;
+        auto lineNumber = 0u;
+        while (std::getline(ifstream, line))
+        {
+            lineNumber++;
+            if (line.empty() || line[0] == '#')
+                continue;
+            std::istringstream istringstream{line};
+            long long personId;
+            std::string exerciseName;
+            unsigned long long frameNumber;
+            if (!(istringstream >> personId >> exerciseName >> frameNumber))
+                op::error(filePath + ":" + std::to_string(lineNumber) + ": expected `person_id exercise_name"
+                          " frame_number`.", __LINE__, __FUNCTION__, __FILE__);
+            repetitionFrames[std::make_pair(personId, exerciseName)].emplace_back(frameNumber);
+        }
+        for (auto& keyAndFrames : repetitionFrames)
+            std::sort(keyAndFrames.second.begin(), keyAndFrames.second.end());
+        return repetitionFrames;
+    }
+    catch (const std::exception& e)
+    {
+        op::error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        return RepetitionFrames{};
+    }
+}
+
+// Number of matched repetitions (greedy matching in time order, both lists sorted)
+unsigned long long matchRepetitions(const std::vector<unsigned long long>& detectedFrames,
+                                    const std::vector<unsigned long long>& groundTruthFrames,
+                                    const long long toleranceFrames)
+{
+    auto numberMatches = 0ull;
+    auto groundTruthIndex = 0u;
+    for (const auto detectedFrame : detectedFrames)
+    {
+        // Skip ground-truth repetitions too old to be matched
+        while (groundTruthIndex < groundTruthFrames.size()
+               && (long long)groundTruthFrames[groundTruthIndex] + toleranceFrames < (long long)detectedFrame)
+            groundTruthIndex++;
+        if (groundTruthIndex < groundTruthFrames.size()
+            && std::abs((long long)groundTruthFrames[groundTruthIndex] - (long long)detectedFrame) <= toleranceFrames)
+        {
+            numberMatches++;
+            groundTruthIndex++;
+        }
+    }
+    return numberMatches;
+}
+
+std::string msToString(const double totalSeconds, const unsigned long long numberFrames)
+{
+    return std::to_string(1e3 * totalSeconds / op::fastMax(1ull, numberFrames)) + " ms/frame";
+}
+
+int exerciseBenchmark()
+{
+    // logging_level
+    op::check(0 <= FLAGS_logging_level && FLAGS_logging_level <= 255, "Wrong logging_level value.",
+              __LINE__, __FUNCTION__, __FILE__);
+    op::ConfigureLog::setPriorityThreshold((op::Priority)FLAGS_logging_level);
+    if (FLAGS_keypoint_dir.empty())
+        op::error("Flag `--keypoint_dir` is required.", __LINE__, __FUNCTION__, __FILE__);
+
+    // Stages (the same ones than the online pipeline after the network)
+    const auto poseModel = op::flagsToPoseModel(FLAGS_model_pose);
+    const auto exerciseFile = (FLAGS_exercise_file.empty()
+                               ? FLAGS_model_folder + "exercise/exercises.txt" : FLAGS_exercise_file);
+    op::KeypointLoader keypointLoader{FLAGS_keypoint_dir, FLAGS_num_threads};
+    op::KeypointFilter keypointFilter{(float)FLAGS_fps};
+    op::ExerciseCounter exerciseCounter{poseModel, exerciseFile};
+    const auto& exerciseNames = exerciseCounter.getExerciseNames();
+
+    // Replay
+    op::log("Replaying " + std::to_string(keypointLoader.getNumberFrames()) + " frames.", op::Priority::High);
+    typedef std::chrono::high_resolution_clock Clock;
+    const auto getSeconds = [](const Clock::time_point& begin)
+    {
+        return (double)std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now()-begin).count() * 1e-9;
+    };
+    RepetitionFrames detectedFrames;
+    std::map<std::pair<long long, std::string>, int> detectedCounts;
+    auto parsingSeconds = 0.;
+    auto filteringSeconds = 0.;
+    auto countingSeconds = 0.;
+    auto maxCountingSeconds = 0.;
+    auto frameNumber = 0ull;
+    const op::Array<long long> poseIds; // Person index as ID (as `--write_json` does not save IDs)
+    const auto timerBegin = Clock::now();
+    std::vector<std::string> frameNames;
+    while (!keypointLoader.isFinished())
+    {
+        // Parsing
+        auto timerStage = Clock::now();
+        auto poseKeypointsBatch = keypointLoader.loadNextBatch(frameNames);
+        parsingSeconds += getSeconds(timerStage);
+        for (auto& poseKeypoints : poseKeypointsBatch)
+        {
+            // Keypoint filtering
+            if (FLAGS_filter_keypoints)
+            {
+                timerStage = Clock::now();
+                keypointFilter.filter(poseKeypoints, poseIds, frameNumber);
+                filteringSeconds += getSeconds(timerStage);
+            }
+            // Counting
+            timerStage = Clock::now();
+            const auto repetitionCounts = exerciseCounter.count(poseKeypoints, poseIds, frameNumber);
+            const auto frameCountingSeconds = getSeconds(timerStage);
+            countingSeconds += frameCountingSeconds;
+            maxCountingSeconds = op::fastMax(maxCountingSeconds, frameCountingSeconds);
+            // Results
+            for (const auto& repetitionEvent : exerciseCounter.getRepetitionEvents())
+            {
+                const auto key = std::make_pair(repetitionEvent.personId, exerciseNames[repetitionEvent.exercise]);
+                detectedFrames[key].emplace_back(frameNumber);
+                detectedCounts[key] = repetitionEvent.repetition;
+            }
+            frameNumber++;
+        }
+    }
+    const auto totalSeconds = getSeconds(timerBegin);
+
+    // Speed
+    op::log("Frames: " + std::to_string(frameNumber), op::Priority::High);
+    op::log("End-to-end: " + std::to_string(frameNumber / op::fastMax(totalSeconds, 1e-9)) + " FPS ("
+            + msToString(totalSeconds, frameNumber) + ").", op::Priority::High);
+    op::log("    Parsing: " + msToString(parsingSeconds, frameNumber) + ".", op::Priority::High);
+    if (FLAGS_filter_keypoints)
+        op::log("    Keypoint filtering: " + msToString(filteringSeconds, frameNumber) + ".", op::Priority::High);
+    op::log("    Counting: " + msToString(countingSeconds, frameNumber) + " (max "
+            + std::to_string(1e3 * maxCountingSeconds) + " ms).", op::Priority::High);
+
+    // Detected repetitions in ground-truth format
+    if (!FLAGS_write_events.empty())
+    {
+        std::ofstream ofstream{FLAGS_write_events};
+        ofstream << "# person_id exercise_name frame_number\n";
+        for (const auto& keyAndFrames : detectedFrames)
+            for (const auto detectedFrame : keyAndFrames.second)
+                ofstream << keyAndFrames.first.first << " " << keyAndFrames.first.second << " " << detectedFrame
+                         << "\n";
+    }
+
+    // Accuracy
+    if (!FLAGS_ground_truth.empty())
+    {
+        const auto groundTruthFrames = loadGroundTruth(FLAGS_ground_truth);
+        auto numberDetected = 0ull;
+        auto numberGroundTruth = 0ull;
+        auto numberMatches = 0ull;
+        // Per person and exercise
+        std::map<std::pair<long long, std::string>, std::tuple<int, int>> counts; // (detected, ground-truth)
+        for (const auto& keyAndFrames : detectedFrames)
+        {
+            numberDetected += keyAndFrames.second.size();
+            std::get<0>(counts[keyAndFrames.first]) = detectedCounts[keyAndFrames.first];
+        }
+        for (const auto& keyAndFrames : groundTruthFrames)
+        {
+            numberGroundTruth += keyAndFrames.second.size();
+            std::get<1>(counts[keyAndFrames.first]) = (int)keyAndFrames.second.size();
+            const auto detected = detectedFrames.find(keyAndFrames.first);
+            if (detected != detectedFrames.end())
+                numberMatches += matchRepetitions(detected->second, keyAndFrames.second, FLAGS_tolerance_frames);
+        }
+        for (const auto& keyAndCounts : counts)
+            op::log("Person " + std::to_string(keyAndCounts.first.first) + " " + keyAndCounts.first.second
+                    + ": detected " + std::to_string(std::get<0>(keyAndCounts.second)) + ", ground-truth "
+                    + std::to_string(std::get<1>(keyAndCounts.second)) + ".", op::Priority::High);
+        const auto precision = (numberDetected > 0 ? numberMatches / (double)numberDetected : 1.);
+        const auto recall = (numberGroundTruth > 0 ? numberMatches / (double)numberGroundTruth : 1.);
+        op::log("Precision: " + std::to_string(precision) + " (" + std::to_string(numberMatches) + "/"
+                + std::to_string(numberDetected) + "), recall: " + std::to_string(recall) + " ("
+                + std::to_string(numberMatches) + "/" + std::to_string(numberGroundTruth) + ").",
+                op::Priority::High);
+        // Regression check
+        if (precision < FLAGS_min_precision || recall < FLAGS_min_recall)
+        {
+            op::log("Accuracy lower than `--min_precision " + std::to_string(FLAGS_min_precision)
+                    + "` or `--min_recall " + std::to_string(FLAGS_min_recall) + "`.", op::Priority::High);
+            return 1;
+        }
+    }
+    return 0;
+}
+
+int main(int argc, char *argv[])
+{
+    // Parsing command line flags
+    gflags::ParseCommandLineFlags(&argc, &argv, true);
+
+    // Running exerciseBenchmark
+    return exerciseBenchmark();
+}
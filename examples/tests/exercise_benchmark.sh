@@ -0,0 +1,48 @@
+# Script for internal use. We might completely change it continuously and we will not answer questions about it.
+
+# USAGE EXAMPLE
+# clear && clear && make all -j`nproc` && bash ./examples/tests/exercise_benchmark.sh
+# CI (replay mode, no network, it fails if the counting accuracy drops):
+# REPLAY_ONLY=1 bash ./examples/tests/exercise_benchmark.sh
+
+# # Go back to main folder
+# cd ../../
+
+# Parameters
+VIDEO=examples/media/video.avi
+BENCHMARK_BIN=./build/examples/tests/exerciseBenchmark.bin
+OP_BIN=./build/examples/openpose/openpose.bin
+MIN_PRECISION=${MIN_PRECISION:-0.9}
+MIN_RECALL=${MIN_RECALL:-0.9}
+if [ -n "$REPLAY_ONLY" ]; then
+    # Keypoint fixture shipped with OpenPose and its labels
+    JSON_FOLDER=${JSON_FOLDER:-examples/media/exercise_keypoints/}
+    # 1 repetition per line: `person_id exercise_name frame_number` (see examples/tests/exerciseBenchmark.cpp)
+    GROUND_TRUTH=${GROUND_TRUTH:-examples/media/exercise_repetitions.txt}
+else
+    # Keypoints of $VIDEO, without labels (accuracy only measured if GROUND_TRUTH is set)
+    JSON_FOLDER=${JSON_FOLDER:-../evaluation/exercise_benchmark_jsons/}
+    GROUND_TRUTH=${GROUND_TRUTH:-}
+fi
+
+# Step 1 - Keypoints (network) + end-to-end speed of OpenPose (never in replay-only mode)
+if [ -z "$REPLAY_ONLY" ]; then
+    rm -rf $JSON_FOLDER && mkdir -p $JSON_FOLDER
+    time $OP_BIN --video $VIDEO --write_json $JSON_FOLDER --display 0 --render_pose 0
+elif [ ! -d $JSON_FOLDER ]; then
+    echo "Keypoint folder not found: ${JSON_FOLDER}."
+    exit 1
+fi
+if [ -n "$GROUND_TRUTH" ] && [ ! -f $GROUND_TRUTH ]; then
+    echo "Ground-truth file not found: ${GROUND_TRUTH}."
+    exit 1
+fi
+
+# Step 2 - Counting accuracy + speed of each stage after the network (replay)
+$BENCHMARK_BIN --keypoint_dir $JSON_FOLDER --ground_truth "$GROUND_TRUTH" \
+    --min_precision $MIN_PRECISION --min_recall $MIN_RECALL
+    # With temporal filtering
+# $BENCHMARK_BIN --keypoint_dir $JSON_FOLDER --ground_truth "$GROUND_TRUTH" --filter_keypoints \
+#     --min_precision $MIN_PRECISION --min_recall $MIN_RECALL
+    # Baseline (review it manually before using it as ground-truth)
+# $BENCHMARK_BIN --keypoint_dir $JSON_FOLDER --write_events ${JSON_FOLDER}../video_repetitions.txt
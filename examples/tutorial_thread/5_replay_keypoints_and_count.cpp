@@ -0,0 +1,182 @@
+// ------------------------- OpenPose Library Tutorial - Thread - Example 5 - Replay Keypoints And Count -------------------------
+// This fifth example shows the user how to:
+    // 1. Read the body keypoints previously saved with `--write_json` or `--write_keypoint` (`filestream` module)
+    // 2. Count the repetitions of each exercise of each person (`exercise` module)
+    // 3. Print the final counts
+    // Everything in a multi-thread scenario (`thread` module), without the network nor any image decoding, so
+    // archived sessions can be re-scored (e.g., after tuning the exercise thresholds) in seconds
+// In addition to the previous OpenPose modules, we also need to use:
+    // 1. `core` module: for the Datum struct that the `thread` module sends between the queues
+    // 2. `utilities` module: for the error & logging functions, i.e. op::error & op::log respectively
+
+// C++ std library dependencies
+#include <chrono> // `std::chrono::` functions and classes, e.g. std::chrono::milliseconds
+#include <map>
+// 3rdparty dependencies
+// GFlags: DEFINE_bool, _int32, _int64, _uint64, _double, _string
+#include <gflags/gflags.h>
+// Allow Google Flags in Ubuntu 14
+#ifndef GFLAGS_GFLAGS_H_
+    namespace gflags = google;
+#endif
+// OpenPose dependencies
+#include <openpose/core/headers.hpp>
+#include <openpose/exercise/headers.hpp>
+#include <openpose/filestream/headers.hpp>
+#include <openpose/pose/headers.hpp>
+#include <openpose/thread/headers.hpp>
+#include <openpose/utilities/headers.hpp>
+
+// See all the available parameter options withe the `--help` flag. E.g. `build/examples/openpose/openpose.bin --help`
+// Note: This command will show you flags for other unnecessary 3rdparty files. Check only the flags for the OpenPose
+// executable. E.g. for `openpose.bin`, look for `Flags from examples/openpose/openpose.cpp:`.
+// Debugging/Other
+DEFINE_int32(logging_level,             3,              "The logging level. Integer in the range [0, 255]. 0 will output any log() message, while"
+                                                        " 255 will not output any. Current OpenPose library messages are in the range 0-4: 1 for"
+                                                        " low priority messages and 4 for important ones.");
+// Producer
+DEFINE_string(keypoint_dir,             "",             "Directory with the keypoint files written by `--write_json` (`*_keypoints.json`) or"
+                                                        " `--write_keypoint` (`*_pose.*`), 1 file per frame.");
+DEFINE_int32(num_threads,               -1,             "Number of threads used to parse the keypoint files. Select -1 to use all the available"
+                                                        " CPU cores.");
+// OpenPose
+DEFINE_string(model_folder,             "models/",      "Folder path (absolute or relative) where the models (pose, face, ...) are located.");
+DEFINE_string(exercise_file,            "",             "Exercise catalogue file (see `models/exercise/exercises.txt` for the format). If empty,"
+                                                        " `model_folder` + `exercise/exercises.txt` is used.");
+DEFINE_string(model_pose,               "COCO",         "Model used to generate the keypoints. E.g. `COCO` (18 keypoints) or `MPI` (15 keypoints).");
+// Result Saving
+DEFINE_string(write_rep_events,         "",             "File path to append one event per repetition (person ID, exercise, frame, time, phase"
+                                                        " durations and confidence), in JSON-lines format (1 JSON object per line).");
+DEFINE_bool(write_rep_events_binary,    false,          "Write `write_rep_events` in the compact binary format (see op::RepEventSaver) instead"
+                                                        " of JSON lines.");
+DEFINE_double(fps,                      30.,            "Frame rate of the original video, used to convert the frame numbers of `write_rep_events`"
+                                                        " into time.");
+
+// Consumer that keeps the last count of each person and prints them at the end
+class WUserOutput : public op::WorkerConsumer<std::shared_ptr<std::vector<op::Datum>>>
+{
+public:
+    void initializationOnThread() {}
+
+    void workConsumer(const std::shared_ptr<std::vector<op::Datum>>& datumsPtr)
+    {
+        try
+        {
+            if (datumsPtr != nullptr && !datumsPtr->empty())
+            {
+                const auto& datum = datumsPtr->at(0);
+                const auto& repetitionCounts = datum.repetitionCounts;
+                const auto numberPeople = (repetitionCounts.empty() ? 0 : repetitionCounts.getSize(0));
+                for (auto person = 0 ; person < numberPeople ; person++)
+                {
+                    const auto personId = (datum.poseIds.getVolume() == (size_t)numberPeople
+                                           ? datum.poseIds[person] : (long long)person);
+                    const auto* countPtr = repetitionCounts.getConstPtr() + person * repetitionCounts.getSize(1);
+                    mRepetitionCounts[personId].assign(countPtr, countPtr + repetitionCounts.getSize(1));
+                }
+                mNumberFrames++;
+            }
+        }
+        catch (const std::exception& e)
+        {
+            op::log("Some kind of unexpected error happened.");
+            this->stop();
+            op::error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    void printResults(const std::vector<std::string>& exerciseNames) const
+    {
+        op::log("Frames processed: " + std::to_string(mNumberFrames), op::Priority::High);
+        for (const auto& repetitionCount : mRepetitionCounts)
+        {
+            std::string counts;
+            for (auto exercise = 0u ; exercise < exerciseNames.size() ; exercise++)
+                counts += " " + exerciseNames[exercise] + "=" + std::to_string(repetitionCount.second[exercise]);
+            op::log("Person " + std::to_string(repetitionCount.first) + ":" + counts, op::Priority::High);
+        }
+    }
+
+private:
+    std::map<long long, std::vector<int>> mRepetitionCounts;
+    unsigned long long mNumberFrames = 0ull;
+};
+
+int openPoseTutorialThread5()
+{
+    op::log("OpenPose Library Tutorial - Example 5.", op::Priority::High);
+    // ------------------------- INITIALIZATION -------------------------
+    // Step 1 - Set logging level
+        // - 0 will output all the logging messages
+        // - 255 will output nothing
+    op::check(0 <= FLAGS_logging_level && FLAGS_logging_level <= 255, "Wrong logging_level value.",
+              __LINE__, __FUNCTION__, __FILE__);
+    op::ConfigureLog::setPriorityThreshold((op::Priority)FLAGS_logging_level);
+    op::Profiler::setDefaultX(100);
+    // Step 2 - Read Google flags (user defined configuration)
+    const auto poseModel = op::flagsToPoseModel(FLAGS_model_pose);
+    op::log("", op::Priority::Low, __LINE__, __FUNCTION__, __FILE__);
+    // Step 3 - Setting thread workers && manager
+    typedef std::shared_ptr<std::vector<op::Datum>> TypedefDatums;
+    op::ThreadManager<TypedefDatums> threadManager;
+    // Step 4 - Initializing the worker classes
+    // Keypoint producer (parses the files in parallel)
+    auto keypointLoader = std::make_shared<op::KeypointLoader>(FLAGS_keypoint_dir, FLAGS_num_threads);
+    auto wKeypointLoader = std::make_shared<op::WKeypointLoader<TypedefDatums>>(keypointLoader);
+    // Repetition counter
+    const auto exerciseFile = (FLAGS_exercise_file.empty()
+                               ? FLAGS_model_folder + "exercise/exercises.txt" : FLAGS_exercise_file);
+    auto exerciseCounter = std::make_shared<op::ExerciseCounter>(poseModel, exerciseFile);
+    auto wExerciseCounter = std::make_shared<op::WExerciseCounter<TypedefDatums>>(exerciseCounter);
+    // Repetition event saver
+    std::shared_ptr<op::WRepEventSaver<TypedefDatums>> wRepEventSaver;
+    if (!FLAGS_write_rep_events.empty())
+    {
+        const auto repEventSaver = std::make_shared<op::RepEventSaver>(
+            FLAGS_write_rep_events, exerciseCounter->getExerciseNames(), FLAGS_fps,
+            (FLAGS_write_rep_events_binary ? op::RepEventFormat::Binary : op::RepEventFormat::JsonLines));
+        wRepEventSaver = std::make_shared<op::WRepEventSaver<TypedefDatums>>(repEventSaver);
+    }
+    // Results
+    auto wUserOutput = std::make_shared<WUserOutput>();
+
+    // ------------------------- CONFIGURING THREADING -------------------------
+    // The counter is sequential (its state depends on the previous frames), so the parallelism is on the parsing
+    auto threadId = 0ull;
+    auto queueIn = 0ull;
+    auto queueOut = 1ull;
+    threadManager.add(threadId++, wKeypointLoader, queueIn++, queueOut++);      // Thread 0, queues 0 -> 1
+    threadManager.add(threadId++, wExerciseCounter, queueIn++, queueOut++);     // Thread 1, queues 1 -> 2
+    std::vector<std::shared_ptr<op::Worker<TypedefDatums>>> outputWorkers;
+    if (wRepEventSaver != nullptr)
+        outputWorkers.emplace_back(wRepEventSaver);
+    outputWorkers.emplace_back(wUserOutput);
+    threadManager.add(threadId++, outputWorkers, queueIn++, queueOut++);        // Thread 2, queues 2 -> 3
+
+    // ------------------------- STARTING AND STOPPING THREADING -------------------------
+    op::log("Starting thread(s)", op::Priority::High);
+    const auto timerBegin = std::chrono::high_resolution_clock::now();
+    threadManager.exec();  // It blocks this thread until all threads have finished
+    const auto totalTimeSec = (double)std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::high_resolution_clock::now()-timerBegin
+    ).count() * 1e-9;
+
+    // ------------------------- CLOSING -------------------------
+    wUserOutput->printResults(exerciseCounter->getExerciseNames());
+    op::log("Total time: " + std::to_string(totalTimeSec) + " seconds ("
+            + std::to_string(keypointLoader->getNumberFrames() / op::fastMax(totalTimeSec, 1e-9)) + " FPS).",
+            op::Priority::High);
+    // Logging information message
+    op::log("Example 5 successfully finished.", op::Priority::High);
+    // Return successful message
+    return 0;
+}
+
+int main(int argc, char *argv[])
+{
+    // Parsing command line flags
+    gflags::ParseCommandLineFlags(&argc, &argv, true);
+
+    // Running openPoseTutorialThread5
+    return openPoseTutorialThread5();
+}
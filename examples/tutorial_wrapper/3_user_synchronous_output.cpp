@@ -154,7 +154,8 @@ DEFINE_int32(3d_views,                  1,              "Complementary option to
                                                         " `--camera_parameters_folder` must be set. OpenPose must find as many `xml` files in the"
                                                         " parameter folder as this number indicates.");
 // OpenPose identification
-DEFINE_bool(identification,             false,          "Whether to enable people identification across frames. Not available yet, coming soon.");
+DEFINE_bool(identification,             false,          "Whether to enable people identification across frames (consistent IDs by matching the"
+                                                        " keypoints of consecutive frames).");
 // OpenPose Rendering
 DEFINE_int32(part_to_show,              0,              "Prediction channel to visualize (default: 0). 0 for all the body parts, 1-18 for each body"
                                                         " part heat map, 19 for the background heat map, 20 for all the body part heat maps"
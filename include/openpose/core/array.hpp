@@ -4,6 +4,7 @@
 #include <memory> // std::shared_ptr
 #include <vector>
 #include <opencv2/core/core.hpp> // cv::Mat
+#include <openpose/core/arrayAllocator.hpp>
 #include <openpose/core/macros.hpp>
 
 namespace op
@@ -15,6 +16,8 @@ namespace op
      * It wraps a cv::Mat and a std::shared_ptr, both of them pointing to the same raw data. I.e. they both share the
      * same memory, so we can read and modify this data in both formats with no performance impact.
      * Hence, it keeps high performance while adding high-level functions.
+     * Its memory comes from an ArrayAllocator (by default 64-byte aligned, see setAllocator()), or it can wrap an
+     * external buffer with no copy (see wrap()).
      */
     template<typename T>
     class Array
@@ -100,6 +103,9 @@ namespace op
         /**
          * Data allocation function.
          * It allocates the required space for the memory (it does not initialize that memory).
+         * If the Array already had the same volume and it does not share its memory with any other Array (see the
+         * copy constructor), that memory is re-used rather than re-allocated (unless it was wrapped with wrap() or
+         * the allocator changed).
          * @param size Integer with the number of T element to be allocated. E.g. size = 5 is internally similar to
          * `new T[5]`.
          */
@@ -140,6 +146,28 @@ namespace op
          */
         void setFrom(const cv::Mat& cvMat);
 
+        /**
+         * Data wrapping function.
+         * It uses the memory pointed by dataPtr (zero-copy), which is neither owned nor released by the Array. The
+         * caller must keep it valid while this Array (or any copy of it) uses it. The following reset() calls
+         * allocate new memory.
+         * @param sizes Vector with the size of each dimension.
+         * @param dataPtr Pointer to at least size[0] x ... x size[N-1] elements.
+         */
+        void wrap(const std::vector<int>& sizes, T* const dataPtr);
+
+        /**
+         * Memory provider for the next allocations (the current memory is not moved). The copies and clones of this
+         * Array keep it.
+         * @param allocator nullptr to use ArrayAllocator::getDefault().
+         */
+        void setAllocator(const std::shared_ptr<ArrayAllocator>& allocator);
+
+        inline const std::shared_ptr<ArrayAllocator>& getAllocator() const
+        {
+            return spAllocator;
+        }
+
         /**
          * Data allocation function.
          * It internally assigns all the allocated memory to the value indicated by the argument.
@@ -383,6 +411,10 @@ namespace op
         size_t mVolume;
         std::shared_ptr<T> spData;
         std::pair<bool, cv::Mat> mCvMatData;
+        // Allocator for the new memory (nullptr = default one)
+        std::shared_ptr<ArrayAllocator> spAllocator;
+        // Allocator that provided spData (nullptr if not owned, i.e., wrap())
+        std::shared_ptr<ArrayAllocator> spDataAllocator;
 
         /**
          * Auxiliar function that both operator[](const std::vector<int>& indexes) and
@@ -0,0 +1,73 @@
+#ifndef OPENPOSE_CORE_ARRAY_ALLOCATOR_HPP
+#define OPENPOSE_CORE_ARRAY_ALLOCATOR_HPP
+
+#include <cstddef> // size_t
+#include <memory> // std::shared_ptr
+#include <openpose/core/macros.hpp>
+
+namespace op
+{
+    /**
+     * ArrayAllocator: Memory provider of Array<T> (see Array<T>::setAllocator()).
+     * Derive from it to place the Array data in an arena, a pool, huge pages, pinned memory, etc. It must be
+     * thread-safe if the Arrays using it are allocated or released from different threads. Array<T> keeps a
+     * std::shared_ptr to it while its memory is alive.
+     */
+    class OP_API ArrayAllocator
+    {
+    public:
+        virtual ~ArrayAllocator();
+
+        /**
+         * @param numberBytes Size of the requested memory (it might be 0).
+         * @return Pointer to the new memory (aligned to at least alignof(long double)). It must throw if it fails.
+         */
+        virtual void* allocate(const size_t numberBytes) = 0;
+
+        /**
+         * @param memoryPtr Pointer previously returned by allocate(numberBytes).
+         * @param numberBytes Same value used to allocate it.
+         */
+        virtual void deallocate(void* const memoryPtr, const size_t numberBytes) = 0;
+
+        /**
+         * Allocator of the Arrays that do not set their own one. By default, an AlignedArrayAllocator.
+         */
+        static std::shared_ptr<ArrayAllocator> getDefault();
+
+        /**
+         * @param allocator New default allocator (nullptr to restore the default AlignedArrayAllocator). It only
+         * affects the future allocations.
+         */
+        static void setDefault(const std::shared_ptr<ArrayAllocator>& allocator);
+    };
+
+    /**
+     * AlignedArrayAllocator: Heap memory aligned to the desired boundary (default: 64 bytes, i.e., the cache line and
+     * the widest SIMD register), so vectorized kernels can use aligned loads on the Array data.
+     */
+    class OP_API AlignedArrayAllocator : public ArrayAllocator
+    {
+    public:
+        /**
+         * @param alignment Power of 2, multiple of sizeof(void*).
+         */
+        explicit AlignedArrayAllocator(const size_t alignment = 64);
+
+        void* allocate(const size_t numberBytes);
+
+        void deallocate(void* const memoryPtr, const size_t numberBytes);
+
+        inline size_t getAlignment() const
+        {
+            return mAlignment;
+        }
+
+    private:
+        const size_t mAlignment;
+
+        DELETE_COPY(AlignedArrayAllocator);
+    };
+}
+
+#endif // OPENPOSE_CORE_ARRAY_ALLOCATOR_HPP
@@ -16,6 +16,14 @@ namespace op
                                               const std::vector<double>& scaleInputToNetInputs,
                                               const std::vector<Point<int>>& netInputSizes) const;
 
+        /**
+         * Analogous to createArray(cvInputData, scaleInputToNetInputs, netInputSizes), but it fills inputNetData,
+         * re-using its memory if its Arrays already have the desired size (e.g. Datums recycled by DatumPool).
+         */
+        void createArray(std::vector<Array<float>>& inputNetData, const cv::Mat& cvInputData,
+                         const std::vector<double>& scaleInputToNetInputs,
+                         const std::vector<Point<int>>& netInputSizes) const;
+
     private:
         const PoseModel mPoseModel;
     };
@@ -11,6 +11,13 @@ namespace op
     public:
         Array<float> createArray(const cv::Mat& cvInputData, const double scaleInputToOutput,
                                  const Point<int>& outputResolution) const;
+
+        /**
+         * Analogous to createArray(cvInputData, scaleInputToOutput, outputResolution), but it fills outputData,
+         * re-using its memory if it already has the desired size (e.g. Datums recycled by DatumPool).
+         */
+        void createArray(Array<float>& outputData, const cv::Mat& cvInputData, const double scaleInputToOutput,
+                         const Point<int>& outputResolution) const;
     };
 }
 
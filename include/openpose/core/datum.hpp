@@ -3,6 +3,7 @@
 
 #include <opencv2/core/core.hpp> // cv::Mat
 #include <openpose/core/common.hpp>
+#include <openpose/core/repetitionEvent.hpp>
 
 namespace op
 {
@@ -90,6 +91,20 @@ namespace op
          */
         Array<float> poseScores;
 
+        /**
+         * Number of exercise repetitions (e.g., jumping jacks) for each person in the image and each exercise.
+         * It is filled by the exercise module (WExerciseCounter) and it follows the same person order than
+         * poseKeypoints. If no exercise counter is enabled or poseKeypoints is empty, it will also be empty.
+         * Size: #people x #exercises (see ExerciseCounter::getExerciseNames())
+         */
+        Array<int> repetitionCounts;
+
+        /**
+         * Exercise repetitions completed on this frame (usually empty). It is filled by the exercise module
+         * (WExerciseCounter) together with repetitionCounts.
+         */
+        std::vector<RepetitionEvent> repetitionEvents;
+
         /**
          * Body pose heatmaps (body parts, background and/or PAFs) for the whole image.
          * This parameter is by default empty and disabled for performance. Each group (body parts, background and
@@ -3,6 +3,7 @@
 
 // core module
 #include <openpose/core/array.hpp>
+#include <openpose/core/arrayAllocator.hpp>
 #include <openpose/core/common.hpp>
 #include <openpose/core/cvMatToOpInput.hpp>
 #include <openpose/core/cvMatToOpOutput.hpp>
@@ -10,16 +11,19 @@
 #include <openpose/core/enumClasses.hpp>
 #include <openpose/core/gpuRenderer.hpp>
 #include <openpose/core/keepTopNPeople.hpp>
+#include <openpose/core/keypointFilter.hpp>
 #include <openpose/core/keypointScaler.hpp>
 #include <openpose/core/macros.hpp>
 #include <openpose/core/opOutputToCvMat.hpp>
 #include <openpose/core/point.hpp>
 #include <openpose/core/rectangle.hpp>
 #include <openpose/core/renderer.hpp>
+#include <openpose/core/repetitionEvent.hpp>
 #include <openpose/core/scaleAndSizeExtractor.hpp>
 #include <openpose/core/wCvMatToOpInput.hpp>
 #include <openpose/core/wCvMatToOpOutput.hpp>
 #include <openpose/core/wKeepTopNPeople.hpp>
+#include <openpose/core/wKeypointFilter.hpp>
 #include <openpose/core/wKeypointScaler.hpp>
 #include <openpose/core/wOpOutputToCvMat.hpp>
 #include <openpose/core/wScaleAndSizeExtractor.hpp>
@@ -0,0 +1,78 @@
+#ifndef OPENPOSE_CORE_KEYPOINT_FILTER_HPP
+#define OPENPOSE_CORE_KEYPOINT_FILTER_HPP
+
+#include <unordered_map>
+#include <openpose/core/common.hpp>
+
+namespace op
+{
+    /**
+     * KeypointFilter: Temporal smoothing of the keypoints of each person (One-Euro filter, i.e., an adaptive
+     * low-pass filter whose cutoff frequency increases with the keypoint speed, so static keypoints do not jitter
+     * while fast ones have little lag).
+     * It also fills short gaps: if a keypoint is not detected (score = 0) but it was during the last maxGapFrames
+     * frames, its last filtered position and score are kept (rather than the (0,0) coordinates of non-detected
+     * keypoints).
+     * The state is keyed by the view and person ID (Datum::poseIds), or by the person index if poseIds is empty. It
+     * must be applied in frame order (e.g., after WQueueOrderer), and before re-scaling the keypoints.
+     */
+    class OP_API KeypointFilter
+    {
+    public:
+        /**
+         * Constructor.
+         * @param fps Frame rate of the input, used to convert frame differences into time.
+         * @param minCutoff Minimum cutoff frequency (Hz). Lower values reduce the jitter of static keypoints.
+         * @param beta Speed coefficient (1/pixel). Higher values reduce the lag of fast keypoints.
+         * @param derivativeCutoff Cutoff frequency (Hz) of the speed estimation.
+         * @param maxGapFrames Maximum number of consecutive frames a non-detected keypoint is filled.
+         * @param numberFramesToDeletePerson Number of frames without detecting a person before removing its state.
+         */
+        explicit KeypointFilter(const float fps = 30.f, const float minCutoff = 1.f, const float beta = 0.05f,
+                                const float derivativeCutoff = 1.f, const int maxGapFrames = 5,
+                                const int numberFramesToDeletePerson = 30);
+
+        /**
+         * It filters the keypoints in place.
+         * @param keypoints Keypoints (#people x #body parts x 3) of the current frame.
+         * @param poseIds Person IDs (#people) or empty.
+         * @param frameNumber Frame number, it must increase over the calls.
+         * @param viewIndex Camera index for multi-view inputs (i.e., the Datum index inside TDatums).
+         */
+        void filter(Array<float>& keypoints, const Array<long long>& poseIds, const unsigned long long frameNumber,
+                    const unsigned int viewIndex = 0u);
+
+    private:
+        // State of all the people of a view, stored as flat arrays (one slot per person) so the keypoints of each
+        // person are processed over contiguous memory
+        struct ViewState
+        {
+            int numberBodyParts = 0;
+            std::unordered_map<long long, unsigned int> slots; // Person ID -> slot
+            std::vector<unsigned int> freeSlots;
+            // #slots
+            std::vector<unsigned long long> lastFrameNumbers;
+            // #slots x #body parts x 2 (x,y)
+            std::vector<float> positions;
+            std::vector<float> derivatives;
+            // #slots x #body parts
+            std::vector<float> scores;
+            std::vector<unsigned long long> lastDetectionFrameNumbers;
+        };
+
+        const float mFps;
+        const float mMinCutoff;
+        const float mBeta;
+        const float mDerivativeCutoff;
+        const unsigned long long mMaxGapFrames;
+        const unsigned long long mNumberFramesToDeletePerson;
+        std::vector<ViewState> mViewStates; // One per view
+        unsigned long long mLastEvictionFrameNumber;
+
+        unsigned int getSlot(ViewState& viewState, const long long personId);
+
+        DELETE_COPY(KeypointFilter);
+    };
+}
+
+#endif // OPENPOSE_CORE_KEYPOINT_FILTER_HPP
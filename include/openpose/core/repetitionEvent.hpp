@@ -0,0 +1,33 @@
+#ifndef OPENPOSE_CORE_REPETITION_EVENT_HPP
+#define OPENPOSE_CORE_REPETITION_EVENT_HPP
+
+#include <vector>
+
+namespace op
+{
+    /**
+     * RepetitionEvent: An exercise repetition completed by a person on a given frame (see ExerciseCounter).
+     */
+    struct RepetitionEvent
+    {
+        long long personId; /**< Person ID (Datum::poseIds, or person index if poseIds is empty). */
+
+        unsigned int exercise; /**< Exercise index, as in ExerciseCounter::getExerciseNames(). */
+
+        int repetition; /**< Repetition count of that person and exercise, including this one. */
+
+        /**
+         * Number of frames until each phase of the repetition was matched (#phases), measured from the previous phase
+         * match (or, for the first phase, from the end of the previous repetition or from the first detection of the
+         * person).
+         */
+        std::vector<unsigned long long> phaseDurations;
+
+        /**
+         * Minimum (over the phases) of the mean keypoint score of the person on the frame each phase was matched.
+         */
+        float confidence;
+    };
+}
+
+#endif // OPENPOSE_CORE_REPETITION_EVENT_HPP
@@ -54,11 +54,10 @@ namespace op
                 dLog("", Priority::Low, __LINE__, __FUNCTION__, __FILE__);
                 // Profiling speed
                 const auto profilerKey = Profiler::timerInit(__LINE__, __FUNCTION__, __FILE__);
-                // cv::Mat -> float*
+                // cv::Mat -> float* (in place, so recycled Datums re-use their memory)
                 for (auto& tDatum : *tDatums)
-                    tDatum.inputNetData = spCvMatToOpInput->createArray(tDatum.cvInputData,
-                                                                        tDatum.scaleInputToNetInputs,
-                                                                        tDatum.netInputSizes);
+                    spCvMatToOpInput->createArray(tDatum.inputNetData, tDatum.cvInputData,
+                                                  tDatum.scaleInputToNetInputs, tDatum.netInputSizes);
                 // Profiling speed
                 Profiler::timerEnd(profilerKey);
                 Profiler::printAveragedTimeMsOnIterationX(profilerKey, __LINE__, __FUNCTION__, __FILE__);
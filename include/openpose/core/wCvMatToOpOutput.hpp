@@ -57,10 +57,10 @@ namespace op
                 auto& tDatumsNoPtr = *tDatums;
                 // Profiling speed
                 const auto profilerKey = Profiler::timerInit(__LINE__, __FUNCTION__, __FILE__);
-                // cv::Mat -> float*
+                // cv::Mat -> float* (in place, so recycled Datums re-use their memory)
                 for (auto& tDatum : tDatumsNoPtr)
-                    tDatum.outputData = spCvMatToOpOutput->createArray(tDatum.cvInputData, tDatum.scaleInputToOutput,
-                                                                       tDatum.netOutputSize);
+                    spCvMatToOpOutput->createArray(tDatum.outputData, tDatum.cvInputData, tDatum.scaleInputToOutput,
+                                                   tDatum.netOutputSize);
                 // Profiling speed
                 Profiler::timerEnd(profilerKey);
                 Profiler::printAveragedTimeMsOnIterationX(profilerKey, __LINE__, __FUNCTION__, __FILE__);
@@ -0,0 +1,82 @@
+#ifndef OPENPOSE_CORE_W_KEYPOINT_FILTER_HPP
+#define OPENPOSE_CORE_W_KEYPOINT_FILTER_HPP
+
+#include <openpose/core/common.hpp>
+#include <openpose/core/keypointFilter.hpp>
+#include <openpose/thread/worker.hpp>
+
+namespace op
+{
+    template<typename TDatums>
+    class WKeypointFilter : public Worker<TDatums>
+    {
+    public:
+        explicit WKeypointFilter(const std::shared_ptr<KeypointFilter>& keypointFilter);
+
+        void initializationOnThread();
+
+        void work(TDatums& tDatums);
+
+    private:
+        std::shared_ptr<KeypointFilter> spKeypointFilter;
+
+        DELETE_COPY(WKeypointFilter);
+    };
+}
+
+
+
+
+
+// Implementation
+#include <openpose/utilities/pointerContainer.hpp>
+namespace op
+{
+    template<typename TDatums>
+    WKeypointFilter<TDatums>::WKeypointFilter(const std::shared_ptr<KeypointFilter>& keypointFilter) :
+        spKeypointFilter{keypointFilter}
+    {
+    }
+
+    template<typename TDatums>
+    void WKeypointFilter<TDatums>::initializationOnThread()
+    {
+    }
+
+    template<typename TDatums>
+    void WKeypointFilter<TDatums>::work(TDatums& tDatums)
+    {
+        try
+        {
+            if (checkNoNullNorEmpty(tDatums))
+            {
+                // Debugging log
+                dLog("", Priority::Low, __LINE__, __FUNCTION__, __FILE__);
+                // Profiling speed
+                const auto profilerKey = Profiler::timerInit(__LINE__, __FUNCTION__, __FILE__);
+                // Smooth and fill gaps of the body keypoints (the datum ID is used rather than the frame number
+                // because it is monotonic)
+                for (auto i = 0u ; i < tDatums->size() ; i++)
+                {
+                    auto& tDatum = (*tDatums)[i];
+                    spKeypointFilter->filter(tDatum.poseKeypoints, tDatum.poseIds, tDatum.id, i);
+                }
+                // Profiling speed
+                Profiler::timerEnd(profilerKey);
+                Profiler::printAveragedTimeMsOnIterationX(profilerKey, __LINE__, __FUNCTION__, __FILE__);
+                // Debugging log
+                dLog("", Priority::Low, __LINE__, __FUNCTION__, __FILE__);
+            }
+        }
+        catch (const std::exception& e)
+        {
+            this->stop();
+            tDatums = nullptr;
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    COMPILE_TEMPLATE_DATUM(WKeypointFilter);
+}
+
+#endif // OPENPOSE_CORE_W_KEYPOINT_FILTER_HPP
@@ -0,0 +1,95 @@
+#ifndef OPENPOSE_EXERCISE_EXERCISE_COUNTER_HPP
+#define OPENPOSE_EXERCISE_EXERCISE_COUNTER_HPP
+
+#include <openpose/core/common.hpp>
+#include <openpose/exercise/exerciseRules.hpp>
+#include <openpose/pose/enumClasses.hpp>
+
+namespace op
+{
+    /**
+     * ExerciseCounter: It counts the repetitions of each exercise (e.g., jumping jacks or squats) of each person
+     * across frames. The exercises are loaded from a catalogue file (see ExerciseRules). A repetition is counted
+     * each time a person goes through all the phases of an exercise in order.
+     * The per-person state is keyed by the person ID (Datum::poseIds, see PersonIdExtractor), so the number of
+     * people is not limited and the counts are kept even if people cross paths. If poseIds is empty (i.e.,
+     * identification disabled), the person index inside poseKeypoints is used as ID.
+     * The state is kept in a flat open-addressing hash table (linear probing), so the cost per frame is
+     * O(#people). People not seen during numberFramesToDeletePerson frames are evicted.
+     */
+    class OP_API ExerciseCounter
+    {
+    public:
+        /**
+         * Constructor.
+         * @param poseModel Pose model of the keypoints.
+         * @param exerciseFilePath Path to the exercise catalogue file (e.g., `models/exercise/exercises.txt`).
+         * @param exerciseNames Subset of exercises to be counted. If empty, all of them are counted.
+         * @param numberFramesToDeletePerson Number of frames without detecting a person before removing its state.
+         */
+        ExerciseCounter(const PoseModel poseModel, const std::string& exerciseFilePath,
+                        const std::vector<std::string>& exerciseNames = {},
+                        const int numberFramesToDeletePerson = 30);
+
+        /**
+         * It updates the state of each person and returns the current number of repetitions of each one.
+         * @param poseKeypoints Body keypoints (#people x #body parts x 3).
+         * @param poseIds Person IDs (#people) or empty.
+         * @param frameNumber Frame number, used to evict people that are no longer detected.
+         * @return Array<int> with the number of repetitions of each person and exercise (#people x #exercises,
+         * exercises sorted as in getExerciseNames()).
+         */
+        Array<int> count(const Array<float>& poseKeypoints, const Array<long long>& poseIds,
+                         const unsigned long long frameNumber);
+
+        /**
+         * Repetitions completed during the last count() call (usually empty).
+         */
+        const std::vector<RepetitionEvent>& getRepetitionEvents() const;
+
+        const std::vector<std::string>& getExerciseNames() const;
+
+        unsigned int getNumberTrackedPeople() const;
+
+    private:
+        struct PersonState
+        {
+            long long personId; // -1 if empty slot
+            unsigned long long lastFrameNumber;
+        };
+
+        const unsigned long long mNumberFramesToDeletePerson;
+        ExerciseRules mExerciseRules;
+        const unsigned int mNumberExercises;
+        const unsigned int mNumberPhases;
+        std::vector<unsigned char> mPhaseMatches;
+        std::vector<RepetitionEvent> mRepetitionEvents;
+        // Open-addressing table (capacity is always a power of 2). The repetition count, next phase and frame number
+        // of the last phase match of each exercise of the person in slot i are in [i*#exercises, (i+1)*#exercises),
+        // and the duration and score of each phase of the current repetition in [i*#phases, (i+1)*#phases)
+        std::vector<PersonState> mPersonStates;
+        std::vector<int> mCounts;
+        std::vector<unsigned int> mNextPhases;
+        std::vector<unsigned long long> mLastPhaseFrameNumbers;
+        std::vector<unsigned long long> mPhaseDurations;
+        std::vector<float> mPhaseScores;
+        std::vector<PersonState> mPersonStatesAux;
+        std::vector<int> mCountsAux;
+        std::vector<unsigned int> mNextPhasesAux;
+        std::vector<unsigned long long> mLastPhaseFrameNumbersAux;
+        std::vector<unsigned long long> mPhaseDurationsAux;
+        std::vector<float> mPhaseScoresAux;
+        unsigned int mNumberTrackedPeople;
+        unsigned long long mLastEvictionFrameNumber;
+
+        std::size_t findOrInsert(const long long personId, const unsigned long long frameNumber);
+
+        void evictStalePeople(const unsigned long long frameNumber);
+
+        void rehash(const std::size_t capacity, const unsigned long long frameNumber);
+
+        DELETE_COPY(ExerciseCounter);
+    };
+}
+
+#endif // OPENPOSE_EXERCISE_EXERCISE_COUNTER_HPP
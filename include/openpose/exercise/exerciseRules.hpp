@@ -0,0 +1,109 @@
+#ifndef OPENPOSE_EXERCISE_EXERCISE_RULES_HPP
+#define OPENPOSE_EXERCISE_EXERCISE_RULES_HPP
+
+#include <openpose/core/common.hpp>
+#include <openpose/pose/enumClasses.hpp>
+
+namespace op
+{
+    /**
+     * ExerciseRules: It loads a catalogue of exercises from a text file (e.g., `models/exercise/exercises.txt`) and
+     * lowers it into a flat instruction table, so new exercises do not require recompiling OpenPose.
+     * Each exercise is a sequence of phases (e.g., `up` and `down`), and each phase is the conjunction of conditions
+     * on features derived from the keypoints:
+     *     - Features: `x A`, `y A`, `dx A B` (|xA-xB|), `dy A B` (|yA-yB|) and `distance A B`, where A and B are body
+     *       part names (e.g., `LWrist`). Alternatives for different models can be given with `|` (e.g., `Nose|Head`).
+     *     - Conditions: `feature op [scale] [feature]`, with op one of `<`, `<=`, `>` or `>=`. E.g.,
+     *       `dx LWrist RWrist <= 2 dx LShoulder RShoulder` or `y LWrist < y Nose|Head`.
+     * Identical features and conditions are shared among exercises, and each of them is evaluated at once for all
+     * the people in the frame (structure-of-arrays layout), so the cost per frame does not depend on the number of
+     * branches of the original if-else chains. Features involving a non-detected keypoint are NaN, so any condition
+     * using them is false.
+     */
+    class OP_API ExerciseRules
+    {
+    public:
+        /**
+         * Constructor.
+         * @param poseModel Pose model used to map the body part names into indexes.
+         * @param exerciseFilePath Path to the exercise catalogue file.
+         * @param exerciseNames Subset of exercises to be loaded. If empty, all of them are loaded.
+         */
+        ExerciseRules(const PoseModel poseModel, const std::string& exerciseFilePath,
+                      const std::vector<std::string>& exerciseNames = {});
+
+        /**
+         * It evaluates all the phases of all the exercises for all the people in poseKeypoints.
+         * @param phaseMatches Output, it will be resized to #phases x #people (SoA, i.e., the people of each phase
+         * are contiguous) and filled with 1 if the person matches that phase, 0 otherwise.
+         * @param poseKeypoints Body keypoints (#people x #body parts x 3).
+         */
+        void evaluate(std::vector<unsigned char>& phaseMatches, const Array<float>& poseKeypoints);
+
+        const std::vector<std::string>& getExerciseNames() const;
+
+        /**
+         * Phase index offsets of each exercise (#exercises + 1 elements), i.e., the phases of the exercise e are
+         * [offsets[e], offsets[e+1]).
+         */
+        const std::vector<unsigned int>& getPhaseOffsets() const;
+
+    private:
+        enum class FeatureType : unsigned char
+        {
+            X,
+            Y,
+            DistanceX,
+            DistanceY,
+            Distance,
+        };
+        enum class Comparison : unsigned char
+        {
+            Less,
+            LessEqual,
+            Greater,
+            GreaterEqual,
+        };
+        struct Feature
+        {
+            FeatureType type;
+            unsigned int bodyPartA;
+            unsigned int bodyPartB;
+        };
+        struct Condition
+        {
+            unsigned int feature;
+            Comparison comparison;
+            float scale;
+            int rhsFeature; // -1 if the right hand side is the constant `scale`
+        };
+
+        const PoseModel mPoseModel;
+        std::vector<std::string> mExerciseNames;
+        std::vector<unsigned int> mPhaseOffsets;
+        // Instruction table
+        std::vector<Feature> mFeatures;
+        std::vector<Condition> mConditions;
+        std::vector<unsigned int> mPhaseConditions;
+        std::vector<unsigned int> mPhaseConditionOffsets;
+        std::vector<unsigned int> mBodyParts;
+        // Buffers (SoA)
+        std::vector<float> mBodyPartXs;
+        std::vector<float> mBodyPartYs;
+        std::vector<float> mFeatureValues;
+        std::vector<unsigned char> mConditionMatches;
+
+        void parse(const std::string& exerciseFilePath, const std::vector<std::string>& exerciseNames);
+
+        unsigned int addFeature(const std::vector<std::string>& tokens, std::size_t& tokenIndex,
+                                const std::string& errorPrefix);
+
+        unsigned int addCondition(const Condition& condition);
+
+        unsigned int getBodyPartIndex(const std::string& bodyPartNames);
+
+        DELETE_COPY(ExerciseRules);
+    };
+}
+
+#endif // OPENPOSE_EXERCISE_EXERCISE_RULES_HPP
@@ -0,0 +1,9 @@
+#ifndef OPENPOSE_EXERCISE_HEADERS_HPP
+#define OPENPOSE_EXERCISE_HEADERS_HPP
+
+// exercise module
+#include <openpose/exercise/exerciseCounter.hpp>
+#include <openpose/exercise/exerciseRules.hpp>
+#include <openpose/exercise/wExerciseCounter.hpp>
+
+#endif // OPENPOSE_EXERCISE_HEADERS_HPP
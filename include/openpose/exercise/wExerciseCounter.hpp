@@ -0,0 +1,82 @@
+#ifndef OPENPOSE_EXERCISE_W_EXERCISE_COUNTER_HPP
+#define OPENPOSE_EXERCISE_W_EXERCISE_COUNTER_HPP
+
+#include <openpose/core/common.hpp>
+#include <openpose/exercise/exerciseCounter.hpp>
+#include <openpose/thread/worker.hpp>
+
+namespace op
+{
+    template<typename TDatums>
+    class WExerciseCounter : public Worker<TDatums>
+    {
+    public:
+        explicit WExerciseCounter(const std::shared_ptr<ExerciseCounter>& exerciseCounter);
+
+        void initializationOnThread();
+
+        void work(TDatums& tDatums);
+
+    private:
+        std::shared_ptr<ExerciseCounter> spExerciseCounter;
+
+        DELETE_COPY(WExerciseCounter);
+    };
+}
+
+
+
+
+
+// Implementation
+#include <openpose/utilities/pointerContainer.hpp>
+namespace op
+{
+    template<typename TDatums>
+    WExerciseCounter<TDatums>::WExerciseCounter(const std::shared_ptr<ExerciseCounter>& exerciseCounter) :
+        spExerciseCounter{exerciseCounter}
+    {
+    }
+
+    template<typename TDatums>
+    void WExerciseCounter<TDatums>::initializationOnThread()
+    {
+    }
+
+    template<typename TDatums>
+    void WExerciseCounter<TDatums>::work(TDatums& tDatums)
+    {
+        try
+        {
+            if (checkNoNullNorEmpty(tDatums))
+            {
+                // Debugging log
+                dLog("", Priority::Low, __LINE__, __FUNCTION__, __FILE__);
+                // Profiling speed
+                const auto profilerKey = Profiler::timerInit(__LINE__, __FUNCTION__, __FILE__);
+                // Count repetitions (the datum ID is used rather than the frame number because it is monotonic)
+                for (auto& tDatum : *tDatums)
+                {
+                    tDatum.repetitionCounts = spExerciseCounter->count(tDatum.poseKeypoints, tDatum.poseIds,
+                                                                       tDatum.id);
+                    tDatum.repetitionEvents = spExerciseCounter->getRepetitionEvents();
+                }
+                // Profiling speed
+                Profiler::timerEnd(profilerKey);
+                Profiler::printAveragedTimeMsOnIterationX(profilerKey, __LINE__, __FUNCTION__, __FILE__);
+                // Debugging log
+                dLog("", Priority::Low, __LINE__, __FUNCTION__, __FILE__);
+            }
+        }
+        catch (const std::exception& e)
+        {
+            this->stop();
+            tDatums = nullptr;
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    COMPILE_TEMPLATE_DATUM(WExerciseCounter);
+}
+
+#endif // OPENPOSE_EXERCISE_W_EXERCISE_COUNTER_HPP
@@ -10,6 +10,12 @@ namespace op
         Yaml,
         Yml,
     };
+
+    enum class RepEventFormat : unsigned char
+    {
+        JsonLines,
+        Binary,
+    };
 }
 
 #endif // OPENPOSE_FILESTREAM_ENUM_CLASSES_HPP
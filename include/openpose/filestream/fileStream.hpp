@@ -48,6 +48,12 @@ namespace op
                                const std::vector<std::vector<std::array<float,3>>>& candidates,
                                const std::string& fileName, const bool humanReadable);
 
+    // Load the keypoints saved by savePeopleJson (e.g., keypointName = "pose_keypoints_2d"). It does not use
+    // cv::FileStorage, so it also works for OpenCV < 3.0 and it is thread-safe.
+    // Size: #people x #keypoints x 3 (or empty if no people)
+    OP_API Array<float> loadPeopleJson(const std::string& fileName,
+                                       const std::string& keypointName = "pose_keypoints_2d");
+
     // Save/load image
     OP_API void saveImage(const cv::Mat& cvMat, const std::string& fullFilePath,
                           const std::vector<int>& openCvCompressionParams
@@ -9,16 +9,20 @@
 #include <openpose/filestream/heatMapSaver.hpp>
 #include <openpose/filestream/imageSaver.hpp>
 #include <openpose/filestream/jsonOfstream.hpp>
+#include <openpose/filestream/keypointLoader.hpp>
 #include <openpose/filestream/keypointSaver.hpp>
 #include <openpose/filestream/peopleJsonSaver.hpp>
+#include <openpose/filestream/repEventSaver.hpp>
 #include <openpose/filestream/videoSaver.hpp>
 #include <openpose/filestream/wCocoJsonSaver.hpp>
 #include <openpose/filestream/wFaceSaver.hpp>
 #include <openpose/filestream/wHandSaver.hpp>
 #include <openpose/filestream/wImageSaver.hpp>
+#include <openpose/filestream/wKeypointLoader.hpp>
 #include <openpose/filestream/wHeatMapSaver.hpp>
 #include <openpose/filestream/wPeopleJsonSaver.hpp>
 #include <openpose/filestream/wPoseSaver.hpp>
+#include <openpose/filestream/wRepEventSaver.hpp>
 #include <openpose/filestream/wVideoSaver.hpp>
 
 #endif // OPENPOSE_FILESTREAM_HEADERS_HPP
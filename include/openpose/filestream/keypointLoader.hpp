@@ -0,0 +1,48 @@
+#ifndef OPENPOSE_FILESTREAM_KEYPOINT_LOADER_HPP
+#define OPENPOSE_FILESTREAM_KEYPOINT_LOADER_HPP
+
+#include <openpose/core/common.hpp>
+
+namespace op
+{
+    /**
+     * KeypointLoader: It reads back the body keypoints saved on disk by PeopleJsonSaver (`write_json` flag,
+     * `*_keypoints.json` files) or KeypointSaver (`write_keypoint` flag, `*_pose.{json,xml,yaml,yml}` files), so
+     * they can be re-processed (e.g., by the exercise counters) without running the network nor decoding any image.
+     * Files are read in batches, and each batch is parsed in parallel with numberThreads threads.
+     */
+    class OP_API KeypointLoader
+    {
+    public:
+        /**
+         * Constructor.
+         * @param directoryPath Directory with the keypoint files (1 file per frame, sorted by name).
+         * @param numberThreads Number of parsing threads. If <= 0, it uses all the available CPU cores.
+         * @param batchSize Number of files read on each loadNextBatch() call.
+         */
+        explicit KeypointLoader(const std::string& directoryPath, const int numberThreads = -1,
+                                const unsigned int batchSize = 256u);
+
+        /**
+         * It loads the next batch of frames.
+         * @param frameNames It will be filled with the name of each frame (file name without the `_keypoints` or
+         * `_pose` suffix), analogous to Datum::name.
+         * @return std::vector<Array<float>> with the body keypoints of each frame. Empty if all the files were read.
+         */
+        std::vector<Array<float>> loadNextBatch(std::vector<std::string>& frameNames);
+
+        bool isFinished() const;
+
+        unsigned long long getNumberFrames() const;
+
+    private:
+        const unsigned int mNumberThreads;
+        const unsigned int mBatchSize;
+        const std::vector<std::string> mFilePaths;
+        unsigned long long mNextFileIndex;
+
+        DELETE_COPY(KeypointLoader);
+    };
+}
+
+#endif // OPENPOSE_FILESTREAM_KEYPOINT_LOADER_HPP
@@ -0,0 +1,69 @@
+#ifndef OPENPOSE_FILESTREAM_REP_EVENT_SAVER_HPP
+#define OPENPOSE_FILESTREAM_REP_EVENT_SAVER_HPP
+
+#include <chrono>
+#include <fstream> // std::ofstream
+#include <openpose/core/common.hpp>
+#include <openpose/filestream/enumClasses.hpp>
+
+namespace op
+{
+    /**
+     * RepEventSaver: It appends the exercise repetitions (Datum::repetitionEvents) to a file, one record per
+     * repetition, so they can be analyzed without decoding the rendered video. Records are only written when a
+     * repetition is completed, and the file is flushed every flushPeriodSeconds, so it can run at full frame rate.
+     * Formats:
+     *     - RepEventFormat::JsonLines: One JSON object per line, e.g.:
+     *       {"person_id":3,"exercise":"squat","repetition":12,"frame":1234,"time":41.13,
+     *        "timestamp":1514764800123,"phase_durations":[0.8,0.9],"confidence":0.62}
+     *       time and phase_durations in seconds (from the frame numbers and fps), timestamp in Unix milliseconds.
+     *     - RepEventFormat::Binary: Native-endian header, written only if the file is empty: char[4] "OPRE",
+     *       uint32 version (1), float64 fps, uint32 #exercises, and (uint32 length, chars) for each exercise name.
+     *       Then, one record per repetition: int64 person_id, uint64 frame, int64 timestamp, uint32 exercise,
+     *       int32 repetition, float32 confidence, uint32 #phases, and uint32 phase_durations[#phases] (in frames).
+     */
+    class OP_API RepEventSaver
+    {
+    public:
+        /**
+         * Constructor.
+         * @param filePath File to which the events are appended (it is created if it does not exist).
+         * @param exerciseNames Names of the exercises (see ExerciseCounter::getExerciseNames()).
+         * @param fps Frame rate of the input, used to convert frame numbers into time.
+         * @param repEventFormat File format.
+         * @param flushPeriodSeconds Maximum time that written events can remain in the output buffer.
+         */
+        RepEventSaver(const std::string& filePath, const std::vector<std::string>& exerciseNames, const double fps,
+                      const RepEventFormat repEventFormat = RepEventFormat::JsonLines,
+                      const double flushPeriodSeconds = 1.);
+
+        ~RepEventSaver();
+
+        /**
+         * It writes the repetition events of one frame. It should be called on every frame (even if
+         * repetitionEvents is empty) so the output is periodically flushed.
+         */
+        void save(const std::vector<RepetitionEvent>& repetitionEvents, const unsigned long long frameNumber);
+
+        void flush();
+
+    private:
+        const std::vector<std::string> mExerciseNames;
+        const double mFps;
+        const RepEventFormat mRepEventFormat;
+        const std::chrono::nanoseconds mFlushPeriod;
+        std::ofstream mOfstream;
+        std::chrono::steady_clock::time_point mLastFlush;
+        bool mPendingFlush;
+
+        void saveJsonLine(const RepetitionEvent& repetitionEvent, const unsigned long long frameNumber,
+                          const long long timestamp);
+
+        void saveBinary(const RepetitionEvent& repetitionEvent, const unsigned long long frameNumber,
+                        const long long timestamp);
+
+        DELETE_COPY(RepEventSaver);
+    };
+}
+
+#endif // OPENPOSE_FILESTREAM_REP_EVENT_SAVER_HPP
@@ -1,6 +1,12 @@
 #ifndef OPENPOSE_FILESTREAM_VIDEO_SAVER_HPP
 #define OPENPOSE_FILESTREAM_VIDEO_SAVER_HPP
 
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception> // std::exception_ptr
+#include <mutex>
+#include <thread>
 #include <opencv2/core/core.hpp> // cv::Mat
 #include <opencv2/highgui/highgui.hpp> // cv::VideoWriter
 #include <openpose/core/common.hpp>
@@ -10,7 +16,22 @@ namespace op
     class OP_API VideoSaver
     {
     public:
-        VideoSaver(const std::string& videoSaverPath, const int cvFourcc, const double fps, const Point<int>& cvSize);
+        /**
+         * Constructor.
+         * @param asyncQueueSize If 0 (default), each frame is encoded inside write(). Otherwise, frames are encoded
+         * on a dedicated thread, and write() only pushes them into a queue of at most asyncQueueSize frames, so slow
+         * encoders (e.g., H.264) do not stall the caller.
+         * @param dropFramesIfFull Only if asyncQueueSize > 0. If the queue is full, whether to drop the new frame
+         * (the video loses frames but write() never blocks) or to wait until there is space (default, no frame is
+         * lost).
+         */
+        VideoSaver(const std::string& videoSaverPath, const int cvFourcc, const double fps, const Point<int>& cvSize,
+                   const unsigned int asyncQueueSize = 0u, const bool dropFramesIfFull = false);
+
+        /**
+         * It encodes the remaining queued frames (if asynchronous) before closing the video.
+         */
+        ~VideoSaver();
 
         bool isOpened();
 
@@ -18,13 +39,33 @@ namespace op
 
         void write(const std::vector<cv::Mat>& cvMats);
 
+        /**
+         * Number of frames dropped because the asynchronous queue was full.
+         */
+        unsigned long long getNumberDroppedFrames() const;
+
     private:
         const std::string mVideoSaverPath;
         const int mCvFourcc;
         const double mFps;
         const Point<int> mCvSize;
-        cv::VideoWriter mVideoWriter;
+        cv::VideoWriter mVideoWriter; // Only accessed by the encoding thread (if asynchronous)
+        std::atomic<bool> mIsOpened; // mVideoWriter.isOpened(), readable from any thread
         unsigned int mNumberImages;
+        // Asynchronous encoding
+        const unsigned int mAsyncQueueSize;
+        const bool mDropFramesIfFull;
+        std::deque<std::pair<cv::Mat, unsigned int>> mQueue; // Concatenated frame and number of images
+        std::mutex mQueueMutex;
+        std::condition_variable mQueueConditionVariable;
+        bool mCloseThread;
+        std::thread mThread;
+        std::exception_ptr mThreadException;
+        std::atomic<unsigned long long> mNumberDroppedFrames;
+
+        void encode(const cv::Mat& cvOutputData, const unsigned int numberImages);
+
+        void encodingThread();
 
         DELETE_COPY(VideoSaver);
     };
@@ -0,0 +1,106 @@
+#ifndef OPENPOSE_FILESTREAM_W_KEYPOINT_LOADER_HPP
+#define OPENPOSE_FILESTREAM_W_KEYPOINT_LOADER_HPP
+
+#include <deque>
+#include <openpose/core/common.hpp>
+#include <openpose/filestream/keypointLoader.hpp>
+#include <openpose/thread/workerProducer.hpp>
+
+namespace op
+{
+    /**
+     * WKeypointLoader: Replay producer. It generates 1 TDatums per frame with only the frame name, frame number and
+     * Datum::poseKeypoints filled (i.e., no image), so the following workers (e.g., WExerciseCounter) can be
+     * re-run over previously saved keypoints without the network.
+     */
+    template<typename TDatums>
+    class WKeypointLoader : public WorkerProducer<TDatums>
+    {
+    public:
+        explicit WKeypointLoader(const std::shared_ptr<KeypointLoader>& keypointLoader);
+
+        void initializationOnThread();
+
+        TDatums workProducer();
+
+    private:
+        std::shared_ptr<KeypointLoader> spKeypointLoader;
+        std::deque<std::pair<std::string, Array<float>>> mLoadedFrames;
+        unsigned long long mFrameNumber;
+
+        DELETE_COPY(WKeypointLoader);
+    };
+}
+
+
+
+
+
+// Implementation
+namespace op
+{
+    template<typename TDatums>
+    WKeypointLoader<TDatums>::WKeypointLoader(const std::shared_ptr<KeypointLoader>& keypointLoader) :
+        spKeypointLoader{keypointLoader},
+        mFrameNumber{0ull}
+    {
+    }
+
+    template<typename TDatums>
+    void WKeypointLoader<TDatums>::initializationOnThread()
+    {
+    }
+
+    template<typename TDatums>
+    TDatums WKeypointLoader<TDatums>::workProducer()
+    {
+        try
+        {
+            // Debugging log
+            dLog("", Priority::Low, __LINE__, __FUNCTION__, __FILE__);
+            // Profiling speed
+            const auto profilerKey = Profiler::timerInit(__LINE__, __FUNCTION__, __FILE__);
+            // Load next batch of files (parsed in parallel)
+            if (mLoadedFrames.empty() && !spKeypointLoader->isFinished())
+            {
+                std::vector<std::string> frameNames;
+                auto poseKeypoints = spKeypointLoader->loadNextBatch(frameNames);
+                for (auto i = 0u ; i < poseKeypoints.size() ; i++)
+                    mLoadedFrames.emplace_back(std::make_pair(frameNames[i], std::move(poseKeypoints[i])));
+            }
+            // Create and fill TDatums
+            TDatums tDatums;
+            if (!mLoadedFrames.empty())
+            {
+                tDatums = std::make_shared<typename TDatums::element_type>(1);
+                auto& tDatum = tDatums->at(0);
+                // The ID is set as well in case no WIdGenerator is used
+                tDatum.id = mFrameNumber;
+                tDatum.frameNumber = mFrameNumber++;
+                tDatum.name = std::move(mLoadedFrames.front().first);
+                tDatum.poseKeypoints = std::move(mLoadedFrames.front().second);
+                mLoadedFrames.pop_front();
+            }
+            // Stop Worker if all frames were read
+            else
+                this->stop();
+            // Profiling speed
+            Profiler::timerEnd(profilerKey);
+            Profiler::printAveragedTimeMsOnIterationX(profilerKey, __LINE__, __FUNCTION__, __FILE__);
+            // Debugging log
+            dLog("", Priority::Low, __LINE__, __FUNCTION__, __FILE__);
+            // Return TDatums
+            return tDatums;
+        }
+        catch (const std::exception& e)
+        {
+            this->stop();
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return TDatums{};
+        }
+    }
+
+    COMPILE_TEMPLATE_DATUM(WKeypointLoader);
+}
+
+#endif // OPENPOSE_FILESTREAM_W_KEYPOINT_LOADER_HPP
@@ -0,0 +1,77 @@
+#ifndef OPENPOSE_FILESTREAM_W_REP_EVENT_SAVER_HPP
+#define OPENPOSE_FILESTREAM_W_REP_EVENT_SAVER_HPP
+
+#include <openpose/core/common.hpp>
+#include <openpose/filestream/repEventSaver.hpp>
+#include <openpose/thread/workerConsumer.hpp>
+
+namespace op
+{
+    template<typename TDatums>
+    class WRepEventSaver : public WorkerConsumer<TDatums>
+    {
+    public:
+        explicit WRepEventSaver(const std::shared_ptr<RepEventSaver>& repEventSaver);
+
+        void initializationOnThread();
+
+        void workConsumer(const TDatums& tDatums);
+
+    private:
+        const std::shared_ptr<RepEventSaver> spRepEventSaver;
+
+        DELETE_COPY(WRepEventSaver);
+    };
+}
+
+
+
+
+
+// Implementation
+#include <openpose/utilities/pointerContainer.hpp>
+namespace op
+{
+    template<typename TDatums>
+    WRepEventSaver<TDatums>::WRepEventSaver(const std::shared_ptr<RepEventSaver>& repEventSaver) :
+        spRepEventSaver{repEventSaver}
+    {
+    }
+
+    template<typename TDatums>
+    void WRepEventSaver<TDatums>::initializationOnThread()
+    {
+    }
+
+    template<typename TDatums>
+    void WRepEventSaver<TDatums>::workConsumer(const TDatums& tDatums)
+    {
+        try
+        {
+            if (checkNoNullNorEmpty(tDatums))
+            {
+                // Debugging log
+                dLog("", Priority::Low, __LINE__, __FUNCTION__, __FILE__);
+                // Profiling speed
+                const auto profilerKey = Profiler::timerInit(__LINE__, __FUNCTION__, __FILE__);
+                // Save repetition events
+                for (const auto& tDatum : *tDatums)
+                    spRepEventSaver->save(tDatum.repetitionEvents, tDatum.frameNumber);
+                // Profiling speed
+                Profiler::timerEnd(profilerKey);
+                Profiler::printAveragedTimeMsOnIterationX(profilerKey, __LINE__, __FUNCTION__, __FILE__);
+                // Debugging log
+                dLog("", Priority::Low, __LINE__, __FUNCTION__, __FILE__);
+            }
+        }
+        catch (const std::exception& e)
+        {
+            this->stop();
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    COMPILE_TEMPLATE_DATUM(WRepEventSaver);
+}
+
+#endif // OPENPOSE_FILESTREAM_W_REP_EVENT_SAVER_HPP
@@ -7,6 +7,9 @@
 // core module
 #include <openpose/core/headers.hpp>
 
+// exercise module
+#include <openpose/exercise/headers.hpp>
+
 // experimental module
 #include <openpose/experimental/headers.hpp>
 
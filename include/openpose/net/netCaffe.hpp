@@ -9,8 +9,15 @@ namespace op
     class OP_API NetCaffe : public Net
     {
     public:
+        /**
+         * @param netCacheSize Number of net input sizes kept reshaped (least recently used one reshaped when a new
+         * size arrives). Each one is a Caffe net sharing the trained weights, so it only costs the memory of its
+         * intermediate blobs, and switching among them (e.g., images of different aspect ratio) does not reshape
+         * the net.
+         */
         NetCaffe(const std::string& caffeProto, const std::string& caffeTrainedModel, const int gpuId = 0,
-                 const bool enableGoogleLogging = true, const std::string& lastBlobName = "net_output");
+                 const bool enableGoogleLogging = true, const std::string& lastBlobName = "net_output",
+                 const int netCacheSize = 1);
 
         virtual ~NetCaffe();
 
@@ -18,6 +25,16 @@ namespace op
 
         void forwardPass(const Array<float>& inputNetData) const;
 
+        /**
+         * It prepares the net for the input size netInputSize4D (e.g., to pre-warm the cache before processing).
+         * forwardPass() calls it internally.
+         */
+        void reshape(const std::vector<int>& netInputSize4D);
+
+        /**
+         * Output blob of the net used by the last forwardPass() or reshape(). It changes with the input size if
+         * netCacheSize > 1.
+         */
         boost::shared_ptr<caffe::Blob<float>> getOutputBlob() const;
 
     private:
@@ -19,6 +19,19 @@ namespace op
     OP_API void nmsOcl(T* targetPtr, int* kernelPtr, const T* const sourcePtr, const T threshold,
                        const std::array<int, 4>& targetSize, const std::array<int, 4>& sourceSize,
                        const Point<T>& offset, const int gpuID = 0);
+
+    /**
+     * Coarse-to-fine alternative to resizeAndMergeCpu (1 scale) + nmsCpu. The peak candidates are found on the
+     * net-resolution maps (sourcePtr), and the upsampled (CV_INTER_CUBIC) values are only computed in small windows
+     * around them, where the nmsCpu peak rules and sub-pixel refinement are applied. The peaks are given in the
+     * upsampled coordinates, as with nmsCpu. It is an approximation: a peak of the upsampled map not close to any
+     * local maximum of the net-resolution map is not found.
+     * @param upsampledSize Size of the resizeAndMergeCpu output replaced by this function.
+     */
+    template <typename T>
+    OP_API void nmsCoarseToFineCpu(T* targetPtr, const T* const sourcePtr, const T threshold,
+                                   const std::array<int, 4>& targetSize, const std::array<int, 4>& sourceSize,
+                                   const Point<int>& upsampledSize, const Point<T>& offset);
 }
 
 #endif // OPENPOSE_NET_NMS_BASE_HPP
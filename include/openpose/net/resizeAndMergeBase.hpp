@@ -23,6 +23,17 @@ namespace op
                                   const std::vector<std::array<int, 4>>& sourceSizes,
                                   const std::vector<T>& scaleInputToNetInputs = {1.f},
                                   const int gpuID = 0);
+
+    /**
+     * It computes the region targetRegion of cv::resize(source, target, targetSize, 0, 0, CV_INTER_CUBIC), i.e., of
+     * the resizeAndMergeCpu output for 1 scale and 1 channel, without resizing the whole source.
+     * @param targetPtr Output, with targetRegion.area() elements (row-major).
+     * @param sourcePtr Source map, with sourceSize.area() elements.
+     * @param targetRegion Region of interest, it must be inside the targetSize image.
+     */
+    template <typename T>
+    OP_API void resizeCubicRegionCpu(T* targetPtr, const T* const sourcePtr, const Point<int>& sourceSize,
+                                     const Point<int>& targetSize, const Rectangle<int>& targetRegion);
 }
 
 #endif // OPENPOSE_NET_RESIZE_AND_MERGE_BASE_HPP
@@ -6,11 +6,17 @@
 
 namespace op
 {
+    /**
+     * @param upsampledHeatMapSize If not empty, heatMapPtr contains the net-resolution maps, while peaksPtr refers to
+     * their CV_INTER_CUBIC upsampling to upsampledHeatMapSize (see nmsCoarseToFineCpu). The PAF values are then
+     * interpolated from heatMapPtr at each sampled point.
+     */
     template <typename T>
     OP_API void connectBodyPartsCpu(Array<T>& poseKeypoints, Array<T>& poseScores, const T* const heatMapPtr,
                                     const T* const peaksPtr, const PoseModel poseModel, const Point<int>& heatMapSize,
                                     const int maxPeaks, const T interMinAboveThreshold, const T interThreshold,
-                                    const int minSubsetCnt, const T minSubsetScore, const T scaleFactor = 1.f);
+                                    const int minSubsetCnt, const T minSubsetScore, const T scaleFactor = 1.f,
+                                    const Point<int>& upsampledHeatMapSize = Point<int>{0, 0});
 
     template <typename T>
     OP_API void connectBodyPartsGpu(Array<T>& poseKeypoints, Array<T>& poseScores, const T* const heatMapPtr,
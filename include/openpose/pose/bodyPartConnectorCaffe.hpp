@@ -38,6 +38,12 @@ namespace op
 
         void setScaleNetToOutput(const T scaleNetToOutput);
 
+        /**
+         * Forward_cpu only. If not empty, bottom[0] contains the net-resolution maps and bottom[1] the peaks of their
+         * upsampling to this size (see connectBodyPartsCpu). Default: {0, 0} (bottom[0] already upsampled).
+         */
+        void setUpsampledHeatMapSize(const Point<int>& upsampledHeatMapSize);
+
         virtual void Forward_cpu(const std::vector<caffe::Blob<T>*>& bottom, Array<T>& poseKeypoints,
                                  Array<T>& poseScores);
 
@@ -57,6 +63,7 @@ namespace op
         int mMinSubsetCnt;
         T mMinSubsetScore;
         T mScaleNetToOutput;
+        Point<int> mUpsampledHeatMapSize;
         std::array<int, 4> mHeatMapsSize;
         std::array<int, 4> mPeaksSize;
         std::array<int, 4> mTopSize;
@@ -10,6 +10,7 @@
 #include <openpose/pose/poseExtractorCaffe.hpp>
 #include <openpose/pose/poseExtractorNet.hpp>
 #include <openpose/pose/poseGpuRenderer.hpp>
+#include <openpose/pose/poseNetScheduler.hpp>
 #include <openpose/pose/poseParameters.hpp>
 #include <openpose/pose/poseParametersRender.hpp>
 #include <openpose/pose/poseRenderer.hpp>
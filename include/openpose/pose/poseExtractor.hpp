@@ -6,6 +6,7 @@
 #include <openpose/core/keepTopNPeople.hpp>
 #include <openpose/pose/poseParameters.hpp>
 #include <openpose/pose/poseExtractorNet.hpp>
+#include <openpose/pose/poseNetScheduler.hpp>
 #include <openpose/experimental/tracking/personIdExtractor.hpp>
 #include <openpose/experimental/tracking/personTracker.hpp>
 
@@ -18,7 +19,8 @@ namespace op
                       const std::shared_ptr<KeepTopNPeople>& keepTopNPeople = nullptr,
                       const std::shared_ptr<PersonIdExtractor>& personIdExtractor = nullptr,
                       const std::shared_ptr<std::vector<std::shared_ptr<PersonTracker>>>& personTracker = {},
-                      const int numberPeopleMax = -1, const int tracking = -1);
+                      const int numberPeopleMax = -1, const int tracking = -1,
+                      const std::shared_ptr<PoseNetScheduler>& poseNetScheduler = nullptr);
 
         virtual ~PoseExtractor();
 
@@ -29,6 +31,17 @@ namespace op
                          const std::vector<double>& scaleRatios,
                          const long long frameId = -1ll);
 
+        /**
+         * Batched forwardPass (see PoseExtractorNet::forwardPassBatch). The frames on which the net is not run (see
+         * `tracking`) are not added to the net batch, and they are cleared by postProcessBatchFrame().
+         */
+        void forwardPassBatch(const std::vector<std::vector<Array<float>>>& inputNetData,
+                              const std::vector<Point<int>>& inputDataSizes,
+                              const std::vector<std::vector<double>>& scaleInputToNetInputs,
+                              const std::vector<long long>& frameIds);
+
+        void postProcessBatchFrame(const int frameIndex);
+
         // PoseExtractorNet functions
         Array<float> getHeatMapsCopy() const;
 
@@ -62,6 +75,11 @@ namespace op
                              const unsigned long long imageViewIndex,
                              const long long frameId);
 
+        // PoseNetScheduler functions
+        // Thread-safe
+        void updateNetScheduler(const Array<float>& poseKeypoints, const Array<long long>& poseIds,
+                                const long long frameId);
+
     private:
         const int mNumberPeopleMax;
         const int mTracking;
@@ -69,6 +87,11 @@ namespace op
         const std::shared_ptr<KeepTopNPeople> spKeepTopNPeople;
         const std::shared_ptr<PersonIdExtractor> spPersonIdExtractor;
         const std::shared_ptr<std::vector<std::shared_ptr<PersonTracker>>> spPersonTrackers;
+        const std::shared_ptr<PoseNetScheduler> spPoseNetScheduler;
+        // Index of each frame of the last forwardPassBatch() in the net batch (-1 if net not run)
+        std::vector<int> mBatchNetFrameIndexes;
+
+        bool runNet(const long long frameId) const;
 
         DELETE_COPY(PoseExtractor);
     };
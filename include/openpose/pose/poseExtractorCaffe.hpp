@@ -10,11 +10,27 @@ namespace op
     class OP_API PoseExtractorCaffe : public PoseExtractorNet
     {
     public:
+        /**
+         * @param nmsCoarseToFine CPU version only. If true, and if 1 scale is used and no heat maps are returned, the
+         * heat maps are not upsampled to the net input resolution. Instead, the NMS and body part connection are run
+         * on the net output, only upsampling it around each peak candidate and PAF sampled point (see
+         * nmsCoarseToFineCpu). Faster but approximated.
+         * @param netCacheSize Number of net input sizes kept reshaped (see NetCaffe), so alternating among them
+         * (e.g., image directories with different aspect ratios) does not reshape the net on each change.
+         * @param prewarmNetInputSizes Net input sizes (of the first scale) reshaped when the net is initialized,
+         * rather than on their first frame.
+         * @param prewarmBatchSize Batch size of the pre-warmed net input sizes (i.e., the netBatchSize of the
+         * WPoseExtractor), so the first batched forward pass does not reshape the net.
+         */
         PoseExtractorCaffe(const PoseModel poseModel, const std::string& modelFolder, const int gpuId,
                            const std::vector<HeatMapType>& heatMapTypes = {},
                            const ScaleMode heatMapScale = ScaleMode::ZeroToOne,
                            const bool addPartCandidates = false,
-                           const bool enableGoogleLogging = true);
+                           const bool enableGoogleLogging = true,
+                           const bool nmsCoarseToFine = false,
+                           const int netCacheSize = 1,
+                           const std::vector<Point<int>>& prewarmNetInputSizes = {},
+                           const int prewarmBatchSize = 1);
 
         virtual ~PoseExtractorCaffe();
 
@@ -23,6 +39,16 @@ namespace op
         void forwardPass(const std::vector<Array<float>>& inputNetData, const Point<int>& inputDataSize,
                          const std::vector<double>& scaleInputToNetInputs = {1.f});
 
+        /**
+         * Single N-batch net forward pass per scale (all frames must share the same net input sizes). The net
+         * output of each frame is then split into its own blobs by postProcessBatchFrame().
+         */
+        void forwardPassBatch(const std::vector<std::vector<Array<float>>>& inputNetData,
+                              const std::vector<Point<int>>& inputDataSizes,
+                              const std::vector<std::vector<double>>& scaleInputToNetInputs);
+
+        void postProcessBatchFrame(const int frameIndex);
+
         const float* getCandidatesCpuConstPtr() const;
 
         const float* getCandidatesGpuConstPtr() const;
@@ -41,6 +67,10 @@ namespace op
         struct ImplPoseExtractorCaffe;
         std::unique_ptr<ImplPoseExtractorCaffe> upImpl;
 
+        // Heat maps, NMS and body part connection of the current net output (or batch frame blobs)
+        void postProcess(const std::vector<Array<float>>& inputNetData, const Point<int>& inputDataSize,
+                         const std::vector<double>& scaleInputToNetInputs, const bool batchFrame);
+
         // PIMP requires DELETE_COPY & destructor, or extra code
         // http://oliora.github.io/2015/12/29/pimpl-and-rule-of-zero.html
         DELETE_COPY(PoseExtractorCaffe);
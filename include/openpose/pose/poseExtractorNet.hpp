@@ -24,6 +24,26 @@ namespace op
         virtual void forwardPass(const std::vector<Array<float>>& inputNetData, const Point<int>& inputDataSize,
                                  const std::vector<double>& scaleRatios = {1.f}) = 0;
 
+        /**
+         * Batched alternative to forwardPass (e.g., offline processing, where latency does not matter): the net is
+         * run once for all the frames, which must share the same net input sizes. Each frame is then
+         * post-processed with postProcessBatchFrame(), after which the getters return its results.
+         * By default (nets without batch support), the frames are kept and forwardPass is run on each one of them
+         * by postProcessBatchFrame().
+         * @param inputNetData Net input of each frame (see forwardPass).
+         * @param inputDataSizes Input image size of each frame.
+         * @param scaleInputToNetInputs Scale ratios of each frame.
+         */
+        virtual void forwardPassBatch(const std::vector<std::vector<Array<float>>>& inputNetData,
+                                      const std::vector<Point<int>>& inputDataSizes,
+                                      const std::vector<std::vector<double>>& scaleInputToNetInputs);
+
+        /**
+         * Post-processing (heat maps, NMS and body part connection) of the frame frameIndex of the last
+         * forwardPassBatch().
+         */
+        virtual void postProcessBatchFrame(const int frameIndex);
+
         virtual const float* getCandidatesCpuConstPtr() const = 0;
 
         virtual const float* getCandidatesGpuConstPtr() const = 0;
@@ -60,6 +80,10 @@ namespace op
         Array<float> mPoseKeypoints;
         Array<float> mPoseScores;
         float mScaleNetToOutput;
+        // Frames of the last forwardPassBatch()
+        std::vector<std::vector<Array<float>>> mBatchInputNetData;
+        std::vector<Point<int>> mBatchInputDataSizes;
+        std::vector<std::vector<double>> mBatchScaleInputToNetInputs;
 
         void checkThread() const;
 
@@ -0,0 +1,62 @@
+#ifndef OPENPOSE_POSE_POSE_NET_SCHEDULER_HPP
+#define OPENPOSE_POSE_POSE_NET_SCHEDULER_HPP
+
+#include <mutex>
+#include <openpose/core/common.hpp>
+
+namespace op
+{
+    /**
+     * PoseNetScheduler: Adaptive alternative to the fixed `--tracking` interval. It decides on which frames the pose
+     * network is run, while the remaining ones are filled by the PersonTracker (LK) predictions.
+     * The net is run more often while people are moving fast (e.g., between the up and down positions of an
+     * exercise), where the tracker drifts quickly, and less often in stable positions. I.e., the net is run when:
+     *     - The expected keypoint displacement since the last net frame (current keypoint speed x elapsed frames)
+     *       exceeds maxDisplacement (accuracy budget), or
+     *     - maxFramesWithoutNet frames have passed since the last net frame (latency budget, it also bounds the
+     *       delay to detect new people, which the tracker cannot find).
+     */
+    class OP_API PoseNetScheduler
+    {
+    public:
+        /**
+         * Constructor.
+         * @param maxFramesWithoutNet Maximum number of consecutive frames filled by the tracker.
+         * @param maxDisplacement Maximum keypoint displacement (in input image pixels) allowed since the last net
+         * frame.
+         */
+        PoseNetScheduler(const int maxFramesWithoutNet, const float maxDisplacement);
+
+        /**
+         * Whether the net must be run on the frame frameId. Calls with the same frameId (e.g., multi-view inputs)
+         * return the same result. Thread-safe.
+         */
+        bool runNet(const long long frameId);
+
+        /**
+         * It updates the keypoint speed estimation with the final (net or tracked) keypoints of frameId. Thread-safe.
+         * @param poseKeypoints Final keypoints of the frame.
+         * @param poseIds Person IDs, used to match people between frames. If empty, the person index is used.
+         * @param frameId Frame ID.
+         */
+        void update(const Array<float>& poseKeypoints, const Array<long long>& poseIds, const long long frameId);
+
+    private:
+        const long long mMaxFramesWithoutNet;
+        const float mMaxDisplacement;
+        std::mutex mMutex;
+        // Scheduling
+        long long mLastNetFrameId;
+        long long mLastDecisionFrameId;
+        bool mLastDecision;
+        // Speed estimation (pixels/frame, negative if unknown)
+        float mSpeed;
+        long long mLastUpdateFrameId;
+        Array<float> mLastPoseKeypoints;
+        Array<long long> mLastPoseIds;
+
+        DELETE_COPY(PoseNetScheduler);
+    };
+}
+
+#endif // OPENPOSE_POSE_POSE_NET_SCHEDULER_HPP
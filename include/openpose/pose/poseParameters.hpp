@@ -28,6 +28,53 @@ namespace op
     OP_API float getPoseDefaultConnectInterThreshold(const PoseModel poseModel);
     OP_API unsigned int getPoseDefaultMinSubsetCnt(const PoseModel poseModel);
     OP_API float getPoseDefaultConnectMinSubsetScore(const PoseModel poseModel);
+
+    // Compile-time topologies (body part pairs and their PAF channels), used to specialize the per-frame code of the
+    // main models (e.g., connectBodyPartsCpu). getPosePartPairs() and getPoseMapIndex() are filled from them.
+    // Their tables are defined once in poseParameters.cpp.
+    // COCO
+    struct OP_API PoseTopologyCoco
+    {
+        static constexpr unsigned int BODY_PART_PAIRS[]{
+            1,2,   1,5,   2,3,   3,4,   5,6,   6,7,   1,8,   8,9,   9,10,  1,11,
+            11,12, 12,13,  1,0,   0,14, 14,16,  0,15, 15,17,  2,16,  5,17
+        };
+        static constexpr unsigned int MAP_INDEX[]{
+            31,32, 39,40, 33,34, 35,36, 41,42, 43,44, 19,20, 21,22, 23,24, 25,26,
+            27,28, 29,30, 47,48, 49,50, 53,54, 51,52, 55,56, 37,38, 45,46
+        };
+        static constexpr unsigned int numberBodyParts() { return 18u; }
+        static constexpr unsigned int numberBodyPartPairs()
+        {
+            return sizeof(BODY_PART_PAIRS) / (2*sizeof(unsigned int));
+        }
+        static constexpr const unsigned int* bodyPartPairs() { return BODY_PART_PAIRS; }
+        static constexpr const unsigned int* mapIndex() { return MAP_INDEX; }
+        // Ears connections (in case person is looking to opposite direction to camera)
+        static constexpr bool isEarPair(const unsigned int pairIndex) { return pairIndex == 17 || pairIndex == 18; }
+    };
+    // MPI_15 and MPI_15_4
+    struct OP_API PoseTopologyMpi
+    {
+        static constexpr unsigned int BODY_PART_PAIRS[]{
+            0,1,   1,2,   2,3,   3,4,   1,5,   5,6,   6,7,   1,14,  14,8,  8,9,  9,10,  14,11, 11,12, 12,13
+        };
+        static constexpr unsigned int MAP_INDEX[]{
+            16,17, 18,19, 20,21, 22,23, 24,25, 26,27, 28,29, 30,31, 32,33, 34,35, 36,37, 38,39, 40,41, 42,43
+        };
+        static constexpr unsigned int numberBodyParts() { return 15u; }
+        static constexpr unsigned int numberBodyPartPairs()
+        {
+            return sizeof(BODY_PART_PAIRS) / (2*sizeof(unsigned int));
+        }
+        static constexpr const unsigned int* bodyPartPairs() { return BODY_PART_PAIRS; }
+        static constexpr const unsigned int* mapIndex() { return MAP_INDEX; }
+        static constexpr bool isEarPair(const unsigned int) { return false; }
+    };
+    static_assert(sizeof(PoseTopologyCoco::MAP_INDEX) == sizeof(PoseTopologyCoco::BODY_PART_PAIRS),
+                  "Wrong COCO topology.");
+    static_assert(sizeof(PoseTopologyMpi::MAP_INDEX) == sizeof(PoseTopologyMpi::BODY_PART_PAIRS),
+                  "Wrong MPI topology.");
 }
 
 #endif // OPENPOSE_POSE_POSE_PARAMETERS_HPP
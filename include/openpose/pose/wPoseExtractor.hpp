@@ -1,24 +1,49 @@
 #ifndef OPENPOSE_POSE_W_POSE_EXTRACTOR_HPP
 #define OPENPOSE_POSE_W_POSE_EXTRACTOR_HPP
 
+#include <deque>
+#include <queue> // std::queue
 #include <openpose/core/common.hpp>
 #include <openpose/pose/poseExtractor.hpp>
 #include <openpose/thread/worker.hpp>
 
 namespace op
 {
+    /**
+     * WPoseExtractor: Pose keypoint detection of each TDatums.
+     * If batchSize > 1 (offline processing, e.g., recorded videos), the frames are kept until batchSize of them (with
+     * the same net input sizes) are collected, so the net runs a single N-batch forward pass on all of them (see
+     * PoseExtractor::forwardPassBatch). They are then returned one per work() call, in the same order. It increases
+     * the throughput at the cost of latency.
+     */
     template<typename TDatums>
     class WPoseExtractor : public Worker<TDatums>
     {
     public:
-        explicit WPoseExtractor(const std::shared_ptr<PoseExtractor>& poseExtractorSharedPtr);
+        explicit WPoseExtractor(const std::shared_ptr<PoseExtractor>& poseExtractorSharedPtr,
+                                const int batchSize = 1);
 
         void initializationOnThread();
 
         void work(TDatums& tDatums);
 
+        void tryStop();
+
+        bool hasPendingOutput() const;
+
     private:
         std::shared_ptr<PoseExtractor> spPoseExtractor;
+        const unsigned int mBatchSize;
+        bool mStopWhenEmpty;
+        // Batch mode: frames waiting for the batch to be complete
+        std::deque<TDatums> mPendingTDatums;
+        unsigned int mNumberPendingDatums;
+        // Batch mode: processed frames (one returned per work() call)
+        std::queue<TDatums> mReadyTDatums;
+
+        void processBatch();
+
+        void fillDatum(TDatums& tDatums, const unsigned int index);
 
         DELETE_COPY(WPoseExtractor);
     };
@@ -29,12 +54,18 @@ namespace op
 
 
 // Implementation
+#include <openpose/utilities/fastMath.hpp>
 #include <openpose/utilities/pointerContainer.hpp>
+#include <openpose/utilities/standard.hpp>
 namespace op
 {
     template<typename TDatums>
-    WPoseExtractor<TDatums>::WPoseExtractor(const std::shared_ptr<PoseExtractor>& poseExtractorSharedPtr) :
-        spPoseExtractor{poseExtractorSharedPtr}
+    WPoseExtractor<TDatums>::WPoseExtractor(const std::shared_ptr<PoseExtractor>& poseExtractorSharedPtr,
+                                            const int batchSize) :
+        spPoseExtractor{poseExtractorSharedPtr},
+        mBatchSize{(unsigned int)fastMax(1, batchSize)},
+        mStopWhenEmpty{false},
+        mNumberPendingDatums{0u}
     {
     }
 
@@ -49,7 +80,46 @@ namespace op
     {
         try
         {
-            if (checkNoNullNorEmpty(tDatums))
+            // Batch mode
+            if (mBatchSize > 1)
+            {
+                // Profiling speed
+                const auto profilerKey = Profiler::timerInit(__LINE__, __FUNCTION__, __FILE__);
+                auto batchProcessed = false;
+                // Input TDatums -> pending batch
+                if (checkNoNullNorEmpty(tDatums))
+                {
+                    mPendingTDatums.emplace_back(tDatums);
+                    mNumberPendingDatums += (unsigned int)tDatums->size();
+                }
+                tDatums = nullptr;
+                // Batch complete, or no more frames will arrive
+                if (mNumberPendingDatums >= mBatchSize || (mStopWhenEmpty && mNumberPendingDatums > 0))
+                {
+                    // Debugging log
+                    dLog("", Priority::Low, __LINE__, __FUNCTION__, __FILE__);
+                    processBatch();
+                    batchProcessed = true;
+                }
+                // Return next processed TDatums
+                if (!mReadyTDatums.empty())
+                {
+                    tDatums = mReadyTDatums.front();
+                    mReadyTDatums.pop();
+                }
+                // Stop once all frames were retrieved
+                if (mStopWhenEmpty && mPendingTDatums.empty() && mReadyTDatums.empty() && tDatums == nullptr)
+                    this->stop();
+                if (batchProcessed)
+                {
+                    // Profiling speed
+                    Profiler::timerEnd(profilerKey);
+                    Profiler::printAveragedTimeMsOnIterationX(profilerKey, __LINE__, __FUNCTION__, __FILE__);
+                    // Debugging log
+                    dLog("", Priority::Low, __LINE__, __FUNCTION__, __FILE__);
+                }
+            }
+            else if (checkNoNullNorEmpty(tDatums))
             {
                 // Debugging log
                 dLog("", Priority::Low, __LINE__, __FUNCTION__, __FILE__);
@@ -64,20 +134,8 @@ namespace op
                     spPoseExtractor->forwardPass(tDatum.inputNetData,
                                                  Point<int>{tDatum.cvInputData.cols, tDatum.cvInputData.rows},
                                                  tDatum.scaleInputToNetInputs, tDatum.id);
-                    // OpenPose keypoint detector
-                    tDatum.poseCandidates = spPoseExtractor->getCandidatesCopy();
-                    tDatum.poseHeatMaps = spPoseExtractor->getHeatMapsCopy();
-                    tDatum.poseKeypoints = spPoseExtractor->getPoseKeypoints().clone();
-                    tDatum.poseScores = spPoseExtractor->getPoseScores().clone();
-                    tDatum.scaleNetToOutput = spPoseExtractor->getScaleNetToOutput();
-                    // Keep desired top N people
-                    spPoseExtractor->keepTopPeople(tDatum.poseKeypoints, tDatum.poseScores);
-                    // ID extractor (experimental)
-                    tDatum.poseIds = spPoseExtractor->extractIdsLockThread(tDatum.poseKeypoints, tDatum.cvInputData,
-                                                                           i, tDatum.id);
-                    // Tracking (experimental)
-                    spPoseExtractor->trackLockThread(tDatum.poseKeypoints, tDatum.poseIds, tDatum.cvInputData, i,
-                                                     tDatum.id);
+                    // OpenPose keypoint detector + keep top N people + ID extractor + tracking
+                    fillDatum(tDatums, i);
                 }
                 // Profiling speed
                 Profiler::timerEnd(profilerKey);
@@ -94,6 +152,121 @@ namespace op
         }
     }
 
+    template<typename TDatums>
+    void WPoseExtractor<TDatums>::tryStop()
+    {
+        try
+        {
+            // Close if all frames were returned
+            if (mPendingTDatums.empty() && mReadyTDatums.empty())
+                this->stop();
+            mStopWhenEmpty = true;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    template<typename TDatums>
+    bool WPoseExtractor<TDatums>::hasPendingOutput() const
+    {
+        // Batch mode: processed frames not returned yet
+        return !mReadyTDatums.empty();
+    }
+
+    template<typename TDatums>
+    void WPoseExtractor<TDatums>::processBatch()
+    {
+        try
+        {
+            // Pending datums (TDatums + index), in order
+            std::vector<std::pair<TDatums, unsigned int>> datums;
+            datums.reserve(mNumberPendingDatums);
+            for (auto& pendingTDatums : mPendingTDatums)
+                for (auto i = 0u ; i < pendingTDatums->size() ; i++)
+                    datums.emplace_back(pendingTDatums, i);
+            // Consecutive datums with the same net input sizes (up to mBatchSize) are run in the same net batch
+            std::vector<std::vector<Array<float>>> inputNetData;
+            std::vector<Point<int>> inputDataSizes;
+            std::vector<std::vector<double>> scaleInputToNetInputs;
+            std::vector<long long> frameIds;
+            for (auto batchStart = 0u ; batchStart < datums.size() ; )
+            {
+                const auto& firstInputNetData = (*datums[batchStart].first)[datums[batchStart].second].inputNetData;
+                auto batchEnd = batchStart;
+                inputNetData.clear();
+                inputDataSizes.clear();
+                scaleInputToNetInputs.clear();
+                frameIds.clear();
+                for ( ; batchEnd < datums.size() && batchEnd - batchStart < mBatchSize ; batchEnd++)
+                {
+                    const auto& tDatum = (*datums[batchEnd].first)[datums[batchEnd].second];
+                    // Different number of scales or net input sizes -> next batch
+                    if (tDatum.inputNetData.size() != firstInputNetData.size())
+                        break;
+                    auto sameSizes = true;
+                    for (auto i = 0u ; i < firstInputNetData.size() && sameSizes ; i++)
+                        sameSizes = vectorsAreEqual(tDatum.inputNetData[i].getSize(),
+                                                    firstInputNetData[i].getSize());
+                    if (!sameSizes)
+                        break;
+                    inputNetData.emplace_back(tDatum.inputNetData);
+                    inputDataSizes.emplace_back(Point<int>{tDatum.cvInputData.cols, tDatum.cvInputData.rows});
+                    scaleInputToNetInputs.emplace_back(tDatum.scaleInputToNetInputs);
+                    frameIds.emplace_back(tDatum.id);
+                }
+                // OpenPose net forward pass (single N-batch one)
+                spPoseExtractor->forwardPassBatch(inputNetData, inputDataSizes, scaleInputToNetInputs, frameIds);
+                // Frame by frame (sequential, so ID extractor and tracking see them in order)
+                for (auto datumIndex = batchStart ; datumIndex < batchEnd ; datumIndex++)
+                {
+                    spPoseExtractor->postProcessBatchFrame(datumIndex - batchStart);
+                    fillDatum(datums[datumIndex].first, datums[datumIndex].second);
+                }
+                batchStart = batchEnd;
+            }
+            // Pending -> ready
+            for (auto& pendingTDatums : mPendingTDatums)
+                mReadyTDatums.emplace(pendingTDatums);
+            mPendingTDatums.clear();
+            mNumberPendingDatums = 0u;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    template<typename TDatums>
+    void WPoseExtractor<TDatums>::fillDatum(TDatums& tDatums, const unsigned int index)
+    {
+        try
+        {
+            auto& tDatum = (*tDatums)[index];
+            // OpenPose keypoint detector
+            tDatum.poseCandidates = spPoseExtractor->getCandidatesCopy();
+            tDatum.poseHeatMaps = spPoseExtractor->getHeatMapsCopy();
+            tDatum.poseKeypoints = spPoseExtractor->getPoseKeypoints().clone();
+            tDatum.poseScores = spPoseExtractor->getPoseScores().clone();
+            tDatum.scaleNetToOutput = spPoseExtractor->getScaleNetToOutput();
+            // Keep desired top N people
+            spPoseExtractor->keepTopPeople(tDatum.poseKeypoints, tDatum.poseScores);
+            // ID extractor (experimental)
+            tDatum.poseIds = spPoseExtractor->extractIdsLockThread(tDatum.poseKeypoints, tDatum.cvInputData,
+                                                                   index, tDatum.id);
+            // Tracking (experimental)
+            spPoseExtractor->trackLockThread(tDatum.poseKeypoints, tDatum.poseIds, tDatum.cvInputData, index,
+                                             tDatum.id);
+            // Adaptive net scheduler (if enabled)
+            spPoseExtractor->updateNetScheduler(tDatum.poseKeypoints, tDatum.poseIds, tDatum.id);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
     COMPILE_TEMPLATE_DATUM(WPoseExtractor);
 }
 
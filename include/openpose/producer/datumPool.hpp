@@ -0,0 +1,158 @@
+#ifndef OPENPOSE_PRODUCER_DATUM_POOL_HPP
+#define OPENPOSE_PRODUCER_DATUM_POOL_HPP
+
+#include <mutex>
+#include <openpose/core/common.hpp>
+
+namespace op
+{
+    /**
+     * DatumPool: Free list of TDatumsNoPtr, so the frame containers are recycled rather than allocated for each frame.
+     * The TDatums returned by getDatums() go back to the pool when their last std::shared_ptr copy is released (in
+     * whichever thread that happens), or they are deleted if the DatumPool was already destroyed or it is full.
+     * Recycled Datums are reset to their default values, except inputNetData and outputData: they are fully re-written
+     * every frame, and Array<T>::reset() re-uses their memory (the largest per-frame buffers) if the size did not
+     * change.
+     */
+    template<typename TDatumsNoPtr>
+    class DatumPool
+    {
+    public:
+        /**
+         * @param maxSize Maximum number of TDatumsNoPtr kept in the free list (the rest are deleted when released).
+         */
+        explicit DatumPool(const unsigned long long maxSize = 32);
+
+        /**
+         * Recycled TDatumsNoPtr if any available, or new (empty) one otherwise.
+         */
+        std::shared_ptr<TDatumsNoPtr> getDatums();
+
+        /**
+         * Number of TDatumsNoPtr currently in the free list.
+         */
+        unsigned long long getNumberFree() const;
+
+    private:
+        struct FreeList
+        {
+            std::mutex mutex;
+            std::vector<std::unique_ptr<TDatumsNoPtr>> tDatums;
+        };
+
+        const unsigned long long mMaxSize;
+        // Shared with the deleter of the released TDatums, which might outlive the DatumPool
+        const std::shared_ptr<FreeList> spFreeList;
+
+        static void recycle(TDatumsNoPtr& tDatums);
+
+        DELETE_COPY(DatumPool);
+    };
+}
+
+
+
+
+
+// Implementation
+#include <openpose/core/datum.hpp>
+namespace op
+{
+    template<typename TDatumsNoPtr>
+    DatumPool<TDatumsNoPtr>::DatumPool(const unsigned long long maxSize) :
+        mMaxSize{maxSize},
+        spFreeList{std::make_shared<FreeList>()}
+    {
+    }
+
+    template<typename TDatumsNoPtr>
+    std::shared_ptr<TDatumsNoPtr> DatumPool<TDatumsNoPtr>::getDatums()
+    {
+        try
+        {
+            // Recycled TDatumsNoPtr (or new one if none available)
+            std::unique_ptr<TDatumsNoPtr> upTDatums;
+            {
+                const std::lock_guard<std::mutex> lock{spFreeList->mutex};
+                if (!spFreeList->tDatums.empty())
+                {
+                    upTDatums = std::move(spFreeList->tDatums.back());
+                    spFreeList->tDatums.pop_back();
+                }
+            }
+            if (upTDatums == nullptr)
+                upTDatums.reset(new TDatumsNoPtr{});
+            // Deleter: back to the free list (if the DatumPool still exists and it is not full)
+            const std::weak_ptr<FreeList> wpFreeList{spFreeList};
+            const auto maxSize = mMaxSize;
+            return std::shared_ptr<TDatumsNoPtr>{
+                upTDatums.release(),
+                [wpFreeList, maxSize](TDatumsNoPtr* tDatumsPtr)
+                {
+                    std::unique_ptr<TDatumsNoPtr> upTDatumsReleased{tDatumsPtr};
+                    try
+                    {
+                        const auto spFreeListLocked = wpFreeList.lock();
+                        if (spFreeListLocked != nullptr)
+                        {
+                            // Reset outside the lock (in the releasing thread)
+                            recycle(*upTDatumsReleased);
+                            const std::lock_guard<std::mutex> lock{spFreeListLocked->mutex};
+                            if (spFreeListLocked->tDatums.size() < maxSize)
+                                spFreeListLocked->tDatums.emplace_back(std::move(upTDatumsReleased));
+                        }
+                    }
+                    catch (const std::exception& e)
+                    {
+                        // Deleters must not throw (std::terminate), the TDatums are just not recycled
+                        log(e.what(), Priority::High, __LINE__, __FUNCTION__, __FILE__);
+                    }
+                }};
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return std::make_shared<TDatumsNoPtr>();
+        }
+    }
+
+    template<typename TDatumsNoPtr>
+    unsigned long long DatumPool<TDatumsNoPtr>::getNumberFree() const
+    {
+        try
+        {
+            const std::lock_guard<std::mutex> lock{spFreeList->mutex};
+            return spFreeList->tDatums.size();
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return 0ull;
+        }
+    }
+
+    template<typename TDatumsNoPtr>
+    void DatumPool<TDatumsNoPtr>::recycle(TDatumsNoPtr& tDatums)
+    {
+        try
+        {
+            // Default values for everything but the memory of the Arrays fully re-written every frame
+            for (auto& tDatum : tDatums)
+            {
+                auto inputNetData = std::move(tDatum.inputNetData);
+                auto outputData = std::move(tDatum.outputData);
+                tDatum = typename TDatumsNoPtr::value_type{};
+                tDatum.inputNetData = std::move(inputNetData);
+                tDatum.outputData = std::move(outputData);
+            }
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    extern template class DatumPool<DATUM_BASE_NO_PTR>;
+}
+
+#endif // OPENPOSE_PRODUCER_DATUM_POOL_HPP
@@ -6,6 +6,7 @@
 #include <tuple>
 #include <openpose/core/common.hpp>
 #include <openpose/core/datum.hpp>
+#include <openpose/producer/datumPool.hpp>
 #include <openpose/producer/producer.hpp>
 
 namespace op
@@ -28,6 +29,7 @@ namespace op
         unsigned long long mGlobalCounter;
         unsigned int mNumberConsecutiveEmptyFrames;
         std::shared_ptr<std::pair<std::atomic<bool>, std::atomic<int>>> spVideoSeek;
+        DatumPool<TDatumsNoPtr> mDatumPool;
 
         void checkIfTooManyConsecutiveEmptyFrames(unsigned int& numberConsecutiveEmptyFrames,
                                                   const bool emptyFrame) const;
@@ -73,7 +75,8 @@ namespace op
     {
         try
         {
-            auto datums = std::make_shared<TDatumsNoPtr>();
+            // Recycled TDatums (they might contain the Datums of a previous frame until resized)
+            auto datums = mDatumPool.getDatums();
             // Check last desired frame has not been reached
             if (mNumberFramesToProcess != std::numeric_limits<unsigned long long>::max()
                 && mGlobalCounter > mNumberFramesToProcess)
@@ -159,7 +162,11 @@ namespace op
                     if (datums != nullptr)
                         mGlobalCounter++;
                 }
+                else
+                    datums->clear();
             }
+            else
+                datums->clear();
             // Return result
             return std::make_pair(datumProducerRunning, datums);
         }
@@ -2,6 +2,7 @@
 #define OPENPOSE_PRODUCER_HEADERS_HPP
 
 // producer module
+#include <openpose/producer/datumPool.hpp>
 #include <openpose/producer/datumProducer.hpp>
 #include <openpose/producer/enumClasses.hpp>
 #include <openpose/producer/flirReader.hpp>
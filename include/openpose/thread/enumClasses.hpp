@@ -22,6 +22,20 @@ namespace op
          */
         Synchronous,
     };
+
+    /**
+     * Behavior of a queue when pushing into it while it is full.
+     * The dropped frames are counted (QueueBase::getNumberDropped()). With any of the dropping policies, pushing never
+     * blocks, so the latency of real-time sources (e.g. webcam) is bounded during processing load spikes.
+     */
+    enum class QueuePolicy : unsigned char
+    {
+        Block,          /**< Default: the pusher waits until there is free space (no frame is lost). */
+        DropNewest,     /**< The new frame is discarded. */
+        DropOldest,     /**< The oldest frame in the queue is discarded to make room for the new one. */
+        LatestOnly,     /**< Any frame in the queue is discarded, so it only keeps the latest one (maximum size 1). */
+        Size,
+    };
 }
 
 #endif // OPENPOSE_THREAD_ENUM_CLASSES_HPP
@@ -6,6 +6,7 @@
 #include <openpose/thread/priorityQueue.hpp>
 #include <openpose/thread/queue.hpp>
 #include <openpose/thread/queueBase.hpp>
+#include <openpose/thread/ringQueue.hpp>
 #include <openpose/thread/subThread.hpp>
 #include <openpose/thread/subThreadNoQueue.hpp>
 #include <openpose/thread/subThreadQueueIn.hpp>
@@ -13,6 +14,7 @@
 #include <openpose/thread/subThreadQueueOut.hpp>
 #include <openpose/thread/thread.hpp>
 #include <openpose/thread/threadManager.hpp>
+#include <openpose/thread/threadPool.hpp>
 #include <openpose/thread/worker.hpp>
 #include <openpose/thread/workerProducer.hpp>
 #include <openpose/thread/workerConsumer.hpp>
@@ -1,10 +1,14 @@
 #ifndef OPENPOSE_THREAD_QUEUE_BASE_HPP
 #define OPENPOSE_THREAD_QUEUE_BASE_HPP
 
+#include <atomic>
+#include <chrono>
 #include <condition_variable>
 #include <mutex>
 #include <queue> // std::queue & std::priority_queue
 #include <openpose/core/common.hpp>
+#include <openpose/thread/enumClasses.hpp>
+#include <openpose/utilities/metrics.hpp>
 
 namespace op
 {
@@ -16,51 +20,80 @@ namespace op
 
         virtual ~QueueBase();
 
-        bool forceEmplace(TDatums& tDatums);
+        virtual bool forceEmplace(TDatums& tDatums);
 
-        bool tryEmplace(TDatums& tDatums);
+        virtual bool tryEmplace(TDatums& tDatums);
 
-        bool waitAndEmplace(TDatums& tDatums);
+        virtual bool waitAndEmplace(TDatums& tDatums);
 
-        bool forcePush(const TDatums& tDatums);
+        virtual bool forcePush(const TDatums& tDatums);
 
-        bool tryPush(const TDatums& tDatums);
+        virtual bool tryPush(const TDatums& tDatums);
 
-        bool waitAndPush(const TDatums& tDatums);
+        virtual bool waitAndPush(const TDatums& tDatums);
 
-        bool tryPop(TDatums& tDatums);
+        virtual bool tryPop(TDatums& tDatums);
 
-        bool tryPop();
+        virtual bool tryPop();
 
-        bool waitAndPop(TDatums& tDatums);
+        virtual bool waitAndPop(TDatums& tDatums);
 
-        bool waitAndPop();
+        virtual bool waitAndPop();
 
-        bool empty() const;
+        /**
+         * Similar to waitAndPop(tDatums), but it waits at most maxWait.
+         */
+        virtual bool waitAndPop(TDatums& tDatums, const std::chrono::microseconds& maxWait);
 
-        void stop();
+        virtual bool empty() const;
 
-        void stopPusher();
+        virtual void stop();
+
+        virtual void stopPusher();
 
         void addPopper();
 
         void addPusher();
 
-        bool isRunning() const;
+        virtual bool isRunning() const;
 
-        size_t size() const;
+        virtual size_t size() const;
 
-        void clear();
+        virtual void clear();
 
         virtual TDatums front() const = 0;
 
+        /**
+         * It sets what to do when pushing into a full queue (QueuePolicy::Block by default). It should be set before
+         * the queue is used.
+         * With any dropping policy, the push/emplace functions never block nor fail because the queue is full, they
+         * only return false if the queue was stopped.
+         */
+        void setPolicy(const QueuePolicy policy);
+
+        QueuePolicy getPolicy() const;
+
+        /**
+         * Number of frames discarded so far because of the QueuePolicy (or forcePush/forceEmplace).
+         */
+        unsigned long long getNumberDropped() const;
+
+        /**
+         * It reports to Metrics its size after each push (histogram) and its dropped frames (counter). Called by
+         * ThreadManager if Metrics is enabled, before the queue is used.
+         * @param name Prefix of the metric names.
+         */
+        void enableMetrics(const std::string& name);
+
     protected:
         mutable std::mutex mMutex;
         long long mPoppers;
         long long mPushers;
         long long mMaxPoppersPushers;
-        bool mPopIsStopped;
-        bool mPushIsStopped;
+        std::atomic<bool> mPopIsStopped;
+        std::atomic<bool> mPushIsStopped;
+        std::atomic<QueuePolicy> mPolicy;
+        std::atomic<unsigned long long> mNumberDropped;
         std::condition_variable mConditionVariable;
         TQueue mTQueue;
 
@@ -68,8 +101,23 @@ namespace op
 
         unsigned long long getMaxSize() const;
 
+        inline void recordSize(const size_t size)
+        {
+            if (spSizeHistogram != nullptr)
+                spSizeHistogram->record(size);
+        }
+
+        inline void addDropped(const unsigned long long numberDropped)
+        {
+            mNumberDropped += numberDropped;
+            if (spDroppedCounter != nullptr)
+                *spDroppedCounter += numberDropped;
+        }
+
     private:
         const long long mMaxSize;
+        std::shared_ptr<Histogram> spSizeHistogram;
+        std::shared_ptr<std::atomic<unsigned long long>> spDroppedCounter;
 
         bool emplace(TDatums& tDatums);
 
@@ -77,6 +125,9 @@ namespace op
 
         bool pop();
 
+        // Dropping QueuePolicy: it drops the required frames (mMutex locked), returns false if the new one is dropped
+        bool dropFrames();
+
         void updateMaxPoppersPushers();
 
         DELETE_COPY(QueueBase);
@@ -96,8 +147,11 @@ namespace op
     QueueBase<TDatums, TQueue>::QueueBase(const long long maxSize) :
         mPoppers{0ll},
         mPushers{0ll},
+        mMaxPoppersPushers{0ll},
         mPopIsStopped{false},
         mPushIsStopped{false},
+        mPolicy{QueuePolicy::Block},
+        mNumberDropped{0ull},
         mMaxSize{maxSize}
     {
     }
@@ -125,7 +179,10 @@ namespace op
         {
             const std::lock_guard<std::mutex> lock{mMutex};
             if (mTQueue.size() >= getMaxSize())
+            {
                 mTQueue.pop();
+                addDropped(1ull);
+            }
             return emplace(tDatums);
         }
         catch (const std::exception& e)
@@ -141,6 +198,8 @@ namespace op
         try
         {
             const std::lock_guard<std::mutex> lock{mMutex};
+            if (mPolicy != QueuePolicy::Block)
+                return (dropFrames() ? emplace(tDatums) : !mPushIsStopped);
             if (mTQueue.size() >= getMaxSize())
                 return false;
             return emplace(tDatums);
@@ -158,6 +217,8 @@ namespace op
         try
         {
             std::unique_lock<std::mutex> lock{mMutex};
+            if (mPolicy != QueuePolicy::Block)
+                return (dropFrames() ? emplace(tDatums) : !mPushIsStopped);
             mConditionVariable.wait(lock, [this]{return mTQueue.size() < getMaxSize() || mPushIsStopped; });
             return emplace(tDatums);
         }
@@ -175,7 +236,10 @@ namespace op
         {
             const std::lock_guard<std::mutex> lock{mMutex};
             if (mTQueue.size() >= getMaxSize())
+            {
                 mTQueue.pop();
+                addDropped(1ull);
+            }
             return push(tDatums);
         }
         catch (const std::exception& e)
@@ -191,6 +255,8 @@ namespace op
         try
         {
             const std::lock_guard<std::mutex> lock{mMutex};
+            if (mPolicy != QueuePolicy::Block)
+                return (dropFrames() ? push(tDatums) : !mPushIsStopped);
             if (mTQueue.size() >= getMaxSize())
                 return false;
             return push(tDatums);
@@ -208,6 +274,8 @@ namespace op
         try
         {
             std::unique_lock<std::mutex> lock{mMutex};
+            if (mPolicy != QueuePolicy::Block)
+                return (dropFrames() ? push(tDatums) : !mPushIsStopped);
             mConditionVariable.wait(lock, [this]{return mTQueue.size() < getMaxSize() || mPushIsStopped; });
             return push(tDatums);
         }
@@ -280,6 +348,22 @@ namespace op
         }
     }
 
+    template<typename TDatums, typename TQueue>
+    bool QueueBase<TDatums, TQueue>::waitAndPop(TDatums& tDatums, const std::chrono::microseconds& maxWait)
+    {
+        try
+        {
+            std::unique_lock<std::mutex> lock{mMutex};
+            mConditionVariable.wait_for(lock, maxWait, [this]{return !mTQueue.empty() || mPopIsStopped; });
+            return pop(tDatums);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return false;
+        }
+    }
+
     template<typename TDatums, typename TQueue>
     bool QueueBase<TDatums, TQueue>::empty() const
     {
@@ -413,6 +497,61 @@ namespace op
         }
     }
 
+    template<typename TDatums, typename TQueue>
+    void QueueBase<TDatums, TQueue>::setPolicy(const QueuePolicy policy)
+    {
+        try
+        {
+            mPolicy = {policy};
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    template<typename TDatums, typename TQueue>
+    QueuePolicy QueueBase<TDatums, TQueue>::getPolicy() const
+    {
+        try
+        {
+            return mPolicy;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return QueuePolicy::Block;
+        }
+    }
+
+    template<typename TDatums, typename TQueue>
+    unsigned long long QueueBase<TDatums, TQueue>::getNumberDropped() const
+    {
+        try
+        {
+            return mNumberDropped;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return 0ull;
+        }
+    }
+
+    template<typename TDatums, typename TQueue>
+    void QueueBase<TDatums, TQueue>::enableMetrics(const std::string& name)
+    {
+        try
+        {
+            spSizeHistogram = Metrics::getHistogram(name + "/size");
+            spDroppedCounter = Metrics::getCounter(name + "/dropped");
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
     template<typename TDatums, typename TQueue>
     unsigned long long QueueBase<TDatums, TQueue>::getMaxSize() const
     {
@@ -436,6 +575,7 @@ namespace op
                 return false;
 
             mTQueue.emplace(tDatums);
+            recordSize(mTQueue.size());
             mConditionVariable.notify_all();
             return true;
         }
@@ -455,6 +595,7 @@ namespace op
                 return false;
 
             mTQueue.push(tDatums);
+            recordSize(mTQueue.size());
             mConditionVariable.notify_all();
             return true;
         }
@@ -484,6 +625,46 @@ namespace op
         }
     }
 
+    template<typename TDatums, typename TQueue>
+    bool QueueBase<TDatums, TQueue>::dropFrames()
+    {
+        try
+        {
+            if (mPushIsStopped)
+                return false;
+            const auto policy = mPolicy.load();
+            // Keep only the new one
+            if (policy == QueuePolicy::LatestOnly)
+            {
+                addDropped(mTQueue.size());
+                while (!mTQueue.empty())
+                    mTQueue.pop();
+                return true;
+            }
+            // Not full
+            if (mTQueue.size() < getMaxSize())
+                return true;
+            // Make room for the new one
+            if (policy == QueuePolicy::DropOldest)
+            {
+                while (mTQueue.size() >= getMaxSize())
+                {
+                    mTQueue.pop();
+                    addDropped(1ull);
+                }
+                return true;
+            }
+            // QueuePolicy::DropNewest
+            addDropped(1ull);
+            return false;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return false;
+        }
+    }
+
     template<typename TDatums, typename TQueue>
     void QueueBase<TDatums, TQueue>::updateMaxPoppersPushers()
     {
@@ -0,0 +1,685 @@
+#ifndef OPENPOSE_THREAD_RING_QUEUE_HPP
+#define OPENPOSE_THREAD_RING_QUEUE_HPP
+
+#include <atomic>
+#include <chrono>
+#include <memory> // std::unique_ptr
+#include <openpose/core/common.hpp>
+#include <openpose/thread/queue.hpp>
+
+namespace op
+{
+    /**
+     * RingQueue: Lock-free alternative to Queue. It is a bounded ring buffer in which each cell keeps a sequence number
+     * (bounded MPMC queue of D. Vyukov), so pushing and popping do not take any mutex and the threads spinning on
+     * tryPop do not contend with the ones pushing. The mutex and condition variable are only used to sleep inside the
+     * waitAndX functions, after the queue has been full (or empty) for a while.
+     * If singleProducerConsumer (only one thread pushes into it and only one pops from it), pushing does not require
+     * any atomic read-modify-write operation.
+     * ThreadManager automatically uses it for its queues.
+     * Unlike Queue, its maximum size is fixed on construction, and front() is only safe from the popping thread.
+     */
+    template<typename TDatums>
+    class RingQueue : public Queue<TDatums>
+    {
+    public:
+        explicit RingQueue(const long long maxSize, const bool singleProducerConsumer = false);
+
+        virtual ~RingQueue();
+
+        bool forceEmplace(TDatums& tDatums);
+
+        bool tryEmplace(TDatums& tDatums);
+
+        bool waitAndEmplace(TDatums& tDatums);
+
+        bool forcePush(const TDatums& tDatums);
+
+        bool tryPush(const TDatums& tDatums);
+
+        bool waitAndPush(const TDatums& tDatums);
+
+        bool tryPop(TDatums& tDatums);
+
+        bool tryPop();
+
+        bool waitAndPop(TDatums& tDatums);
+
+        bool waitAndPop();
+
+        bool waitAndPop(TDatums& tDatums, const std::chrono::microseconds& maxWait);
+
+        bool empty() const;
+
+        void stop();
+
+        void stopPusher();
+
+        bool isRunning() const;
+
+        size_t size() const;
+
+        void clear();
+
+        TDatums front() const;
+
+    private:
+        struct Cell
+        {
+            std::atomic<unsigned long long> sequence;
+            TDatums tDatums;
+        };
+
+        const unsigned long long mMaxSize;
+        const unsigned long long mNumberCells;
+        const bool mSingleProducerConsumer;
+        std::unique_ptr<Cell[]> upCells;
+        // Push and pop positions in different cache lines (no false sharing between pushing and popping threads)
+        char mPaddingPush[64];
+        std::atomic<unsigned long long> mPushPosition;
+        char mPaddingPop[64];
+        std::atomic<unsigned long long> mPopPosition;
+        char mPaddingWait[64];
+        // Sleeping threads
+        std::atomic<int> mNumberWaiters;
+        std::mutex mWaitMutex;
+        std::condition_variable mWaitConditionVariable;
+
+        bool pop(TDatums& tDatums);
+
+        bool ringPush(const TDatums& tDatums);
+
+        bool ringPop(TDatums& tDatums);
+
+        // Dropping QueuePolicy (it never blocks)
+        bool dropAndPush(const TDatums& tDatums);
+
+        void notifyWaiters();
+
+        // Negative maxWait = no time limit
+        template<typename TTryFunction, typename TStopFunction>
+        bool wait(const TTryFunction& tryFunction, const TStopFunction& stopFunction,
+                  const std::chrono::microseconds& maxWait = std::chrono::microseconds{-1});
+
+        DELETE_COPY(RingQueue);
+    };
+}
+
+
+
+
+
+// Implementation
+#include <algorithm> // std::min
+#include <thread>
+#include <openpose/utilities/fastMath.hpp>
+namespace op
+{
+    // Iterations spinning (yielding the CPU) before sleeping in the waitAndX functions. No spinning on single-core
+    // machines, where it only delays the thread that would unblock it
+    const auto RING_QUEUE_SPIN_ITERATIONS = (std::thread::hardware_concurrency() > 1 ? 128 : 0);
+
+    template<typename TDatums>
+    RingQueue<TDatums>::RingQueue(const long long maxSize, const bool singleProducerConsumer) :
+        Queue<TDatums>{maxSize},
+        mMaxSize{(unsigned long long)fastMax(1ll, maxSize)},
+        // The sequence numbers require at least 2 cells
+        mNumberCells{fastMax(2ull, mMaxSize)},
+        mSingleProducerConsumer{singleProducerConsumer},
+        upCells{new Cell[mNumberCells]},
+        mPushPosition{0ull},
+        mPopPosition{0ull},
+        mNumberWaiters{0}
+    {
+        try
+        {
+            if (maxSize < 1)
+                error("The maximum size of RingQueue must be positive.", __LINE__, __FUNCTION__, __FILE__);
+            for (auto i = 0ull ; i < mNumberCells ; i++)
+                upCells[i].sequence.store(i, std::memory_order_relaxed);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    template<typename TDatums>
+    RingQueue<TDatums>::~RingQueue()
+    {
+        try
+        {
+            stop();
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    template<typename TDatums>
+    bool RingQueue<TDatums>::forceEmplace(TDatums& tDatums)
+    {
+        try
+        {
+            return forcePush(tDatums);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return false;
+        }
+    }
+
+    template<typename TDatums>
+    bool RingQueue<TDatums>::tryEmplace(TDatums& tDatums)
+    {
+        try
+        {
+            return tryPush(tDatums);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return false;
+        }
+    }
+
+    template<typename TDatums>
+    bool RingQueue<TDatums>::waitAndEmplace(TDatums& tDatums)
+    {
+        try
+        {
+            return waitAndPush(tDatums);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return false;
+        }
+    }
+
+    template<typename TDatums>
+    bool RingQueue<TDatums>::forcePush(const TDatums& tDatums)
+    {
+        try
+        {
+            // If full, remove the oldest element and retry
+            while (!this->mPushIsStopped)
+            {
+                if (ringPush(tDatums))
+                {
+                    this->recordSize(size());
+                    notifyWaiters();
+                    return true;
+                }
+                TDatums oldestTDatums;
+                if (ringPop(oldestTDatums))
+                    this->addDropped(1ull);
+            }
+            return false;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return false;
+        }
+    }
+
+    template<typename TDatums>
+    bool RingQueue<TDatums>::tryPush(const TDatums& tDatums)
+    {
+        try
+        {
+            if (this->mPolicy != QueuePolicy::Block)
+                return dropAndPush(tDatums);
+            if (this->mPushIsStopped || !ringPush(tDatums))
+                return false;
+            this->recordSize(size());
+            notifyWaiters();
+            return true;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return false;
+        }
+    }
+
+    template<typename TDatums>
+    bool RingQueue<TDatums>::waitAndPush(const TDatums& tDatums)
+    {
+        try
+        {
+            if (this->mPolicy != QueuePolicy::Block)
+                return dropAndPush(tDatums);
+            if (!wait([&]{ return !this->mPushIsStopped && ringPush(tDatums); },
+                      [this]{ return this->mPushIsStopped.load(); }))
+                return false;
+            this->recordSize(size());
+            notifyWaiters();
+            return true;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return false;
+        }
+    }
+
+    template<typename TDatums>
+    bool RingQueue<TDatums>::tryPop(TDatums& tDatums)
+    {
+        try
+        {
+            return pop(tDatums);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return false;
+        }
+    }
+
+    template<typename TDatums>
+    bool RingQueue<TDatums>::tryPop()
+    {
+        try
+        {
+            TDatums tDatums;
+            return pop(tDatums);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return false;
+        }
+    }
+
+    template<typename TDatums>
+    bool RingQueue<TDatums>::waitAndPop(TDatums& tDatums)
+    {
+        try
+        {
+            // It also stops waiting if there are no pushers left and the queue is empty
+            if (!wait([&]{ return !this->mPopIsStopped && ringPop(tDatums); },
+                      [this]{ return this->mPopIsStopped || (this->mPushIsStopped && empty()); }))
+                return false;
+            notifyWaiters();
+            return true;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return false;
+        }
+    }
+
+    template<typename TDatums>
+    bool RingQueue<TDatums>::waitAndPop()
+    {
+        try
+        {
+            TDatums tDatums;
+            return waitAndPop(tDatums);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return false;
+        }
+    }
+
+    template<typename TDatums>
+    bool RingQueue<TDatums>::waitAndPop(TDatums& tDatums, const std::chrono::microseconds& maxWait)
+    {
+        try
+        {
+            if (maxWait.count() <= 0)
+                return tryPop(tDatums);
+            if (!wait([&]{ return !this->mPopIsStopped && ringPop(tDatums); },
+                      [this]{ return this->mPopIsStopped || (this->mPushIsStopped && empty()); }, maxWait))
+                return false;
+            notifyWaiters();
+            return true;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return false;
+        }
+    }
+
+    template<typename TDatums>
+    bool RingQueue<TDatums>::empty() const
+    {
+        try
+        {
+            return size() == 0;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return false;
+        }
+    }
+
+    template<typename TDatums>
+    void RingQueue<TDatums>::stop()
+    {
+        try
+        {
+            log("", Priority::Low, __LINE__, __FUNCTION__, __FILE__);
+            this->mPopIsStopped = {true};
+            this->mPushIsStopped = {true};
+            clear();
+            notifyWaiters();
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    template<typename TDatums>
+    void RingQueue<TDatums>::stopPusher()
+    {
+        try
+        {
+            log("", Priority::Low, __LINE__, __FUNCTION__, __FILE__);
+            const std::lock_guard<std::mutex> lock{this->mMutex};
+            this->mPushers--;
+            if (this->mPushers == 0)
+            {
+                this->mPushIsStopped = {true};
+                if (empty())
+                    this->mPopIsStopped = {true};
+                notifyWaiters();
+            }
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    template<typename TDatums>
+    bool RingQueue<TDatums>::isRunning() const
+    {
+        try
+        {
+            return !(this->mPushIsStopped && (this->mPopIsStopped || empty()));
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return true;
+        }
+    }
+
+    template<typename TDatums>
+    size_t RingQueue<TDatums>::size() const
+    {
+        try
+        {
+            // Approximated while other threads push or pop
+            const auto popPosition = mPopPosition.load(std::memory_order_acquire);
+            const auto pushPosition = mPushPosition.load(std::memory_order_acquire);
+            return (size_t)fastMax(0ll, (long long)(pushPosition - popPosition));
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return 0;
+        }
+    }
+
+    template<typename TDatums>
+    void RingQueue<TDatums>::clear()
+    {
+        try
+        {
+            TDatums tDatums;
+            while (ringPop(tDatums))
+            {
+            }
+            notifyWaiters();
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    template<typename TDatums>
+    TDatums RingQueue<TDatums>::front() const
+    {
+        try
+        {
+            const auto position = mPopPosition.load(std::memory_order_relaxed);
+            const auto& cell = upCells[position % mNumberCells];
+            if (cell.sequence.load(std::memory_order_acquire) == position + 1)
+                return cell.tDatums;
+            return TDatums{};
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return TDatums{};
+        }
+    }
+
+    template<typename TDatums>
+    bool RingQueue<TDatums>::pop(TDatums& tDatums)
+    {
+        try
+        {
+            if (this->mPopIsStopped || !ringPop(tDatums))
+                return false;
+            notifyWaiters();
+            return true;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return false;
+        }
+    }
+
+    template<typename TDatums>
+    bool RingQueue<TDatums>::ringPush(const TDatums& tDatums)
+    {
+        try
+        {
+            // Reserve a position
+            Cell* cellPtr;
+            auto position = mPushPosition.load(std::memory_order_relaxed);
+            while (true)
+            {
+                // Maximum size (the number of cells might be greater)
+                if ((long long)(position - mPopPosition.load(std::memory_order_acquire)) >= (long long)mMaxSize)
+                    return false;
+                cellPtr = &upCells[position % mNumberCells];
+                const auto difference = (long long)(cellPtr->sequence.load(std::memory_order_acquire) - position);
+                // Cell free
+                if (difference == 0)
+                {
+                    // Single pusher: nobody else can reserve it
+                    if (mSingleProducerConsumer)
+                    {
+                        mPushPosition.store(position + 1, std::memory_order_relaxed);
+                        break;
+                    }
+                    else if (mPushPosition.compare_exchange_weak(position, position + 1,
+                                                                 std::memory_order_relaxed))
+                        break;
+                }
+                // Cell not popped yet (full)
+                else if (difference < 0)
+                    return false;
+                // Another thread reserved this position
+                else
+                    position = mPushPosition.load(std::memory_order_relaxed);
+            }
+            // Write and publish it
+            cellPtr->tDatums = tDatums;
+            cellPtr->sequence.store(position + 1, std::memory_order_release);
+            return true;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return false;
+        }
+    }
+
+    template<typename TDatums>
+    bool RingQueue<TDatums>::ringPop(TDatums& tDatums)
+    {
+        try
+        {
+            // Reserve a position (always atomically, stop() and clear() might pop from any thread)
+            Cell* cellPtr;
+            auto position = mPopPosition.load(std::memory_order_relaxed);
+            while (true)
+            {
+                cellPtr = &upCells[position % mNumberCells];
+                const auto difference = (long long)(cellPtr->sequence.load(std::memory_order_acquire)
+                                                    - (position + 1));
+                // Cell written
+                if (difference == 0)
+                {
+                    if (mPopPosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+                        break;
+                }
+                // Cell not written yet (empty)
+                else if (difference < 0)
+                    return false;
+                // Another thread reserved this position
+                else
+                    position = mPopPosition.load(std::memory_order_relaxed);
+            }
+            // Read it and release the cell for the next round
+            tDatums = std::move(cellPtr->tDatums);
+            cellPtr->tDatums = TDatums{};
+            cellPtr->sequence.store(position + mNumberCells, std::memory_order_release);
+            return true;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return false;
+        }
+    }
+
+    template<typename TDatums>
+    bool RingQueue<TDatums>::dropAndPush(const TDatums& tDatums)
+    {
+        try
+        {
+            const auto policy = this->mPolicy.load();
+            while (!this->mPushIsStopped)
+            {
+                // Keep only the new one
+                if (policy == QueuePolicy::LatestOnly)
+                {
+                    TDatums oldTDatums;
+                    while (ringPop(oldTDatums))
+                        this->addDropped(1ull);
+                }
+                if (ringPush(tDatums))
+                {
+                    this->recordSize(size());
+                    notifyWaiters();
+                    return true;
+                }
+                // Full
+                if (policy == QueuePolicy::DropNewest)
+                {
+                    this->addDropped(1ull);
+                    return true;
+                }
+                // QueuePolicy::DropOldest (or another thread pushed first) -> remove the oldest one and retry
+                TDatums oldestTDatums;
+                if (ringPop(oldestTDatums))
+                    this->addDropped(1ull);
+            }
+            return false;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return false;
+        }
+    }
+
+    template<typename TDatums>
+    void RingQueue<TDatums>::notifyWaiters()
+    {
+        try
+        {
+            // The fence (together with the atomic increment of mNumberWaiters) avoids missing a thread that is about
+            // to sleep. The mutex is only taken if some thread is sleeping
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            if (mNumberWaiters.load(std::memory_order_relaxed) > 0)
+            {
+                const std::lock_guard<std::mutex> lock{mWaitMutex};
+                mWaitConditionVariable.notify_all();
+            }
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    template<typename TDatums>
+    template<typename TTryFunction, typename TStopFunction>
+    bool RingQueue<TDatums>::wait(const TTryFunction& tryFunction, const TStopFunction& stopFunction,
+                                  const std::chrono::microseconds& maxWait)
+    {
+        try
+        {
+            const auto noTimeLimit = (maxWait.count() < 0);
+            const auto deadline = std::chrono::high_resolution_clock::now() + maxWait;
+            // Spin for a while (low latency)
+            for (auto i = 0 ; i < RING_QUEUE_SPIN_ITERATIONS ; i++)
+            {
+                if (tryFunction())
+                    return true;
+                if (stopFunction() || (!noTimeLimit && std::chrono::high_resolution_clock::now() >= deadline))
+                    return false;
+                std::this_thread::yield();
+            }
+            // Sleep until notified. The 1 msec limit is just a safety net, notifyWaiters() should wake it up first
+            mNumberWaiters++;
+            std::unique_lock<std::mutex> lock{mWaitMutex};
+            auto success = false;
+            while (!(success = tryFunction()) && !stopFunction())
+            {
+                auto waitTime = std::chrono::high_resolution_clock::duration{std::chrono::milliseconds{1}};
+                if (!noTimeLimit)
+                {
+                    const auto remainingTime = deadline - std::chrono::high_resolution_clock::now();
+                    if (remainingTime.count() <= 0)
+                        break;
+                    waitTime = std::min(waitTime, remainingTime);
+                }
+                mWaitConditionVariable.wait_for(lock, waitTime);
+            }
+            lock.unlock();
+            mNumberWaiters--;
+            // The caller notifies the other waiting threads after a successful push/pop (not while holding the mutex)
+            return success;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return false;
+        }
+    }
+
+    COMPILE_TEMPLATE_DATUM(RingQueue);
+}
+
+#endif // OPENPOSE_THREAD_RING_QUEUE_HPP
@@ -1,8 +1,11 @@
 #ifndef OPENPOSE_THREAD_SUB_THREAD_HPP
 #define OPENPOSE_THREAD_SUB_THREAD_HPP
 
+#include <chrono>
 #include <openpose/core/common.hpp>
 #include <openpose/thread/worker.hpp>
+#include <openpose/utilities/metrics.hpp>
+#include <openpose/utilities/tracer.hpp>
 
 namespace op
 {
@@ -19,16 +22,66 @@ namespace op
 
         virtual bool work() = 0;
 
+        /**
+         * Maximum time to wait for new input when the input queue is empty (0 = not waiting, i.e., the TWorkers are
+         * called again right away). It should only be set if it is the only SubThread of its Thread, otherwise it
+         * would delay the other ones.
+         */
+        inline void setMaxInputWait(const std::chrono::microseconds& maxInputWait)
+        {
+            mMaxInputWait = maxInputWait;
+        }
+
+        /**
+         * It reports to Metrics the work time of each TWorker, and the time waiting for input (starved) and pushing
+         * the output (blocked by a full queue). Called by ThreadManager if Metrics is enabled.
+         * @param name Prefix of the metric names.
+         */
+        void enableMetrics(const std::string& name);
+
+        /**
+         * It records into Tracer a span per TWorker and TDatums (tagged with the Datum id). Called by ThreadManager if
+         * Tracer is enabled.
+         * @param name Name of this SubThread in the timeline (the spans are named after their TWorker class).
+         */
+        void enableTracing(const std::string& name);
+
     protected:
         inline size_t getTWorkersSize() const
         {
             return mTWorkers.size();
         }
 
+        // 0 if some TWorker already has output to return (no need to wait for new input)
+        inline std::chrono::microseconds getMaxInputWait() const
+        {
+            if (mMaxInputWait.count() > 0)
+                for (const auto& tWorker : mTWorkers)
+                    if (tWorker->hasPendingOutput())
+                        return std::chrono::microseconds{0};
+            return mMaxInputWait;
+        }
+
         bool workTWorkers(TDatums& tDatums, const bool inputIsRunning);
 
+        // Metrics: new TDatums popped (time since the previous ones were finished)
+        void recordInputWait();
+
+        // Metrics: TDatums pushed into the output queue (and finished)
+        void recordOutputWait(const std::chrono::high_resolution_clock::time_point& pushStart);
+
+        // Metrics: TDatums finished (no output queue, so no output wait)
+        void recordFinish();
+
     private:
         std::vector<TWorker> mTWorkers;
+        std::chrono::microseconds mMaxInputWait;
+        std::vector<std::shared_ptr<Histogram>> mWorkTimeHistograms;
+        std::shared_ptr<Histogram> spInputWaitHistogram;
+        std::shared_ptr<Histogram> spOutputWaitHistogram;
+        std::chrono::high_resolution_clock::time_point mLastFinishTime;
+        std::string mTraceName;
+        std::vector<unsigned int> mTraceNameIds;
 
         DELETE_COPY(SubThread);
     };
@@ -43,7 +96,8 @@ namespace op
 {
     template<typename TDatums, typename TWorker>
     SubThread<TDatums, TWorker>::SubThread(const std::vector<TWorker>& tWorkers) :
-        mTWorkers{tWorkers}
+        mTWorkers{tWorkers},
+        mMaxInputWait{0}
     {
     }
 
@@ -74,12 +128,30 @@ namespace op
                 // Iterate over all workers and check whether some of them stopped
                 auto allRunning = true;
                 auto lastOneStopped = false;
-                for (auto& worker : mTWorkers)
+                for (auto i = 0u ; i < mTWorkers.size() ; i++)
                 {
+                    auto& worker = mTWorkers[i];
                     if (lastOneStopped)
                         worker->tryStop();
 
-                    if (!worker->checkAndWork(tDatums))
+                    // Metrics and Tracer: work time (only if it received or generated TDatums)
+                    const auto profileWork = (!mWorkTimeHistograms.empty() || !mTraceNameIds.empty());
+                    const auto hadTDatums = (tDatums != nullptr);
+                    const auto datumId = (hadTDatums && !tDatums->empty() ? (*tDatums)[0].id : -1);
+                    const auto startTime = (profileWork ? Metrics::now()
+                                                        : std::chrono::high_resolution_clock::time_point{});
+                    const auto workerIsRunning = worker->checkAndWork(tDatums);
+                    if (profileWork && (hadTDatums || tDatums != nullptr))
+                    {
+                        if (!mWorkTimeHistograms.empty())
+                            mWorkTimeHistograms[i]->record(Metrics::microsecondsSince(startTime));
+                        if (!mTraceNameIds.empty())
+                            Tracer::addSpan(mTraceNameIds[i],
+                                            (hadTDatums || tDatums->empty() ? datumId : (*tDatums)[0].id),
+                                            startTime, Metrics::now());
+                    }
+
+                    if (!workerIsRunning)
                     {
                         allRunning = false;
                         lastOneStopped = true;
@@ -137,11 +209,95 @@ namespace op
         }
     }
 
+    template<typename TDatums, typename TWorker>
+    void SubThread<TDatums, TWorker>::enableMetrics(const std::string& name)
+    {
+        try
+        {
+            mWorkTimeHistograms.clear();
+            for (auto i = 0u ; i < mTWorkers.size() ; i++)
+                mWorkTimeHistograms.emplace_back(Metrics::getHistogram(
+                    name + "/" + std::to_string(i) + "_" + Metrics::getTypeName(typeid(*mTWorkers[i]))
+                    + "/work_us"));
+            spInputWaitHistogram = Metrics::getHistogram(name + "/input_wait_us");
+            spOutputWaitHistogram = Metrics::getHistogram(name + "/output_wait_us");
+            mLastFinishTime = Metrics::now();
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    template<typename TDatums, typename TWorker>
+    void SubThread<TDatums, TWorker>::enableTracing(const std::string& name)
+    {
+        try
+        {
+            mTraceName = name;
+            mTraceNameIds.clear();
+            for (auto i = 0u ; i < mTWorkers.size() ; i++)
+                mTraceNameIds.emplace_back(Tracer::getNameId(Metrics::getTypeName(typeid(*mTWorkers[i]))));
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    template<typename TDatums, typename TWorker>
+    void SubThread<TDatums, TWorker>::recordInputWait()
+    {
+        try
+        {
+            if (spInputWaitHistogram != nullptr)
+                spInputWaitHistogram->record(Metrics::microsecondsSince(mLastFinishTime));
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    template<typename TDatums, typename TWorker>
+    void SubThread<TDatums, TWorker>::recordOutputWait(
+        const std::chrono::high_resolution_clock::time_point& pushStart)
+    {
+        try
+        {
+            if (spOutputWaitHistogram != nullptr)
+            {
+                spOutputWaitHistogram->record(Metrics::microsecondsSince(pushStart));
+                mLastFinishTime = Metrics::now();
+            }
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    template<typename TDatums, typename TWorker>
+    void SubThread<TDatums, TWorker>::recordFinish()
+    {
+        try
+        {
+            if (spInputWaitHistogram != nullptr)
+                mLastFinishTime = Metrics::now();
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
     template<typename TDatums, typename TWorker>
     void SubThread<TDatums, TWorker>::initializationOnThread()
     {
         try
         {
+            if (!mTraceName.empty())
+                Tracer::setThreadName(mTraceName);
             for (auto& tWorker : mTWorkers)
                 tWorker->initializationOnThread();
         }
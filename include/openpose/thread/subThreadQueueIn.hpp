@@ -43,14 +43,22 @@ namespace op
     {
         try
         {
-            // Pop TDatums
+            // Pop TDatums (waiting for it if enabled)
             TDatums tDatums;
-            bool queueIsRunning = spTQueueIn->tryPop(tDatums);
+            bool queueIsRunning = (this->getMaxInputWait().count() > 0
+                                   ? spTQueueIn->waitAndPop(tDatums, this->getMaxInputWait())
+                                   : spTQueueIn->tryPop(tDatums));
             // Check queue not empty
             if (!queueIsRunning)
                 queueIsRunning = spTQueueIn->isRunning();
+            // Metrics
+            const auto poppedTDatums = (tDatums != nullptr);
+            if (poppedTDatums)
+                this->recordInputWait();
             // Process TDatums
             const auto workersAreRunning = this->workTWorkers(tDatums, queueIsRunning);
+            if (poppedTDatums)
+                this->recordFinish();
             // Close queue input if all workers closed
             if (!workersAreRunning)
                 spTQueueIn->stop();
@@ -56,19 +56,28 @@ namespace op
             // If output queue running -> normal operation
             else
             {
-                // Pop TDatums
+                // Pop TDatums (waiting for it if enabled)
                 TDatums tDatums;
-                bool workersAreRunning = spTQueueIn->tryPop(tDatums);
+                bool workersAreRunning = (this->getMaxInputWait().count() > 0
+                                          ? spTQueueIn->waitAndPop(tDatums, this->getMaxInputWait())
+                                          : spTQueueIn->tryPop(tDatums));
                 // Check queue not stopped
                 if (!workersAreRunning)
                     workersAreRunning = spTQueueIn->isRunning();
+                // Metrics
+                if (tDatums != nullptr)
+                    this->recordInputWait();
                 // Process TDatums
                 workersAreRunning = this->workTWorkers(tDatums, workersAreRunning);
                 // Push/emplace tDatums if successfully processed
                 if (workersAreRunning)
                 {
                     if (tDatums != nullptr)
+                    {
+                        const auto pushStart = Metrics::now();
                         spTQueueOut->waitAndEmplace(tDatums);
+                        this->recordOutputWait(pushStart);
+                    }
                 }
                 // Close both queues otherwise
                 else
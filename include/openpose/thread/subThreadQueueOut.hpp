@@ -56,7 +56,11 @@ namespace op
                 if (workersAreRunning)
                 {
                     if (tDatums != nullptr)
+                    {
+                        const auto pushStart = Metrics::now();
                         spTQueueOut->waitAndEmplace(tDatums);
+                        this->recordOutputWait(pushStart);
+                    }
                 }
                 // Close queue otherwise
                 else
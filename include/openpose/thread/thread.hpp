@@ -106,6 +106,13 @@ namespace op
     {
         for (const auto& subThread : subThreads)
             mSubThreads.emplace_back(subThread);
+        // A single SubThread sleeps until new input arrives (rather than spinning). The time limit keeps calling its
+        // TWorkers periodically (e.g., GUI refresh, WQueueOrderer time-outs)
+        const auto maxInputWait = (mSubThreads.size() == 1
+                                   ? std::chrono::microseconds{std::chrono::milliseconds{1}}
+                                   : std::chrono::microseconds{0});
+        for (auto& subThread : mSubThreads)
+            subThread->setMaxInputWait(maxInputWait);
     }
 
     template<typename TDatums, typename TWorker>
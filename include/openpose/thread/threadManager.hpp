@@ -2,12 +2,14 @@
 #define OPENPOSE_THREAD_THREAD_MANAGER_HPP
 
 #include <atomic>
+#include <map>
 #include <set> // std::multiset
 #include <tuple>
 #include <openpose/core/common.hpp>
 #include <openpose/thread/enumClasses.hpp>
 #include <openpose/thread/queue.hpp>
 #include <openpose/thread/thread.hpp>
+#include <openpose/thread/threadPool.hpp>
 #include <openpose/thread/worker.hpp>
 
 namespace op
@@ -21,6 +23,26 @@ namespace op
 
         void setDefaultMaxSizeQueues(const long long defaultMaxSizeQueues = -1);
 
+        /**
+         * It creates a work-stealing ThreadPool while running (set as the default one for parallelFor), so the
+         * data-parallel loops of the TWorkers are split among the CPU cores. Each TWorker keeps running in its own
+         * thread (they might be stateful or thread-bound, e.g., GPU contexts).
+         * @param numberThreads Number of ThreadPool threads. 0 to disable it (default), negative for #cores - 1.
+         */
+        void enableThreadPool(const int numberThreads = -1);
+
+        /**
+         * It sets the QueuePolicy of a queue (QueuePolicy::Block by default).
+         * @param queueId Queue id, as used in add(). E.g., a dropping policy on the queue between the frames producer
+         * and the pose extractor keeps the latency bounded for real-time sources.
+         */
+        void setQueuePolicy(const unsigned long long queueId, const QueuePolicy queuePolicy);
+
+        /**
+         * Number of frames dropped by the queues so far (see QueuePolicy).
+         */
+        unsigned long long getNumberDropped() const;
+
         void add(const unsigned long long threadId, const std::vector<TWorker>& tWorkers, const unsigned long long queueInId, const unsigned long long queueOutId);
 
         void add(const unsigned long long threadId, const TWorker& tWorker, const unsigned long long queueInId, const unsigned long long queueOutId);
@@ -59,6 +81,9 @@ namespace op
         const ThreadManagerMode mThreadManagerMode;
         std::shared_ptr<std::atomic<bool>> spIsRunning;
         long long mDefaultMaxSizeQueues;
+        std::map<unsigned long long, QueuePolicy> mQueuePolicies;
+        int mNumberThreadPoolThreads;
+        std::shared_ptr<ThreadPool> spThreadPool;
         std::multiset<std::tuple<unsigned long long, std::vector<TWorker>, unsigned long long, unsigned long long>> mThreadWorkerQueues;
         std::vector<std::shared_ptr<Thread<TDatums, TWorker>>> mThreads;
         std::vector<std::shared_ptr<TQueue>> mTQueues;
@@ -73,6 +98,8 @@ namespace op
 
         void checkAndCreateQueues();
 
+        void startThreadPool();
+
         DELETE_COPY(ThreadManager);
     };
 }
@@ -82,8 +109,10 @@ namespace op
 
 
 // Implementation
+#include <type_traits> // std::is_same
 #include <utility> // std::pair
 #include <openpose/utilities/fastMath.hpp>
+#include <openpose/thread/ringQueue.hpp>
 #include <openpose/thread/subThread.hpp>
 #include <openpose/thread/subThreadNoQueue.hpp>
 #include <openpose/thread/subThreadQueueIn.hpp>
@@ -91,11 +120,53 @@ namespace op
 #include <openpose/thread/subThreadQueueOut.hpp>
 namespace op
 {
+    // Default Queue -> lock-free RingQueue
+    template<typename TDatums, typename TQueue>
+    std::shared_ptr<TQueue> createQueue(const long long maxSize, const long long numberPushers,
+                                        const long long numberPoppers, const bool singleProducerConsumer,
+                                        std::true_type)
+    {
+        try
+        {
+            // Same default maximum size than Queue (max(#pushers, #poppers), see QueueBase::getMaxSize). User
+            // threads (-1) are unknown, so they do not count (as they are not added as pushers/poppers in Queue)
+            return std::make_shared<RingQueue<TDatums>>(
+                (maxSize > 0 ? maxSize : fastMax(1ll, fastMax(numberPushers, numberPoppers))),
+                singleProducerConsumer);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return nullptr;
+        }
+    }
+
+    // Any other TQueue (e.g., PriorityQueue) -> kept
+    template<typename TDatums, typename TQueue>
+    std::shared_ptr<TQueue> createQueue(const long long maxSize, const long long numberPushers,
+                                        const long long numberPoppers, const bool singleProducerConsumer,
+                                        std::false_type)
+    {
+        try
+        {
+            UNUSED(numberPushers);
+            UNUSED(numberPoppers);
+            UNUSED(singleProducerConsumer);
+            return std::make_shared<TQueue>(maxSize);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return nullptr;
+        }
+    }
+
     template<typename TDatums, typename TWorker, typename TQueue>
     ThreadManager<TDatums, TWorker, TQueue>::ThreadManager(const ThreadManagerMode threadManagerMode) :
         mThreadManagerMode{threadManagerMode},
         spIsRunning{std::make_shared<std::atomic<bool>>(false)},
-        mDefaultMaxSizeQueues{-1ll}
+        mDefaultMaxSizeQueues{-1ll},
+        mNumberThreadPoolThreads{0}
     {
     }
 
@@ -112,6 +183,50 @@ namespace op
         }
     }
 
+    template<typename TDatums, typename TWorker, typename TQueue>
+    void ThreadManager<TDatums, TWorker, TQueue>::enableThreadPool(const int numberThreads)
+    {
+        try
+        {
+            mNumberThreadPoolThreads = {numberThreads};
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    template<typename TDatums, typename TWorker, typename TQueue>
+    void ThreadManager<TDatums, TWorker, TQueue>::setQueuePolicy(const unsigned long long queueId,
+                                                                 const QueuePolicy queuePolicy)
+    {
+        try
+        {
+            mQueuePolicies[queueId] = queuePolicy;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    template<typename TDatums, typename TWorker, typename TQueue>
+    unsigned long long ThreadManager<TDatums, TWorker, TQueue>::getNumberDropped() const
+    {
+        try
+        {
+            auto numberDropped = 0ull;
+            for (const auto& tQueue : mTQueues)
+                numberDropped += tQueue->getNumberDropped();
+            return numberDropped;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return 0ull;
+        }
+    }
+
     template<typename TDatums, typename TWorker, typename TQueue>
     void ThreadManager<TDatums, TWorker, TQueue>::add(const unsigned long long threadId, const std::vector<TWorker>& tWorkers, const unsigned long long queueInId,
                                                       const unsigned long long queueOutId)
@@ -148,6 +263,7 @@ namespace op
             mThreadWorkerQueues.clear();
             mThreads.clear();
             mTQueues.clear();
+            mQueuePolicies.clear();
         }
         catch (const std::exception& e)
         {
@@ -166,6 +282,7 @@ namespace op
             if (!mThreads.empty())
             {
                 log("", Priority::Low, __LINE__, __FUNCTION__, __FILE__);
+                startThreadPool();
                 // Start threads
                 for (auto i = 0u; i < mThreads.size() - 1; i++)
                     mThreads.at(i)->startInThread();
@@ -189,6 +306,7 @@ namespace op
             log("", Priority::Low, __LINE__, __FUNCTION__, __FILE__);
             // Set threads
             multisetToThreads();
+            startThreadPool();
             // Start threads
             for (auto& thread : mThreads)
                 thread->startInThread();
@@ -212,6 +330,16 @@ namespace op
             *spIsRunning = false;
             for (auto& thread : mThreads)
                 thread->stopAndJoin();
+            // Stop ThreadPool once no TWorker is using it
+            if (spThreadPool != nullptr)
+            {
+                if (getDefaultThreadPool() == spThreadPool)
+                    setDefaultThreadPool(nullptr);
+                spThreadPool.reset();
+            }
+            // Write trace once no TWorker is recording into it
+            if (Tracer::isEnabled())
+                Tracer::writeToFile();
             log("", Priority::Low, __LINE__, __FUNCTION__, __FILE__);
         }
         catch (const std::exception& e)
@@ -407,6 +535,15 @@ namespace op
                     // Case no queue
                     else // if (queueIn == 0 && queueOut == maxQueueIdSynchronous)
                         subThread = {std::make_shared<SubThreadNoQueue<TDatums, TWorker>>(tWorkers)};
+                    // Metrics (named by thread and queue ids, as used in add())
+                    const auto subThreadName = "thread_" + std::to_string(std::get<0>(threadWorkerQueue))
+                                             + "/queue_" + std::to_string(queueIn)
+                                             + "_to_" + std::to_string(queueOut);
+                    if (Metrics::isEnabled())
+                        subThread->enableMetrics(subThreadName);
+                    // Tracer
+                    if (Tracer::isEnabled())
+                        subThread->enableTracing(subThreadName);
                     thread->add(subThread);
                 }
             }
@@ -489,8 +626,66 @@ namespace op
                     mTQueues.resize(maxQueueId);   // First or last one is queue
                 else
                     error("Unknown ThreadManagerMode", __LINE__, __FUNCTION__, __FILE__);
-                for (auto& tQueue : mTQueues)
-                    tQueue = std::make_shared<TQueue>(mDefaultMaxSizeQueues);
+                // Number of pushing and popping sub-threads of each queue
+                // If !AsynchronousIn (and !Asynchronous) -> queue indexes - 1
+                const auto queueIdOffset = (mThreadManagerMode == ThreadManagerMode::Asynchronous
+                                            || mThreadManagerMode == ThreadManagerMode::AsynchronousIn ? 0ull : 1ull);
+                std::vector<long long> numberPushers(mTQueues.size(), 0ll);
+                std::vector<long long> numberPoppers(mTQueues.size(), 0ll);
+                for (const auto& threadWorkerQueue : mThreadWorkerQueues)
+                {
+                    const auto queueIn = std::get<2>(threadWorkerQueue);
+                    const auto queueOut = std::get<3>(threadWorkerQueue);
+                    if (queueIn >= queueIdOffset && queueIn - queueIdOffset < mTQueues.size())
+                        numberPoppers[queueIn - queueIdOffset]++;
+                    if (queueOut >= queueIdOffset && queueOut - queueIdOffset < mTQueues.size())
+                        numberPushers[queueOut - queueIdOffset]++;
+                }
+                // Queues accessed by the user might be accessed from any number of threads
+                if (!mTQueues.empty())
+                {
+                    if (mThreadManagerMode == ThreadManagerMode::Asynchronous
+                        || mThreadManagerMode == ThreadManagerMode::AsynchronousIn)
+                        numberPushers[0] = -1;
+                    if (mThreadManagerMode == ThreadManagerMode::Asynchronous
+                        || mThreadManagerMode == ThreadManagerMode::AsynchronousOut)
+                        numberPoppers.back() = -1;
+                }
+                // Default Queue is replaced by the lock-free RingQueue (single producer/consumer version if possible)
+                for (auto i = 0u ; i < mTQueues.size() ; i++)
+                    mTQueues[i] = createQueue<TDatums, TQueue>(
+                        mDefaultMaxSizeQueues, numberPushers[i], numberPoppers[i],
+                        numberPushers[i] == 1 && numberPoppers[i] == 1, std::is_same<TQueue, Queue<TDatums>>{});
+                // Queue policies
+                for (const auto& queuePolicy : mQueuePolicies)
+                {
+                    if (queuePolicy.first >= queueIdOffset && queuePolicy.first - queueIdOffset < mTQueues.size())
+                        mTQueues[queuePolicy.first - queueIdOffset]->setPolicy(queuePolicy.second);
+                    else
+                        log("Queue id " + std::to_string(queuePolicy.first) + " is not a queue in this"
+                            " ThreadManagerMode, its QueuePolicy is ignored.", Priority::High);
+                }
+                // Metrics
+                if (Metrics::isEnabled())
+                    for (auto i = 0u ; i < mTQueues.size() ; i++)
+                        mTQueues[i]->enableMetrics("queue_" + std::to_string(i + queueIdOffset));
+            }
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    template<typename TDatums, typename TWorker, typename TQueue>
+    void ThreadManager<TDatums, TWorker, TQueue>::startThreadPool()
+    {
+        try
+        {
+            if (mNumberThreadPoolThreads != 0 && spThreadPool == nullptr)
+            {
+                spThreadPool = std::make_shared<ThreadPool>(mNumberThreadPoolThreads);
+                setDefaultThreadPool(spThreadPool);
             }
         }
         catch (const std::exception& e)
@@ -0,0 +1,92 @@
+#ifndef OPENPOSE_THREAD_THREAD_POOL_HPP
+#define OPENPOSE_THREAD_THREAD_POOL_HPP
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional> // std::function
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <openpose/core/common.hpp>
+
+namespace op
+{
+    /**
+     * ThreadPool: Fixed pool of threads running short tasks, in which each thread has its own task deque (LIFO for
+     * its own tasks) and steals the oldest tasks of the other threads when it runs out of them (work stealing).
+     * It is used to run the data-parallel loops inside the Workers (parallelFor), so the cores that the
+     * thread-per-stage layout of ThreadManager leaves idle help the busy stages.
+     */
+    class OP_API ThreadPool
+    {
+    public:
+        /**
+         * Constructor.
+         * @param numberThreads Number of threads. If negative, the number of CPU cores minus 1 (the thread calling
+         * parallelFor also runs part of the loop).
+         */
+        explicit ThreadPool(const int numberThreads = -1);
+
+        virtual ~ThreadPool();
+
+        unsigned int getNumberThreads() const;
+
+        /**
+         * It enqueues a task. If called from one of the pool threads, it goes to its own deque.
+         */
+        void submit(const std::function<void()>& task);
+
+        /**
+         * It runs function(startIndex, endIndex) over the range [0, size), split into chunks of at least
+         * minChunkSize elements. The calling thread also runs chunks (so it can be called from inside a task), and it
+         * returns once all of them finished. Exceptions inside function are re-thrown here.
+         */
+        void parallelFor(const int size, const std::function<void(const int, const int)>& function,
+                         const int minChunkSize = 1);
+
+        /**
+         * It runs one pending task (if any) in the calling thread.
+         * @return Whether a task was run.
+         */
+        bool runPendingTask();
+
+    private:
+        struct TaskDeque
+        {
+            std::mutex mutex;
+            std::deque<std::function<void()>> tasks;
+        };
+
+        // One deque per thread + 1 for the tasks submitted from other threads
+        std::vector<std::unique_ptr<TaskDeque>> mTaskDeques;
+        std::vector<std::thread> mThreads;
+        std::atomic<bool> mStop;
+        std::atomic<long long> mNumberPendingTasks;
+        std::mutex mSleepMutex;
+        std::condition_variable mSleepConditionVariable;
+
+        void threadFunction(const unsigned int threadIndex);
+
+        bool popTask(const unsigned int dequeIndex, std::function<void()>& task);
+
+        DELETE_COPY(ThreadPool);
+    };
+
+    /**
+     * It sets the process-wide ThreadPool used by parallelFor (nullptr to disable it). ThreadManager sets it while
+     * running if ThreadManager::enableThreadPool() was called.
+     */
+    OP_API void setDefaultThreadPool(const std::shared_ptr<ThreadPool>& threadPool);
+
+    OP_API std::shared_ptr<ThreadPool> getDefaultThreadPool();
+
+    /**
+     * ThreadPool::parallelFor on the default ThreadPool, or a plain loop (a single call to function(0, size)) if
+     * there is no default ThreadPool or size < 2 * minChunkSize.
+     */
+    OP_API void parallelFor(const int size, const std::function<void(const int, const int)>& function,
+                            const int minChunkSize = 1);
+}
+
+#endif // OPENPOSE_THREAD_THREAD_POOL_HPP
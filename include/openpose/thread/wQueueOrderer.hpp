@@ -1,18 +1,27 @@
 #ifndef OPENPOSE_THREAD_W_QUEUE_ORDERER_HPP
 #define OPENPOSE_THREAD_W_QUEUE_ORDERER_HPP
 
-#include <queue> // std::priority_queue
+#include <chrono>
+#include <queue> // std::queue
 #include <openpose/core/common.hpp>
 #include <openpose/thread/worker.hpp>
-#include <openpose/utilities/pointerContainer.hpp>
 
 namespace op
 {
+    /**
+     * WQueueOrderer: It returns the TDatums sorted by ID (e.g., after several GPUs processed them in parallel).
+     * The frames are kept in a sequence buffer indexed by ID, so each one is returned as soon as all the previous ones
+     * were (no polling). Its SubThread sleeps until new TDatums arrive.
+     * IDs not received are considered lost (skipped) if either:
+     *     - A frame with ID >= next expected ID + maxBufferSize arrives (maximum reorder window).
+     *     - maxDelayMs milliseconds pass since the first frame was kept waiting for it (if maxDelayMs > 0).
+     * Frames arriving after their ID was skipped are discarded, so the output is always sorted.
+     */
     template<typename TDatums>
     class WQueueOrderer : public Worker<TDatums>
     {
     public:
-        explicit WQueueOrderer(const unsigned int maxBufferSize = 64u);
+        explicit WQueueOrderer(const unsigned int maxBufferSize = 64u, const double maxDelayMs = -1.);
 
         void initializationOnThread();
 
@@ -20,11 +29,26 @@ namespace op
 
         void tryStop();
 
+        bool hasPendingOutput() const;
+
     private:
-        const unsigned int mMaxBufferSize;
+        const unsigned long long mMaxBufferSize;
+        const double mMaxDelayMs;
         bool mStopWhenEmpty;
         unsigned long long mNextExpectedId;
-        std::priority_queue<TDatums, std::vector<TDatums>, PointerContainerGreater<TDatums>> mPriorityQueueBuffer;
+        // Frames waiting for previous IDs, frame ID in position ID % mMaxBufferSize
+        std::vector<TDatums> mSequenceBuffer;
+        unsigned long long mNumberBuffered;
+        // Sorted frames ready to be returned (one per work() call)
+        std::queue<TDatums> mReadyTDatums;
+        bool mIsWaiting;
+        std::chrono::high_resolution_clock::time_point mWaitingStart;
+
+        void releaseUntil(const unsigned long long id);
+
+        void releaseConsecutive();
+
+        void skipToOldest();
 
         DELETE_COPY(WQueueOrderer);
     };
@@ -35,15 +59,19 @@ namespace op
 
 
 // Implementation
-#include <chrono>
-#include <thread>
+#include <openpose/utilities/fastMath.hpp>
+#include <openpose/utilities/pointerContainer.hpp>
 namespace op
 {
     template<typename TDatums>
-    WQueueOrderer<TDatums>::WQueueOrderer(const unsigned int maxBufferSize) :
-        mMaxBufferSize{maxBufferSize},
+    WQueueOrderer<TDatums>::WQueueOrderer(const unsigned int maxBufferSize, const double maxDelayMs) :
+        mMaxBufferSize{fastMax(1u, maxBufferSize)},
+        mMaxDelayMs{maxDelayMs},
         mStopWhenEmpty{false},
-        mNextExpectedId{0}
+        mNextExpectedId{0},
+        mSequenceBuffer(mMaxBufferSize),
+        mNumberBuffered{0},
+        mIsWaiting{false}
     {
     }
 
@@ -60,47 +88,60 @@ namespace op
             // Profiling speed
             const auto profilerKey = Profiler::timerInit(__LINE__, __FUNCTION__, __FILE__);
             bool profileSpeed = (tDatums != nullptr);
-            // Input TDatum -> enqueue or return it back
+            // Input TDatum -> move it into the sequence buffer
             if (checkNoNullNorEmpty(tDatums))
             {
-                // T* to T
-                auto& tDatumsNoPtr = *tDatums;
-                // tDatums is the next expected, update counter
-                if (tDatumsNoPtr[0].id == mNextExpectedId)
-                    mNextExpectedId++;
-                // Else push it to our buffered queue
+                const auto id = (*tDatums)[0].id;
+                // Its ID was already skipped -> discard it
+                if (id < mNextExpectedId)
+                    log("Frame " + std::to_string(id) + " arrived after being considered lost, discarded.",
+                        Priority::Low, __LINE__, __FUNCTION__, __FILE__);
                 else
                 {
-                    // Enqueue current tDatums
-                    mPriorityQueueBuffer.emplace(tDatums);
-                    tDatums = nullptr;
-                    // Else if buffer full -> remove one tDatums
-                    if (mPriorityQueueBuffer.size() > mMaxBufferSize)
+                    // Out of the reorder window -> skip the missing IDs
+                    if (id >= mNextExpectedId + mMaxBufferSize)
+                        releaseUntil(id - mMaxBufferSize + 1);
+                    auto& bufferedTDatums = mSequenceBuffer[id % mMaxBufferSize];
+                    if (bufferedTDatums != nullptr)
+                        log("Repeated frame " + std::to_string(id) + ", discarded.",
+                            Priority::Low, __LINE__, __FUNCTION__, __FILE__);
+                    else
                     {
-                        tDatums = mPriorityQueueBuffer.top();
-                        mPriorityQueueBuffer.pop();
+                        bufferedTDatums = tDatums;
+                        mNumberBuffered++;
                     }
                 }
             }
-            // If input TDatum enqueued -> check if previously enqueued next desired frame and pop it
-            if (!checkNoNullNorEmpty(tDatums))
+            tDatums = nullptr;
+            releaseConsecutive();
+            // Frames waiting for a missing ID
+            if (mNumberBuffered > 0)
             {
-                // Retrieve frame if next is desired frame or if we want to stop this worker
-                if (!mPriorityQueueBuffer.empty()   &&   ((*mPriorityQueueBuffer.top())[0].id == mNextExpectedId || mStopWhenEmpty))
+                // Stopping -> no more frames will arrive
+                if (mStopWhenEmpty)
+                    skipToOldest();
+                // Time-out
+                else if (mMaxDelayMs > 0.)
                 {
-                    tDatums = { mPriorityQueueBuffer.top() };
-                    mPriorityQueueBuffer.pop();
+                    const auto now = std::chrono::high_resolution_clock::now();
+                    if (!mIsWaiting)
+                    {
+                        mIsWaiting = true;
+                        mWaitingStart = now;
+                    }
+                    else if (std::chrono::duration<double, std::milli>(now - mWaitingStart).count() > mMaxDelayMs)
+                        skipToOldest();
                 }
             }
-            // If TDatum ready to be returned -> updated next expected id
-            if (checkNoNullNorEmpty(tDatums))
+            // Return next sorted TDatums
+            if (!mReadyTDatums.empty())
             {
-                const auto& tDatumsNoPtr = *tDatums;
-                mNextExpectedId = tDatumsNoPtr[0].id + 1;
+                tDatums = mReadyTDatums.front();
+                mReadyTDatums.pop();
             }
-            // Sleep if no new tDatums to either pop
-            if (!checkNoNullNorEmpty(tDatums) && mPriorityQueueBuffer.size() < mMaxBufferSize / 2u)
-                std::this_thread::sleep_for(std::chrono::milliseconds{1});
+            // Stop once all frames were retrieved
+            if (mStopWhenEmpty && mNumberBuffered == 0 && mReadyTDatums.empty() && tDatums == nullptr)
+                this->stop();
             // If TDatum popped and/or pushed
             if (profileSpeed || tDatums != nullptr)
             {
@@ -125,10 +166,86 @@ namespace op
         try
         {
             // Close if all frames were retrieved from the queue
-            if (mPriorityQueueBuffer.empty())
+            if (mNumberBuffered == 0 && mReadyTDatums.empty())
                 this->stop();
             mStopWhenEmpty = true;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    template<typename TDatums>
+    bool WQueueOrderer<TDatums>::hasPendingOutput() const
+    {
+        // Sorted frames not returned yet (e.g., released together by a late ID)
+        return !mReadyTDatums.empty();
+    }
 
+    template<typename TDatums>
+    void WQueueOrderer<TDatums>::releaseUntil(const unsigned long long id)
+    {
+        try
+        {
+            // Buffered frames with ID < id are ready (missing IDs are skipped)
+            for ( ; mNextExpectedId < id && mNumberBuffered > 0 ; mNextExpectedId++)
+            {
+                auto& bufferedTDatums = mSequenceBuffer[mNextExpectedId % mMaxBufferSize];
+                if (bufferedTDatums != nullptr)
+                {
+                    mReadyTDatums.emplace(bufferedTDatums);
+                    bufferedTDatums = nullptr;
+                    mNumberBuffered--;
+                }
+            }
+            mNextExpectedId = fastMax(mNextExpectedId, id);
+            mIsWaiting = false;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    template<typename TDatums>
+    void WQueueOrderer<TDatums>::releaseConsecutive()
+    {
+        try
+        {
+            while (mNumberBuffered > 0)
+            {
+                auto& bufferedTDatums = mSequenceBuffer[mNextExpectedId % mMaxBufferSize];
+                if (bufferedTDatums == nullptr)
+                    break;
+                mReadyTDatums.emplace(bufferedTDatums);
+                bufferedTDatums = nullptr;
+                mNumberBuffered--;
+                mNextExpectedId++;
+                mIsWaiting = false;
+            }
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    template<typename TDatums>
+    void WQueueOrderer<TDatums>::skipToOldest()
+    {
+        try
+        {
+            // Skip the missing IDs until the oldest buffered frame, and release all the consecutive ones
+            for (auto id = mNextExpectedId ; id < mNextExpectedId + mMaxBufferSize ; id++)
+            {
+                if (mSequenceBuffer[id % mMaxBufferSize] != nullptr)
+                {
+                    releaseUntil(id);
+                    break;
+                }
+            }
+            releaseConsecutive();
         }
         catch (const std::exception& e)
         {
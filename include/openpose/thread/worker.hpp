@@ -33,6 +33,13 @@ namespace op
             stop();
         }
 
+        // Whether it already has output to return on the next work() call (e.g. buffers returning one TDatums per
+        // call), so its SubThread must not wait for new input before calling it
+        inline virtual bool hasPendingOutput() const
+        {
+            return false;
+        }
+
     protected:
         virtual void work(TDatums& tDatums) = 0;
 
@@ -6,6 +6,7 @@
 #include <openpose/gui/enumClasses.hpp>
 #include <openpose/pose/enumClasses.hpp>
 #include <openpose/producer/producer.hpp>
+#include <openpose/thread/enumClasses.hpp>
 
 namespace op
 {
@@ -37,7 +38,12 @@ namespace op
 
     OP_API DisplayMode flagsToDisplayMode(const int display, const bool enabled3d);
 
+    OP_API QueuePolicy flagsToQueuePolicy(const int queuePolicy);
+
     OP_API Point<int> flagsToPoint(const std::string& pointString, const std::string& pointExample = "1280x720");
+
+    OP_API std::vector<Point<int>> flagsToPoints(const std::string& pointsString,
+                                                 const std::string& pointExample = "1280x720");
 }
 
 #endif // OPENPOSE_UTILITIES_FLAGS_TO_OPEN_POSE_HPP
@@ -0,0 +1,111 @@
+#ifndef OPENPOSE_UTILITIES_METRICS_HPP
+#define OPENPOSE_UTILITIES_METRICS_HPP
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <memory> // std::shared_ptr
+#include <string>
+#include <typeinfo> // std::type_info
+#include <openpose/core/common.hpp>
+
+// How to use - example:
+    // // Once, e.g. in the constructor
+    // spHistogram = Metrics::getHistogram("my_worker work_us");
+    // // ... inside continuous loop ...
+    // const auto startTime = Metrics::now();
+    // // functions to do...
+    // spHistogram->record(Metrics::microsecondsSince(startTime));
+// ThreadManager automatically reports the work time of each Worker, the waiting times of each SubThread and the
+// size of each queue if Metrics::enable() was called before starting it.
+
+namespace op
+{
+    /**
+     * Histogram: Lock-free histogram of non-negative integer values (e.g. microseconds or queue sizes).
+     * Log-linear buckets as in HDR histograms: 8 linear sub-buckets per power of 2, i.e., percentiles have at most
+     * 12.5% relative error over the whole 64-bit range, with a fixed memory footprint.
+     */
+    class OP_API Histogram
+    {
+    public:
+        Histogram();
+
+        void record(const unsigned long long value);
+
+        unsigned long long getCount() const;
+
+        double getMean() const;
+
+        unsigned long long getMax() const;
+
+        /**
+         * @param percentile In the range [0, 100].
+         * @return Approximated value (upper bound of its bucket, at most getMax()).
+         */
+        unsigned long long getPercentile(const double percentile) const;
+
+        void reset();
+
+    private:
+        static const auto SUB_BUCKET_BITS = 3;
+        static const auto NUMBER_SUB_BUCKETS = 1 << SUB_BUCKET_BITS;
+        static const auto NUMBER_BUCKETS = (64 - SUB_BUCKET_BITS + 1) * NUMBER_SUB_BUCKETS;
+
+        std::array<std::atomic<unsigned long long>, NUMBER_BUCKETS> mBuckets;
+        std::atomic<unsigned long long> mCount;
+        std::atomic<unsigned long long> mSum;
+        std::atomic<unsigned long long> mMax;
+
+        DELETE_COPY(Histogram);
+    };
+
+    /**
+     * Metrics: Process-wide registry of named counters and histograms. Getting a metric takes a mutex (so it should be
+     * done once), while updating it is lock-free.
+     * If enabled with a file path, a background thread appends a JSON snapshot of all the metrics (one line per dump)
+     * to that file periodically.
+     */
+    class OP_API Metrics
+    {
+    public:
+        /**
+         * It enables the automatic metrics of ThreadManager (it must be called before starting it).
+         * @param filePath File where the periodic snapshots are appended. Empty to disable the periodic dump.
+         * @param dumpIntervalSeconds Time between snapshots.
+         */
+        static void enable(const std::string& filePath = "", const double dumpIntervalSeconds = 5.);
+
+        /**
+         * It stops the periodic dump (writing a last snapshot). The registered metrics are kept.
+         */
+        static void disable();
+
+        static bool isEnabled();
+
+        static std::shared_ptr<std::atomic<unsigned long long>> getCounter(const std::string& name);
+
+        static std::shared_ptr<Histogram> getHistogram(const std::string& name);
+
+        /**
+         * Snapshot of all the metrics in JSON format: counters as values, histograms as count, mean, percentiles 50,
+         * 90 and 99 and maximum.
+         */
+        static std::string toJson();
+
+        static void writeToFile(const std::string& filePath);
+
+        static void reset();
+
+        static std::chrono::high_resolution_clock::time_point now();
+
+        static unsigned long long microsecondsSince(const std::chrono::high_resolution_clock::time_point& start);
+
+        /**
+         * Human readable class name (e.g. "op::WPoseExtractor<...>"), used to name the metrics of each Worker.
+         */
+        static std::string getTypeName(const std::type_info& typeInfo);
+    };
+}
+
+#endif // OPENPOSE_UTILITIES_METRICS_HPP
@@ -22,6 +22,11 @@ namespace op
     OP_API std::string toLower(const std::string& string);
 
     OP_API std::string toUpper(const std::string& string);
+
+    /**
+     * It quotes and escapes a string so it can be written as a JSON string value.
+     */
+    OP_API std::string toJsonString(const std::string& text);
 }
 
 #endif // OPENPOSE_UTILITIES_STRING_HPP
@@ -0,0 +1,84 @@
+#ifndef OPENPOSE_UTILITIES_TRACER_HPP
+#define OPENPOSE_UTILITIES_TRACER_HPP
+
+#include <chrono>
+#include <string>
+#include <openpose/core/common.hpp>
+
+// How to use - example:
+    // // Once (e.g. function-local static)
+    // static const auto nameId = Tracer::getNameId("my_step");
+    // // ... inside continuous loop ...
+    // {
+    //     const TracerScope tracerScope{nameId, datumId};
+    //     // functions to do...
+    // }
+// ThreadManager automatically records a span per Worker and frame if Tracer::enable() was called before starting it.
+
+namespace op
+{
+    /**
+     * Tracer: Opt-in timeline of the pipeline in Chrome trace format (viewable in Perfetto or chrome://tracing).
+     * Each thread records its spans (name, frame ID, start and duration) into its own fixed-size ring buffer, so
+     * recording takes no lock and the memory is bounded (only the latest maxEventsPerThread spans per thread are
+     * kept). The trace file is written by writeToFile(), which ThreadManager calls when it stops.
+     */
+    class OP_API Tracer
+    {
+    public:
+        /**
+         * It enables the tracer (it must be called before starting the ThreadManager/Wrapper).
+         * @param filePath Chrome trace JSON file written by writeToFile().
+         * @param maxEventsPerThread Size of the ring buffer of each thread.
+         */
+        static void enable(const std::string& filePath, const unsigned long long maxEventsPerThread = 1ull << 16);
+
+        /**
+         * It writes the trace file and disables the tracer.
+         */
+        static void disable();
+
+        static bool isEnabled();
+
+        /**
+         * Name of the spans (interned, so recording a span does not copy any string). It takes a mutex, so it should be
+         * called once per name.
+         */
+        static unsigned int getNameId(const std::string& name);
+
+        /**
+         * Name of the calling thread in the timeline.
+         */
+        static void setThreadName(const std::string& name);
+
+        static void addSpan(const unsigned int nameId, const unsigned long long datumId,
+                            const std::chrono::high_resolution_clock::time_point& start,
+                            const std::chrono::high_resolution_clock::time_point& end);
+
+        /**
+         * It writes the spans recorded so far (the recording threads should be stopped).
+         */
+        static void writeToFile();
+    };
+
+    /**
+     * TracerScope: It records a span from its construction to its destruction (if Tracer is enabled).
+     */
+    class OP_API TracerScope
+    {
+    public:
+        explicit TracerScope(const unsigned int nameId, const unsigned long long datumId = -1);
+
+        ~TracerScope();
+
+    private:
+        const unsigned int mNameId;
+        const unsigned long long mDatumId;
+        const bool mEnabled;
+        std::chrono::high_resolution_clock::time_point mStart;
+
+        DELETE_COPY(TracerScope);
+    };
+}
+
+#endif // OPENPOSE_UTILITIES_TRACER_HPP
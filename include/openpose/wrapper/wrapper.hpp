@@ -55,6 +55,36 @@ namespace op
          */
         void disableMultiThreading();
 
+        /**
+         * Enable the work-stealing ThreadPool, which splits the data-parallel CPU loops of each Worker (input
+         * resizing, non-maximum suppression, body part connection, etc.) among the available CPU cores.
+         * @param numberThreads Number of ThreadPool threads. 0 to disable it (default), negative for #cores - 1.
+         */
+        void enableThreadPool(const int numberThreads = -1);
+
+        /**
+         * Enable the pipeline metrics (see Metrics): work time of each Worker, time each thread waits for input or
+         * for free space in its output queue, and size and dropped frames of each queue. It must be called before
+         * start() or exec().
+         * @param filePath File where a JSON snapshot of the metrics is appended periodically (empty to disable it).
+         * @param dumpIntervalSeconds Time between snapshots.
+         */
+        void enableMetrics(const std::string& filePath = "", const double dumpIntervalSeconds = 5.);
+
+        /**
+         * JSON snapshot of the current metrics (see enableMetrics()).
+         */
+        std::string getMetrics() const;
+
+        /**
+         * Enable the pipeline timeline (see Tracer): a span per Worker and frame (tagged with the Datum id) plus the
+         * inner steps of the pose extraction, written as a Chrome trace (Perfetto or chrome://tracing) when the
+         * processing stops. It must be called before start() or exec().
+         * @param filePath Chrome trace JSON file.
+         * @param maxEventsPerThread Only the latest maxEventsPerThread spans of each thread are kept.
+         */
+        void enableTracing(const std::string& filePath, const unsigned long long maxEventsPerThread = 1ull << 16);
+
         /**
          * Add an user-defined extra Worker as frames generator.
          * @param worker TWorker to be added.
@@ -201,6 +231,11 @@ namespace op
          */
         bool waitAndPop(std::shared_ptr<TDatums>& tDatums);
 
+        /**
+         * Number of frames dropped so far by the QueuePolicy (see WrapperStructInput::queuePolicy).
+         */
+        unsigned long long getNumberDroppedFrames() const;
+
     private:
         const ThreadManagerMode mThreadManagerMode;
         const std::shared_ptr<std::pair<std::atomic<bool>, std::atomic<int>>> spVideoSeek;
@@ -211,6 +246,7 @@ namespace op
         bool mUserOutputWsOnNewThread;
         unsigned long long mThreadId;
         bool mMultiThreadEnabled;
+        QueuePolicy mInputQueuePolicy;
         // Workers
         std::vector<TWorker> mUserInputWs;
         TWorker wDatumProducer;
@@ -269,6 +305,7 @@ namespace op
 #include <openpose/hand/headers.hpp>
 #include <openpose/pose/headers.hpp>
 #include <openpose/producer/headers.hpp>
+#include <openpose/utilities/fastMath.hpp>
 #include <openpose/utilities/fileSystem.hpp>
 #include <openpose/utilities/standard.hpp>
 #include <openpose/wrapper/wrapperAuxiliary.hpp>
@@ -280,7 +317,8 @@ namespace op
         spVideoSeek{std::make_shared<std::pair<std::atomic<bool>, std::atomic<int>>>()},
         mConfigured{false},
         mThreadManager{threadManagerMode},
-        mMultiThreadEnabled{true}
+        mMultiThreadEnabled{true},
+        mInputQueuePolicy{QueuePolicy::Block}
     {
         try
         {
@@ -321,6 +359,61 @@ namespace op
         }
     }
 
+    template<typename TDatums, typename TWorker, typename TQueue>
+    void Wrapper<TDatums, TWorker, TQueue>::enableThreadPool(const int numberThreads)
+    {
+        try
+        {
+            mThreadManager.enableThreadPool(numberThreads);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    template<typename TDatums, typename TWorker, typename TQueue>
+    void Wrapper<TDatums, TWorker, TQueue>::enableMetrics(const std::string& filePath,
+                                                          const double dumpIntervalSeconds)
+    {
+        try
+        {
+            Metrics::enable(filePath, dumpIntervalSeconds);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    template<typename TDatums, typename TWorker, typename TQueue>
+    std::string Wrapper<TDatums, TWorker, TQueue>::getMetrics() const
+    {
+        try
+        {
+            return Metrics::toJson();
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return "";
+        }
+    }
+
+    template<typename TDatums, typename TWorker, typename TQueue>
+    void Wrapper<TDatums, TWorker, TQueue>::enableTracing(const std::string& filePath,
+                                                          const unsigned long long maxEventsPerThread)
+    {
+        try
+        {
+            Tracer::enable(filePath, maxEventsPerThread);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
     template<typename TDatums, typename TWorker, typename TQueue>
     void Wrapper<TDatums, TWorker, TQueue>::setWorkerInput(const TWorker& worker, const bool workerOnNewThread)
     {
@@ -533,10 +626,12 @@ namespace op
             }
             else
                 wDatumProducer = nullptr;
+            mInputQueuePolicy = wrapperStructInput.queuePolicy;
 
             std::vector<std::shared_ptr<PoseExtractorNet>> poseExtractorNets;
             std::vector<std::shared_ptr<PoseGpuRenderer>> poseGpuRenderers;
             std::shared_ptr<PoseCpuRenderer> poseCpuRenderer;
+            auto netBatchSize = 1;
             if (numberThreads > 0)
             {
                 // Get input scales and sizes
@@ -561,12 +656,28 @@ namespace op
                 spWPoseExtractors.resize(numberThreads);
                 if (wrapperStructPose.enable)
                 {
-                    // Pose estimators
+                    // Adaptive tracking interval
+                    const auto poseNetScheduler = (wrapperStructPose.tracking > 0
+                                                   && wrapperStructPose.trackingMaxDisplacement > 0.f
+                        ? std::make_shared<PoseNetScheduler>(wrapperStructPose.tracking,
+                                                             wrapperStructPose.trackingMaxDisplacement)
+                        : nullptr);
+                    // Batched net forward pass (not with the adaptive tracking, which decides frame by frame)
+                    netBatchSize = fastMax(1, wrapperStructPose.netBatchSize);
+                    if (netBatchSize > 1 && poseNetScheduler)
+                    {
+                        log("`netBatchSize` ignored, it is not compatible with the adaptive tracking"
+                            " (`trackingMaxDisplacement`).", Priority::High);
+                        netBatchSize = 1;
+                    }
+                    // Pose estimators (net cache pre-warmed with the batch size of the forward passes)
                     for (auto gpuId = 0; gpuId < numberThreads; gpuId++)
                         poseExtractorNets.emplace_back(std::make_shared<PoseExtractorCaffe>(
                             wrapperStructPose.poseModel, modelFolder, gpuId + gpuNumberStart,
                             wrapperStructPose.heatMapTypes, wrapperStructPose.heatMapScale,
-                            wrapperStructPose.addPartCandidates, wrapperStructPose.enableGoogleLogging
+                            wrapperStructPose.addPartCandidates, wrapperStructPose.enableGoogleLogging,
+                            wrapperStructPose.nmsCoarseToFine, wrapperStructPose.netCacheSize,
+                            wrapperStructPose.netCacheResolutions, netBatchSize
                         ));
 
                     // Pose renderers
@@ -626,8 +737,9 @@ namespace op
                         //    + ID extractor (experimental) + tracking (experimental)
                         const auto poseExtractor = std::make_shared<PoseExtractor>(
                             poseExtractorNets.at(i), keepTopNPeople, personIdExtractor, personTrackers,
-                            wrapperStructPose.numberPeopleMax, wrapperStructPose.tracking);
-                        spWPoseExtractors.at(i) = {std::make_shared<WPoseExtractor<TDatumsPtr>>(poseExtractor)};
+                            wrapperStructPose.numberPeopleMax, wrapperStructPose.tracking, poseNetScheduler);
+                        spWPoseExtractors.at(i) = {std::make_shared<WPoseExtractor<TDatumsPtr>>(
+                            poseExtractor, netBatchSize)};
                         // // Just OpenPose keypoint detector
                         // spWPoseExtractors.at(i) = {std::make_shared<WPoseExtractorNet<TDatumsPtr>>(
                         //     poseExtractorNets.at(i))};
@@ -818,7 +930,37 @@ namespace op
                 mPostProcessingWs.clear();
                 // Frame buffer and ordering
                 if (spWPoseExtractors.size() > 1u)
-                    mPostProcessingWs.emplace_back(std::make_shared<WQueueOrderer<TDatumsPtr>>());
+                {
+                    // Each WPoseExtractor holds up to netBatchSize frames, so a whole batch of a GPU can arrive
+                    // while the other GPUs are still filling theirs
+                    const auto framesInFlight = (unsigned int)(netBatchSize * spWPoseExtractors.size());
+                    // Dropped frames -> lost IDs, which are never received. They are skipped after the time of
+                    // framesInFlight frames (or 4 * framesInFlight frames arrive), so the output latency stays
+                    // bounded under sustained dropping
+                    if (mInputQueuePolicy != QueuePolicy::Block)
+                    {
+                        const auto producerFps = (wrapperStructInput.producerSharedPtr != nullptr
+                            ? wrapperStructInput.producerSharedPtr->get(CV_CAP_PROP_FPS) : -1.);
+                        const auto framePeriodMs = 1000. / (producerFps > 0. ? producerFps : 30.);
+                        mPostProcessingWs.emplace_back(std::make_shared<WQueueOrderer<TDatumsPtr>>(
+                            4u * framesInFlight, framesInFlight * framePeriodMs));
+                    }
+                    else
+                        mPostProcessingWs.emplace_back(std::make_shared<WQueueOrderer<TDatumsPtr>>(
+                            fastMax(64u, 2u * framesInFlight)));
+                }
+                // Keypoint temporal smoothing and gap filling (it requires the frames to be sorted)
+                if (wrapperStructPose.filterKeypoints)
+                {
+                    if (!wrapperStructPose.identification)
+                        log("`filterKeypoints` without `identification` keeps the state of each person by their"
+                            " index in the frame, so different people might be blended when several are detected."
+                            " Enable `identification` for multi-person videos.", Priority::High);
+                    const auto fps = (wrapperStructInput.producerSharedPtr != nullptr
+                                      ? (float)wrapperStructInput.producerSharedPtr->get(CV_CAP_PROP_FPS) : -1.f);
+                    const auto keypointFilter = std::make_shared<KeypointFilter>(fps);
+                    mPostProcessingWs.emplace_back(std::make_shared<WKeypointFilter<TDatumsPtr>>(keypointFilter));
+                }
                 // // Person ID identification (when no multi-thread and no dependency on tracking)
                 // if (wrapperStructPose.identification)
                 // {
@@ -902,8 +1044,12 @@ namespace op
                 const auto originalVideoFps = (wrapperStructOutput.writeVideoFps > 0 ?
                                                 wrapperStructOutput.writeVideoFps
                                                 : wrapperStructInput.producerSharedPtr->get(CV_CAP_PROP_FPS));
+                // Frames encoded on a separate thread (without dropping frames, i.e., it only blocks if the
+                // encoder falls more than asyncQueueSize frames behind)
+                const auto asyncQueueSize = 32u;
                 const auto videoSaver = std::make_shared<VideoSaver>(
-                    wrapperStructOutput.writeVideo, CV_FOURCC('M','J','P','G'), originalVideoFps, finalOutputSize
+                    wrapperStructOutput.writeVideo, CV_FOURCC('M','J','P','G'), originalVideoFps, finalOutputSize,
+                    asyncQueueSize
                 );
                 mOutputWs.emplace_back(std::make_shared<WVideoSaver<TDatumsPtr>>(videoSaver));
             }
@@ -1133,6 +1279,20 @@ namespace op
         }
     }
 
+    template<typename TDatums, typename TWorker, typename TQueue>
+    unsigned long long Wrapper<TDatums, TWorker, TQueue>::getNumberDroppedFrames() const
+    {
+        try
+        {
+            return mThreadManager.getNumberDropped();
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return 0ull;
+        }
+    }
+
     template<typename TDatums, typename TWorker, typename TQueue>
     void Wrapper<TDatums, TWorker, TQueue>::reset()
     {
@@ -1244,6 +1404,9 @@ namespace op
             // Thread 1 or 2...X, queues 1 -> 2, X = 2 + #GPUs
             if (!spWPoseExtractors.empty())
             {
+                // Real-time sources: frames dropped before the (slow) pose extraction if it falls behind
+                if (mInputQueuePolicy != QueuePolicy::Block)
+                    mThreadManager.setQueuePolicy(queueIn, mInputQueuePolicy);
                 if (mMultiThreadEnabled)
                 {
                     for (auto& wPose : spWPoseExtractors)
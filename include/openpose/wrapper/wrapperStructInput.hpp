@@ -3,6 +3,7 @@
 
 #include <openpose/core/common.hpp>
 #include <openpose/producer/producer.hpp>
+#include <openpose/thread/enumClasses.hpp>
 
 namespace op
 {
@@ -51,6 +52,14 @@ namespace op
          */
         bool framesRepeat;
 
+        /**
+         * What to do with the new frames if the pose extraction queue is full, i.e. if OpenPose is slower than the
+         * frames producer (see QueuePolicy).
+         * QueuePolicy::Block (default) processes all frames, the dropping ones bound the latency of real-time
+         * sources (e.g. webcam or IP camera) during processing load spikes.
+         */
+        QueuePolicy queuePolicy;
+
         /**
          * Constructor of the struct.
          * It has the recommended and default values we recommend for each element of the struct.
@@ -59,7 +68,8 @@ namespace op
         WrapperStructInput(const std::shared_ptr<Producer> producerSharedPtr = nullptr,
                            const unsigned long long frameFirst = 0, const unsigned long long frameLast = -1,
                            const bool realTimeProcessing = false, const bool frameFlip = false,
-                           const int frameRotate = 0, const bool framesRepeat = false);
+                           const int frameRotate = 0, const bool framesRepeat = false,
+                           const QueuePolicy queuePolicy = QueuePolicy::Block);
     };
 }
 
@@ -193,6 +193,48 @@ namespace op
          */
         int tracking;
 
+        /**
+         * Whether to smooth the body keypoints across frames (One-Euro filter) and fill the keypoints missed during a
+         * few frames (see KeypointFilter). It reduces the jitter of lower net resolutions.
+         */
+        bool filterKeypoints;
+
+        /**
+         * Adaptive tracking (see PoseNetScheduler), only if `tracking` > 0. If positive, `tracking` becomes the
+         * maximum number of consecutive frames filled by the tracker, and the net is run earlier if the keypoints are
+         * expected to have moved more than trackingMaxDisplacement pixels since the last net frame.
+         * Select -1 (default) to disable it (i.e., the net is run every `tracking` + 1 frames).
+         */
+        float trackingMaxDisplacement;
+
+        /**
+         * Whether to run the NMS and body part connection on the net output, only upsampling it around the peak
+         * candidates (see PoseExtractorCaffe). Faster but approximated. Only applicable to the CPU version with 1
+         * scale and no heat maps output.
+         */
+        bool nmsCoarseToFine;
+
+        /**
+         * Number of frames run in the same net forward pass (see WPoseExtractor). Only for offline processing (e.g.,
+         * recorded videos), since the frames are delayed until the batch is complete. It increases the throughput
+         * (mainly in the CPU version) at the cost of latency. Ignored if the adaptive tracking is enabled
+         * (`trackingMaxDisplacement`).
+         * Select 1 (default) to process each frame as soon as it arrives.
+         */
+        int netBatchSize;
+
+        /**
+         * Number of net input sizes kept reshaped (see NetCaffe). It avoids reshaping the net every time the input
+         * size changes among them (e.g., image directories with different aspect ratios and -1 in netInputSize), at
+         * the cost of the memory of the net intermediate blobs of each one (the weights are shared).
+         */
+        int netCacheSize;
+
+        /**
+         * Net input sizes reshaped (and cached) when the net is initialized, rather than on their first frame.
+         */
+        std::vector<Point<int>> netCacheResolutions;
+
         /**
          * Constructor of the struct.
          * It has the recommended and default values we recommend for each element of the struct.
@@ -212,7 +254,10 @@ namespace op
                           const float renderThreshold = 0.05f, const int numberPeopleMax = -1,
                           const bool enableGoogleLogging = true, const bool reconstruct3d = false,
                           const int minViews3d = -1, const bool identification = false,
-                          const int tracking = -1);
+                          const int tracking = -1, const bool filterKeypoints = false,
+                          const float trackingMaxDisplacement = -1.f, const bool nmsCoarseToFine = false,
+                          const int netBatchSize = 1, const int netCacheSize = 1,
+                          const std::vector<Point<int>>& netCacheResolutions = {});
     };
 }
 
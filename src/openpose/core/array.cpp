@@ -13,6 +13,7 @@
 //        https://stackoverflow.com/questions/30780262/accessing-array-of-shared-ptr
 //     b) Default delete:
 //        https://stackoverflow.com/questions/13061979/shared-ptr-to-an-array-should-it-be-used
+// Array<T> uses a custom deleter that returns the memory to its ArrayAllocator.
 
 namespace op
 {
@@ -73,7 +74,9 @@ namespace op
         mSize{array.mSize},
         mVolume{array.mVolume},
         spData{array.spData},
-        mCvMatData{array.mCvMatData}
+        mCvMatData{array.mCvMatData},
+        spAllocator{array.spAllocator},
+        spDataAllocator{array.spDataAllocator}
     {
     }
 
@@ -86,6 +89,8 @@ namespace op
             mVolume = array.mVolume;
             spData = array.spData;
             mCvMatData = array.mCvMatData;
+            spAllocator = array.spAllocator;
+            spDataAllocator = array.spDataAllocator;
             // Return
             return *this;
         }
@@ -105,6 +110,8 @@ namespace op
         {
             std::swap(spData, array.spData);
             std::swap(mCvMatData, array.mCvMatData);
+            std::swap(spAllocator, array.spAllocator);
+            std::swap(spDataAllocator, array.spDataAllocator);
         }
         catch (const std::exception& e)
         {
@@ -121,6 +128,8 @@ namespace op
             mVolume = array.mVolume;
             std::swap(spData, array.spData);
             std::swap(mCvMatData, array.mCvMatData);
+            std::swap(spAllocator, array.spAllocator);
+            std::swap(spDataAllocator, array.spDataAllocator);
             // Return
             return *this;
         }
@@ -136,8 +145,10 @@ namespace op
     {
         try
         {
-            // Constructor
-            Array<T> array{mSize};
+            // Constructor (same allocator)
+            Array<T> array;
+            array.setAllocator(spAllocator);
+            array.reset(mSize);
             // Clone data
             std::copy(spData.get(), spData.get() + mVolume, array.spData.get());
             // Return
@@ -175,9 +186,32 @@ namespace op
             {
                 // New size & volume
                 mSize = sizes;
-                mVolume = {std::accumulate(sizes.begin(), sizes.end(), 1ul, std::multiplies<size_t>())};
-                // Prepare shared_ptr
-                spData.reset(new T[mVolume], std::default_delete<T[]>());
+                const auto newVolume = std::accumulate(sizes.begin(), sizes.end(), 1ul, std::multiplies<size_t>());
+                // Prepare shared_ptr (current memory re-used if same volume, allocator and not shared with other
+                // Arrays)
+                const auto allocator = (spAllocator != nullptr ? spAllocator : ArrayAllocator::getDefault());
+                if (spData == nullptr || spData.use_count() != 1 || mVolume != newVolume
+                    || spDataAllocator != allocator)
+                {
+                    // Released before allocating the new memory (lower peak usage)
+                    spData.reset();
+                    const auto numberBytes = newVolume * sizeof(T);
+                    spData.reset((T*)allocator->allocate(numberBytes),
+                                 [allocator, numberBytes](T* const dataPtr)
+                                 {
+                                     try
+                                     {
+                                         allocator->deallocate(dataPtr, numberBytes);
+                                     }
+                                     catch (const std::exception& e)
+                                     {
+                                         // Deleters must not throw (std::terminate), the memory is just not released
+                                         log(e.what(), Priority::High, __LINE__, __FUNCTION__, __FILE__);
+                                     }
+                                 });
+                    spDataAllocator = allocator;
+                }
+                mVolume = newVolume;
                 setCvMatFromSharedPtr();
             }
             else
@@ -185,6 +219,7 @@ namespace op
                 mSize = {};
                 mVolume = 0ul;
                 spData.reset();
+                spDataAllocator.reset();
                 // cv::Mat available but empty
                 mCvMatData = std::make_pair(true, cv::Mat());
             }
@@ -251,6 +286,44 @@ namespace op
         }
     }
 
+    template<typename T>
+    void Array<T>::wrap(const std::vector<int>& sizes, T* const dataPtr)
+    {
+        try
+        {
+            if (dataPtr == nullptr && !sizes.empty())
+                error("Null dataPtr.", __LINE__, __FUNCTION__, __FILE__);
+            if (!sizes.empty())
+            {
+                mSize = sizes;
+                mVolume = {std::accumulate(sizes.begin(), sizes.end(), 1ul, std::multiplies<size_t>())};
+                // Not owned -> no-op deleter
+                spData.reset(dataPtr, [](T* const) {});
+                spDataAllocator.reset();
+                setCvMatFromSharedPtr();
+            }
+            else
+                reset();
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    template<typename T>
+    void Array<T>::setAllocator(const std::shared_ptr<ArrayAllocator>& allocator)
+    {
+        try
+        {
+            spAllocator = allocator;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
     template<typename T>
     void Array<T>::setTo(const T value)
     {
@@ -0,0 +1,110 @@
+#include <atomic>
+#include <new> // std::bad_alloc
+#ifdef _WIN32
+    #include <malloc.h> // _aligned_malloc, _aligned_free
+#else
+    #include <cstdlib> // posix_memalign, std::free
+#endif
+#include <openpose/utilities/errorAndLog.hpp>
+#include <openpose/utilities/fastMath.hpp>
+#include <openpose/core/arrayAllocator.hpp>
+
+namespace op
+{
+    // Default allocator (nullptr = AlignedArrayAllocator), read with std::atomic_load on every Array allocation
+    std::shared_ptr<ArrayAllocator> spDefaultArrayAllocator;
+
+    std::shared_ptr<ArrayAllocator> getAlignedArrayAllocator()
+    {
+        // Never destroyed, so Arrays released during the static destruction can still use it
+        static const auto* const spAlignedArrayAllocator = new std::shared_ptr<ArrayAllocator>{
+            std::make_shared<AlignedArrayAllocator>()};
+        return *spAlignedArrayAllocator;
+    }
+
+    ArrayAllocator::~ArrayAllocator()
+    {
+    }
+
+    std::shared_ptr<ArrayAllocator> ArrayAllocator::getDefault()
+    {
+        try
+        {
+            const auto spAllocator = std::atomic_load(&spDefaultArrayAllocator);
+            return (spAllocator != nullptr ? spAllocator : getAlignedArrayAllocator());
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return nullptr;
+        }
+    }
+
+    void ArrayAllocator::setDefault(const std::shared_ptr<ArrayAllocator>& allocator)
+    {
+        try
+        {
+            std::atomic_store(&spDefaultArrayAllocator, allocator);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    AlignedArrayAllocator::AlignedArrayAllocator(const size_t alignment) :
+        mAlignment{alignment}
+    {
+        try
+        {
+            if (mAlignment < sizeof(void*) || (mAlignment & (mAlignment - 1)) != 0 || mAlignment % sizeof(void*) != 0)
+                error("Alignment must be a power of 2 and multiple of sizeof(void*).",
+                      __LINE__, __FUNCTION__, __FILE__);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    void* AlignedArrayAllocator::allocate(const size_t numberBytes)
+    {
+        try
+        {
+            // Non-null pointer also for 0 bytes (as new T[0])
+            const auto numberBytesNonZero = fastMax(numberBytes, size_t(1));
+            #ifdef _WIN32
+                auto* memoryPtr = _aligned_malloc(numberBytesNonZero, mAlignment);
+            #else
+                void* memoryPtr = nullptr;
+                if (posix_memalign(&memoryPtr, mAlignment, numberBytesNonZero) != 0)
+                    memoryPtr = nullptr;
+            #endif
+            if (memoryPtr == nullptr)
+                throw std::bad_alloc{};
+            return memoryPtr;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return nullptr;
+        }
+    }
+
+    void AlignedArrayAllocator::deallocate(void* const memoryPtr, const size_t numberBytes)
+    {
+        try
+        {
+            UNUSED(numberBytes);
+            #ifdef _WIN32
+                _aligned_free(memoryPtr);
+            #else
+                std::free(memoryPtr);
+            #endif
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+}
@@ -1,5 +1,6 @@
 #include <openpose/utilities/fastMath.hpp>
 #include <openpose/utilities/openCv.hpp>
+#include <openpose/thread/threadPool.hpp>
 #include <openpose/core/cvMatToOpInput.hpp>
 
 namespace op
@@ -12,6 +13,23 @@ namespace op
     std::vector<Array<float>> CvMatToOpInput::createArray(const cv::Mat& cvInputData,
                                                           const std::vector<double>& scaleInputToNetInputs,
                                                           const std::vector<Point<int>>& netInputSizes) const
+    {
+        try
+        {
+            std::vector<Array<float>> inputNetData;
+            createArray(inputNetData, cvInputData, scaleInputToNetInputs, netInputSizes);
+            return inputNetData;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return {};
+        }
+    }
+
+    void CvMatToOpInput::createArray(std::vector<Array<float>>& inputNetData, const cv::Mat& cvInputData,
+                                     const std::vector<double>& scaleInputToNetInputs,
+                                     const std::vector<Point<int>>& netInputSizes) const
     {
         try
         {
@@ -24,22 +42,26 @@ namespace op
                 error("scaleInputToNetInputs.size() != netInputSizes.size().", __LINE__, __FUNCTION__, __FILE__);
             // inputNetData - Reescale keeping aspect ratio and transform to float the input deep net image
             const auto numberScales = (int)scaleInputToNetInputs.size();
-            std::vector<Array<float>> inputNetData(numberScales);
+            // Array::reset() re-uses the memory of each scale if its size did not change
+            inputNetData.resize(numberScales);
             for (auto i = 0u ; i < inputNetData.size() ; i++)
-            {
                 inputNetData[i].reset({1, 3, netInputSizes.at(i).y, netInputSizes.at(i).x});
-                std::vector<double> scaleRatios(numberScales, 1.f);
-                const cv::Mat frameWithNetSize = resizeFixedAspectRatio(cvInputData, scaleInputToNetInputs[i],
-                                                                        netInputSizes[i]);
-                // Fill inputNetData[i]
-                uCharCvMatToFloatPtr(inputNetData[i].getPtr(), frameWithNetSize, (mPoseModel == PoseModel::BODY_19N ? 2 : 1));
-            }
-            return inputNetData;
+            // Each scale is independent -> split among the ThreadPool threads (if enabled)
+            parallelFor(numberScales, [&](const int startScale, const int endScale)
+            {
+                for (auto i = startScale ; i < endScale ; i++)
+                {
+                    const cv::Mat frameWithNetSize = resizeFixedAspectRatio(cvInputData, scaleInputToNetInputs[i],
+                                                                            netInputSizes[i]);
+                    // Fill inputNetData[i]
+                    uCharCvMatToFloatPtr(inputNetData[i].getPtr(), frameWithNetSize,
+                                         (mPoseModel == PoseModel::BODY_19N ? 2 : 1));
+                }
+            });
         }
         catch (const std::exception& e)
         {
             error(e.what(), __LINE__, __FUNCTION__, __FILE__);
-            return {};
         }
     }
 }
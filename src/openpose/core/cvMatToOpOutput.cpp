@@ -4,6 +4,22 @@
 namespace op
 {
     Array<float> CvMatToOpOutput::createArray(const cv::Mat& cvInputData, const double scaleInputToOutput, const Point<int>& outputResolution) const
+    {
+        try
+        {
+            Array<float> outputData;
+            createArray(outputData, cvInputData, scaleInputToOutput, outputResolution);
+            return outputData;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return Array<float>{};
+        }
+    }
+
+    void CvMatToOpOutput::createArray(Array<float>& outputData, const cv::Mat& cvInputData,
+                                      const double scaleInputToOutput, const Point<int>& outputResolution) const
     {
         try
         {
@@ -19,15 +35,13 @@ namespace op
             // outputData - Reescale keeping aspect ratio and transform to float the output image
             const cv::Mat frameWithOutputSize = resizeFixedAspectRatio(cvInputData, scaleInputToOutput,
                                                                        outputResolution);
-            Array<float> outputData({3, outputResolution.y, outputResolution.x});
+            // Array::reset() re-uses the memory of outputData if its size did not change
+            outputData.reset({3, outputResolution.y, outputResolution.x});
             uCharCvMatToFloatPtr(outputData.getPtr(), frameWithOutputSize, false);
-            // Return result
-            return outputData;
         }
         catch (const std::exception& e)
         {
             error(e.what(), __LINE__, __FUNCTION__, __FILE__);
-            return Array<float>{};
         }
     }
 }
@@ -23,6 +23,8 @@ namespace op
         poseKeypoints{datum.poseKeypoints},
         poseIds{datum.poseIds},
         poseScores{datum.poseScores},
+        repetitionCounts{datum.repetitionCounts},
+        repetitionEvents{datum.repetitionEvents},
         poseHeatMaps{datum.poseHeatMaps},
         poseCandidates{datum.poseCandidates},
         faceRectangles{datum.faceRectangles},
@@ -62,6 +64,8 @@ namespace op
             poseKeypoints = datum.poseKeypoints;
             poseIds = datum.poseIds,
             poseScores = datum.poseScores,
+            repetitionCounts = datum.repetitionCounts,
+            repetitionEvents = datum.repetitionEvents,
             poseHeatMaps = datum.poseHeatMaps,
             poseCandidates = datum.poseCandidates,
             faceRectangles = datum.faceRectangles,
@@ -112,6 +116,8 @@ namespace op
             std::swap(poseKeypoints, datum.poseKeypoints);
             std::swap(poseIds, datum.poseIds);
             std::swap(poseScores, datum.poseScores);
+            std::swap(repetitionCounts, datum.repetitionCounts);
+            std::swap(repetitionEvents, datum.repetitionEvents);
             std::swap(poseHeatMaps, datum.poseHeatMaps);
             std::swap(poseCandidates, datum.poseCandidates);
             std::swap(faceRectangles, datum.faceRectangles);
@@ -153,6 +159,8 @@ namespace op
             std::swap(poseKeypoints, datum.poseKeypoints);
             std::swap(poseIds, datum.poseIds);
             std::swap(poseScores, datum.poseScores);
+            std::swap(repetitionCounts, datum.repetitionCounts);
+            std::swap(repetitionEvents, datum.repetitionEvents);
             std::swap(poseHeatMaps, datum.poseHeatMaps);
             std::swap(poseCandidates, datum.poseCandidates);
             std::swap(faceRectangles, datum.faceRectangles);
@@ -204,6 +212,8 @@ namespace op
             datum.poseKeypoints = poseKeypoints.clone();
             datum.poseIds = poseIds.clone();
             datum.poseScores = poseScores.clone();
+            datum.repetitionCounts = repetitionCounts.clone();
+            datum.repetitionEvents = repetitionEvents;
             datum.poseHeatMaps = poseHeatMaps.clone();
             datum.poseCandidates = poseCandidates;
             datum.faceRectangles = faceRectangles;
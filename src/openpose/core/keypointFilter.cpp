@@ -0,0 +1,169 @@
+#include <algorithm> // std::fill_n
+#include <cmath> // std::abs
+#include <openpose/utilities/fastMath.hpp>
+#include <openpose/core/keypointFilter.hpp>
+
+namespace op
+{
+    const auto TWO_PI = 6.283185307f;
+
+    inline float getSmoothingFactor(const float cutoff, const float rate)
+    {
+        // alpha = 1 / (1 + tau/Te), with tau = 1/(2*pi*cutoff) and Te = 1/rate
+        return 1.f / (1.f + rate / (TWO_PI * cutoff));
+    }
+
+    KeypointFilter::KeypointFilter(const float fps, const float minCutoff, const float beta,
+                                   const float derivativeCutoff, const int maxGapFrames,
+                                   const int numberFramesToDeletePerson) :
+        mFps{(fps > 0.f ? fps : 30.f)},
+        mMinCutoff{minCutoff},
+        mBeta{beta},
+        mDerivativeCutoff{derivativeCutoff},
+        mMaxGapFrames{(unsigned long long)fastMax(0, maxGapFrames)},
+        mNumberFramesToDeletePerson{(unsigned long long)fastMax(1, numberFramesToDeletePerson)},
+        mLastEvictionFrameNumber{0ull}
+    {
+        try
+        {
+            if (mMinCutoff <= 0.f || mDerivativeCutoff <= 0.f || mBeta < 0.f)
+                error("The cutoff frequencies must be positive and beta non-negative.",
+                      __LINE__, __FUNCTION__, __FILE__);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    void KeypointFilter::filter(Array<float>& keypoints, const Array<long long>& poseIds,
+                                const unsigned long long frameNumber, const unsigned int viewIndex)
+    {
+        try
+        {
+            if (mViewStates.size() <= viewIndex)
+                mViewStates.resize(viewIndex+1);
+            // Remove people not detected in the last frames
+            if (frameNumber >= mLastEvictionFrameNumber + mNumberFramesToDeletePerson)
+            {
+                for (auto& viewState : mViewStates)
+                {
+                    for (auto iterator = viewState.slots.begin() ; iterator != viewState.slots.end() ; )
+                    {
+                        if (viewState.lastFrameNumbers[iterator->second] + mNumberFramesToDeletePerson < frameNumber)
+                        {
+                            viewState.freeSlots.emplace_back(iterator->second);
+                            iterator = viewState.slots.erase(iterator);
+                        }
+                        else
+                            iterator++;
+                    }
+                }
+                mLastEvictionFrameNumber = frameNumber;
+            }
+            if (!keypoints.empty())
+            {
+                const auto numberPeople = keypoints.getSize(0);
+                const auto numberBodyParts = keypoints.getSize(1);
+                const auto useIds = (poseIds.getVolume() == (size_t)numberPeople && poseIds[0] > -1);
+                auto& viewState = mViewStates[viewIndex];
+                // Different pose model (e.g., new producer) --> previous state not applicable
+                if (viewState.numberBodyParts != numberBodyParts)
+                {
+                    viewState = ViewState{};
+                    viewState.numberBodyParts = numberBodyParts;
+                }
+                for (auto person = 0 ; person < numberPeople ; person++)
+                {
+                    const auto personId = (useIds ? poseIds[person] : (long long)person);
+                    const auto slot = getSlot(viewState, personId);
+                    viewState.lastFrameNumbers[slot] = frameNumber;
+                    auto* keypointsPtr = keypoints.getPtr() + person * numberBodyParts * keypoints.getSize(2);
+                    auto* positionsPtr = &viewState.positions[2*slot*numberBodyParts];
+                    auto* derivativesPtr = &viewState.derivatives[2*slot*numberBodyParts];
+                    auto* scoresPtr = &viewState.scores[slot*numberBodyParts];
+                    auto* lastDetectionsPtr = &viewState.lastDetectionFrameNumbers[slot*numberBodyParts];
+                    // Branchless over the body parts: the filtered position is always computed, and each body part
+                    // then selects between filtering, (re-)initializing, gap filling, or keeping its state
+                    for (auto part = 0 ; part < numberBodyParts ; part++)
+                    {
+                        auto* keypointPtr = keypointsPtr + 3*part;
+                        auto* positionPtr = positionsPtr + 2*part;
+                        auto* derivativePtr = derivativesPtr + 2*part;
+                        const auto lastDetectionFrameNumber = lastDetectionsPtr[part];
+                        const auto framesSinceDetection = frameNumber + 1 - lastDetectionFrameNumber;
+                        const auto numberGapFrames = framesSinceDetection - 1;
+                        const auto recentlyDetected = (lastDetectionFrameNumber > 0
+                                                       && numberGapFrames <= mMaxGapFrames);
+                        const auto detected = (keypointPtr[2] > 0.f);
+                        // Detected keypoint: filter from the last position if it was recently detected, otherwise
+                        // (re-)initialize it
+                        const auto smooth = (detected && recentlyDetected);
+                        const auto gapFill = (!detected && recentlyDetected && numberGapFrames < mMaxGapFrames);
+                        const auto rate = mFps / float(framesSinceDetection);
+                        const auto derivativeAlpha = getSmoothingFactor(mDerivativeCutoff, rate);
+                        for (auto xy = 0 ; xy < 2 ; xy++)
+                        {
+                            const auto derivative = derivativePtr[xy] + derivativeAlpha
+                                                  * ((keypointPtr[xy] - positionPtr[xy]) * rate - derivativePtr[xy]);
+                            const auto cutoff = mMinCutoff + mBeta * std::abs(derivative);
+                            const auto position = positionPtr[xy] + getSmoothingFactor(cutoff, rate)
+                                                * (keypointPtr[xy] - positionPtr[xy]);
+                            positionPtr[xy] = (smooth ? position : (detected ? keypointPtr[xy] : positionPtr[xy]));
+                            derivativePtr[xy] = (smooth ? derivative : (detected ? 0.f : derivativePtr[xy]));
+                            keypointPtr[xy] = (detected || gapFill ? positionPtr[xy] : keypointPtr[xy]);
+                        }
+                        keypointPtr[2] = (gapFill ? scoresPtr[part] : keypointPtr[2]);
+                        scoresPtr[part] = (detected ? keypointPtr[2] : scoresPtr[part]);
+                        lastDetectionsPtr[part] = (detected ? frameNumber + 1 : lastDetectionFrameNumber);
+                    }
+                }
+            }
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    unsigned int KeypointFilter::getSlot(ViewState& viewState, const long long personId)
+    {
+        try
+        {
+            const auto slotIterator = viewState.slots.find(personId);
+            if (slotIterator != viewState.slots.end())
+                return slotIterator->second;
+            // New person: reuse the slot of an evicted one, or append a new one
+            unsigned int slot;
+            const auto numberBodyParts = viewState.numberBodyParts;
+            if (!viewState.freeSlots.empty())
+            {
+                slot = viewState.freeSlots.back();
+                viewState.freeSlots.pop_back();
+                std::fill_n(viewState.positions.begin() + 2*slot*numberBodyParts, 2*numberBodyParts, 0.f);
+                std::fill_n(viewState.derivatives.begin() + 2*slot*numberBodyParts, 2*numberBodyParts, 0.f);
+                std::fill_n(viewState.scores.begin() + slot*numberBodyParts, numberBodyParts, 0.f);
+                std::fill_n(viewState.lastDetectionFrameNumbers.begin() + slot*numberBodyParts, numberBodyParts,
+                            0ull);
+            }
+            else
+            {
+                slot = (unsigned int)viewState.lastFrameNumbers.size();
+                viewState.lastFrameNumbers.emplace_back(0ull);
+                viewState.positions.resize(viewState.positions.size() + 2*numberBodyParts, 0.f);
+                viewState.derivatives.resize(viewState.derivatives.size() + 2*numberBodyParts, 0.f);
+                viewState.scores.resize(viewState.scores.size() + numberBodyParts, 0.f);
+                // 0 = never detected (frame numbers are stored + 1)
+                viewState.lastDetectionFrameNumbers.resize(
+                    viewState.lastDetectionFrameNumbers.size() + numberBodyParts, 0ull);
+            }
+            viewState.slots.emplace(personId, slot);
+            return slot;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return 0u;
+        }
+    }
+}
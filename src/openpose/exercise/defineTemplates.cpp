@@ -0,0 +1,6 @@
+#include <openpose/exercise/headers.hpp>
+
+namespace op
+{
+    DEFINE_TEMPLATE_DATUM(WExerciseCounter);
+}
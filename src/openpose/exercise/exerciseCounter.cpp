@@ -0,0 +1,271 @@
+#include <algorithm> // std::copy, std::fill, std::min_element
+#include <openpose/utilities/fastMath.hpp>
+#include <openpose/exercise/exerciseCounter.hpp>
+
+namespace op
+{
+    const auto INITIAL_CAPACITY = 64u;
+
+    inline std::size_t getPersonIdHash(const long long personId, const std::size_t capacity)
+    {
+        // Fibonacci hashing: consecutive IDs (the usual case) are spread over the whole table
+        auto hash = (unsigned long long)personId * 0x9E3779B97F4A7C15ull;
+        hash ^= (hash >> 32);
+        return (std::size_t)hash & (capacity - 1);
+    }
+
+    template<typename T>
+    inline void copySlot(std::vector<T>& destination, const std::vector<T>& source, const std::size_t destinationSlot,
+                         const std::size_t sourceSlot, const std::size_t slotSize)
+    {
+        std::copy(source.begin() + sourceSlot*slotSize, source.begin() + (sourceSlot+1)*slotSize,
+                  destination.begin() + destinationSlot*slotSize);
+    }
+
+    inline float getPersonScore(const Array<float>& poseKeypoints, const int person)
+    {
+        // Mean keypoint score
+        const auto numberBodyParts = poseKeypoints.getSize(1);
+        const auto* keypointsPtr = poseKeypoints.getConstPtr() + person * numberBodyParts * poseKeypoints.getSize(2);
+        auto score = 0.f;
+        for (auto part = 0 ; part < numberBodyParts ; part++)
+            score += keypointsPtr[3*part+2];
+        return score / fastMax(1, numberBodyParts);
+    }
+
+    ExerciseCounter::ExerciseCounter(const PoseModel poseModel, const std::string& exerciseFilePath,
+                                     const std::vector<std::string>& exerciseNames,
+                                     const int numberFramesToDeletePerson) :
+        mNumberFramesToDeletePerson{(unsigned long long)fastMax(1, numberFramesToDeletePerson)},
+        mExerciseRules{poseModel, exerciseFilePath, exerciseNames},
+        mNumberExercises{(unsigned int)mExerciseRules.getExerciseNames().size()},
+        mNumberPhases{mExerciseRules.getPhaseOffsets().back()},
+        mNumberTrackedPeople{0u},
+        mLastEvictionFrameNumber{0ull}
+    {
+        try
+        {
+            // Empty table
+            mPersonStates.resize(INITIAL_CAPACITY, PersonState{-1ll, 0ull});
+            mCounts.resize(INITIAL_CAPACITY * mNumberExercises, 0);
+            mNextPhases.resize(INITIAL_CAPACITY * mNumberExercises, 0u);
+            mLastPhaseFrameNumbers.resize(INITIAL_CAPACITY * mNumberExercises, 0ull);
+            mPhaseDurations.resize(INITIAL_CAPACITY * mNumberPhases, 0ull);
+            mPhaseScores.resize(INITIAL_CAPACITY * mNumberPhases, 0.f);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    Array<int> ExerciseCounter::count(const Array<float>& poseKeypoints, const Array<long long>& poseIds,
+                                      const unsigned long long frameNumber)
+    {
+        try
+        {
+            // Security checks
+            const auto numberPeople = (poseKeypoints.empty() ? 0 : poseKeypoints.getSize(0));
+            const auto useIds = (!poseIds.empty() && poseIds.getVolume() == (std::size_t)numberPeople
+                                 && (numberPeople == 0 || poseIds[0] > -1));
+            // Remove people not detected in the last frames
+            if (frameNumber >= mLastEvictionFrameNumber + mNumberFramesToDeletePerson)
+                evictStalePeople(frameNumber);
+            // Grow table if load factor > 0.5
+            if (2 * (mNumberTrackedPeople + numberPeople) > mPersonStates.size())
+            {
+                auto capacity = mPersonStates.size();
+                while (2 * (mNumberTrackedPeople + numberPeople) > capacity)
+                    capacity *= 2;
+                rehash(capacity, frameNumber);
+            }
+            // Update each person
+            mRepetitionEvents.clear();
+            Array<int> repetitionCounts;
+            if (numberPeople > 0)
+            {
+                repetitionCounts.reset({numberPeople, (int)mNumberExercises});
+                // Evaluate all phases of all exercises for all people at once
+                mExerciseRules.evaluate(mPhaseMatches, poseKeypoints);
+                const auto& phaseOffsets = mExerciseRules.getPhaseOffsets();
+                for (auto person = 0 ; person < numberPeople ; person++)
+                {
+                    const auto personId = (useIds ? poseIds[person] : (long long)person);
+                    const auto slot = findOrInsert(personId, frameNumber);
+                    auto* countPtr = &mCounts[slot * mNumberExercises];
+                    auto* nextPhasePtr = &mNextPhases[slot * mNumberExercises];
+                    auto* lastPhaseFrameNumberPtr = &mLastPhaseFrameNumbers[slot * mNumberExercises];
+                    auto* phaseDurationPtr = &mPhaseDurations[slot * mNumberPhases];
+                    auto* phaseScorePtr = &mPhaseScores[slot * mNumberPhases];
+                    for (auto exercise = 0u ; exercise < mNumberExercises ; exercise++)
+                    {
+                        // Advance if the next phase is matched, and count a repetition once all are matched
+                        const auto phase = phaseOffsets[exercise] + nextPhasePtr[exercise];
+                        if (mPhaseMatches[phase * numberPeople + person])
+                        {
+                            phaseDurationPtr[phase] = frameNumber - lastPhaseFrameNumberPtr[exercise];
+                            phaseScorePtr[phase] = getPersonScore(poseKeypoints, person);
+                            lastPhaseFrameNumberPtr[exercise] = frameNumber;
+                            nextPhasePtr[exercise]++;
+                            if (phaseOffsets[exercise] + nextPhasePtr[exercise] == phaseOffsets[exercise+1])
+                            {
+                                countPtr[exercise]++;
+                                nextPhasePtr[exercise] = 0u;
+                                mRepetitionEvents.emplace_back(RepetitionEvent{
+                                    mPersonStates[slot].personId, exercise, countPtr[exercise],
+                                    std::vector<unsigned long long>(phaseDurationPtr + phaseOffsets[exercise],
+                                                                    phaseDurationPtr + phaseOffsets[exercise+1]),
+                                    *std::min_element(phaseScorePtr + phaseOffsets[exercise],
+                                                      phaseScorePtr + phaseOffsets[exercise+1])
+                                });
+                            }
+                        }
+                        repetitionCounts[person*mNumberExercises + exercise] = countPtr[exercise];
+                    }
+                }
+            }
+            return repetitionCounts;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return Array<int>{};
+        }
+    }
+
+    const std::vector<RepetitionEvent>& ExerciseCounter::getRepetitionEvents() const
+    {
+        try
+        {
+            return mRepetitionEvents;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return mRepetitionEvents;
+        }
+    }
+
+    const std::vector<std::string>& ExerciseCounter::getExerciseNames() const
+    {
+        try
+        {
+            return mExerciseRules.getExerciseNames();
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return mExerciseRules.getExerciseNames();
+        }
+    }
+
+    unsigned int ExerciseCounter::getNumberTrackedPeople() const
+    {
+        try
+        {
+            return mNumberTrackedPeople;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return 0u;
+        }
+    }
+
+    std::size_t ExerciseCounter::findOrInsert(const long long personId, const unsigned long long frameNumber)
+    {
+        try
+        {
+            // Linear probing (the table is never full, load factor <= 0.5)
+            const auto mask = mPersonStates.size() - 1;
+            auto index = getPersonIdHash(personId, mPersonStates.size());
+            while (mPersonStates[index].personId != -1 && mPersonStates[index].personId != personId)
+                index = (index + 1) & mask;
+            auto& personState = mPersonStates[index];
+            // New person
+            if (personState.personId == -1)
+            {
+                personState.personId = personId;
+                std::fill(mCounts.begin() + index*mNumberExercises,
+                          mCounts.begin() + (index+1)*mNumberExercises, 0);
+                std::fill(mNextPhases.begin() + index*mNumberExercises,
+                          mNextPhases.begin() + (index+1)*mNumberExercises, 0u);
+                std::fill(mLastPhaseFrameNumbers.begin() + index*mNumberExercises,
+                          mLastPhaseFrameNumbers.begin() + (index+1)*mNumberExercises, frameNumber);
+                mNumberTrackedPeople++;
+            }
+            personState.lastFrameNumber = frameNumber;
+            return index;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return 0;
+        }
+    }
+
+    void ExerciseCounter::evictStalePeople(const unsigned long long frameNumber)
+    {
+        try
+        {
+            // Rebuilding the table is O(capacity), but it only happens once every numberFramesToDeletePerson
+            // frames, and it avoids tombstones in the probing sequences
+            auto numberStalePeople = 0u;
+            for (const auto& personState : mPersonStates)
+                if (personState.personId != -1
+                    && personState.lastFrameNumber + mNumberFramesToDeletePerson < frameNumber)
+                    numberStalePeople++;
+            if (numberStalePeople > 0u)
+                rehash(mPersonStates.size(), frameNumber);
+            mLastEvictionFrameNumber = frameNumber;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    void ExerciseCounter::rehash(const std::size_t capacity, const unsigned long long frameNumber)
+    {
+        try
+        {
+            // Move non-stale people into a table of the desired capacity
+            std::swap(mPersonStates, mPersonStatesAux);
+            std::swap(mCounts, mCountsAux);
+            std::swap(mNextPhases, mNextPhasesAux);
+            std::swap(mLastPhaseFrameNumbers, mLastPhaseFrameNumbersAux);
+            std::swap(mPhaseDurations, mPhaseDurationsAux);
+            std::swap(mPhaseScores, mPhaseScoresAux);
+            mPersonStates.assign(capacity, PersonState{-1ll, 0ull});
+            mCounts.assign(capacity * mNumberExercises, 0);
+            mNextPhases.assign(capacity * mNumberExercises, 0u);
+            mLastPhaseFrameNumbers.assign(capacity * mNumberExercises, 0ull);
+            mPhaseDurations.assign(capacity * mNumberPhases, 0ull);
+            mPhaseScores.assign(capacity * mNumberPhases, 0.f);
+            const auto mask = capacity - 1;
+            mNumberTrackedPeople = 0u;
+            for (auto slot = 0u ; slot < mPersonStatesAux.size() ; slot++)
+            {
+                const auto& personState = mPersonStatesAux[slot];
+                if (personState.personId != -1
+                    && personState.lastFrameNumber + mNumberFramesToDeletePerson >= frameNumber)
+                {
+                    auto index = getPersonIdHash(personState.personId, capacity);
+                    while (mPersonStates[index].personId != -1)
+                        index = (index + 1) & mask;
+                    mPersonStates[index] = personState;
+                    copySlot(mCounts, mCountsAux, index, slot, mNumberExercises);
+                    copySlot(mNextPhases, mNextPhasesAux, index, slot, mNumberExercises);
+                    copySlot(mLastPhaseFrameNumbers, mLastPhaseFrameNumbersAux, index, slot, mNumberExercises);
+                    copySlot(mPhaseDurations, mPhaseDurationsAux, index, slot, mNumberPhases);
+                    copySlot(mPhaseScores, mPhaseScoresAux, index, slot, mNumberPhases);
+                    mNumberTrackedPeople++;
+                }
+            }
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+}
@@ -0,0 +1,371 @@
+#include <algorithm> // std::fill, std::find
+#include <cmath> // std::sqrt
+#include <cstdlib> // std::strtof
+#include <fstream>
+#include <iterator> // std::istream_iterator
+#include <limits> // std::numeric_limits
+#include <sstream>
+#include <openpose/pose/poseParameters.hpp>
+#include <openpose/utilities/string.hpp>
+#include <openpose/exercise/exerciseRules.hpp>
+
+namespace op
+{
+    bool parseFloat(float& value, const std::string& string)
+    {
+        // value is only modified if string is a valid number
+        char* end;
+        const auto parsedValue = std::strtof(string.c_str(), &end);
+        if (string.empty() || *end != '\0')
+            return false;
+        value = parsedValue;
+        return true;
+    }
+
+    ExerciseRules::ExerciseRules(const PoseModel poseModel, const std::string& exerciseFilePath,
+                                 const std::vector<std::string>& exerciseNames) :
+        mPoseModel{poseModel}
+    {
+        try
+        {
+            parse(exerciseFilePath, exerciseNames);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    void ExerciseRules::evaluate(std::vector<unsigned char>& phaseMatches, const Array<float>& poseKeypoints)
+    {
+        try
+        {
+            const auto numberPeople = (poseKeypoints.empty() ? 0u : (unsigned int)poseKeypoints.getSize(0));
+            const auto numberPhases = mPhaseConditionOffsets.size() - 1;
+            phaseMatches.resize(numberPhases * numberPeople);
+            if (numberPeople > 0)
+            {
+                const auto nan = std::numeric_limits<float>::quiet_NaN();
+                // 1. Gather (AoS -> SoA) the used body parts, non-detected keypoints are NaN
+                const auto numberBodyParts = poseKeypoints.getSize(1);
+                mBodyPartXs.resize(mBodyParts.size() * numberPeople);
+                mBodyPartYs.resize(mBodyParts.size() * numberPeople);
+                for (auto i = 0u ; i < mBodyParts.size() ; i++)
+                {
+                    const auto* keypointPtr = poseKeypoints.getConstPtr() + 3*mBodyParts[i];
+                    auto* xPtr = &mBodyPartXs[i*numberPeople];
+                    auto* yPtr = &mBodyPartYs[i*numberPeople];
+                    for (auto person = 0u ; person < numberPeople ; person++)
+                    {
+                        const auto* personKeypointPtr = keypointPtr + 3*numberBodyParts*person;
+                        const auto detected = (personKeypointPtr[2] > 0.f);
+                        xPtr[person] = (detected ? personKeypointPtr[0] : nan);
+                        yPtr[person] = (detected ? personKeypointPtr[1] : nan);
+                    }
+                }
+                // 2. Features (each one evaluated for all people at once)
+                mFeatureValues.resize(mFeatures.size() * numberPeople);
+                for (auto i = 0u ; i < mFeatures.size() ; i++)
+                {
+                    const auto& feature = mFeatures[i];
+                    const auto* xAPtr = &mBodyPartXs[feature.bodyPartA*numberPeople];
+                    const auto* yAPtr = &mBodyPartYs[feature.bodyPartA*numberPeople];
+                    const auto* xBPtr = &mBodyPartXs[feature.bodyPartB*numberPeople];
+                    const auto* yBPtr = &mBodyPartYs[feature.bodyPartB*numberPeople];
+                    auto* valuePtr = &mFeatureValues[i*numberPeople];
+                    if (feature.type == FeatureType::X)
+                        for (auto person = 0u ; person < numberPeople ; person++)
+                            valuePtr[person] = xAPtr[person];
+                    else if (feature.type == FeatureType::Y)
+                        for (auto person = 0u ; person < numberPeople ; person++)
+                            valuePtr[person] = yAPtr[person];
+                    else if (feature.type == FeatureType::DistanceX)
+                        for (auto person = 0u ; person < numberPeople ; person++)
+                            valuePtr[person] = std::abs(xAPtr[person] - xBPtr[person]);
+                    else if (feature.type == FeatureType::DistanceY)
+                        for (auto person = 0u ; person < numberPeople ; person++)
+                            valuePtr[person] = std::abs(yAPtr[person] - yBPtr[person]);
+                    else if (feature.type == FeatureType::Distance)
+                        for (auto person = 0u ; person < numberPeople ; person++)
+                        {
+                            const auto dx = xAPtr[person] - xBPtr[person];
+                            const auto dy = yAPtr[person] - yBPtr[person];
+                            valuePtr[person] = std::sqrt(dx*dx + dy*dy);
+                        }
+                    else
+                        error("Unknown FeatureType.", __LINE__, __FUNCTION__, __FILE__);
+                }
+                // 3. Conditions (rhs = scale * feature or scale). Comparisons with NaN are always false
+                mConditionMatches.resize(mConditions.size() * numberPeople);
+                std::vector<float> rhsValues(numberPeople);
+                for (auto i = 0u ; i < mConditions.size() ; i++)
+                {
+                    const auto& condition = mConditions[i];
+                    const auto* lhsPtr = &mFeatureValues[condition.feature*numberPeople];
+                    if (condition.rhsFeature < 0)
+                        std::fill(rhsValues.begin(), rhsValues.end(), condition.scale);
+                    else
+                    {
+                        const auto* rhsFeaturePtr = &mFeatureValues[condition.rhsFeature*numberPeople];
+                        for (auto person = 0u ; person < numberPeople ; person++)
+                            rhsValues[person] = condition.scale * rhsFeaturePtr[person];
+                    }
+                    auto* matchPtr = &mConditionMatches[i*numberPeople];
+                    if (condition.comparison == Comparison::Less)
+                        for (auto person = 0u ; person < numberPeople ; person++)
+                            matchPtr[person] = (unsigned char)(lhsPtr[person] < rhsValues[person]);
+                    else if (condition.comparison == Comparison::LessEqual)
+                        for (auto person = 0u ; person < numberPeople ; person++)
+                            matchPtr[person] = (unsigned char)(lhsPtr[person] <= rhsValues[person]);
+                    else if (condition.comparison == Comparison::Greater)
+                        for (auto person = 0u ; person < numberPeople ; person++)
+                            matchPtr[person] = (unsigned char)(lhsPtr[person] > rhsValues[person]);
+                    else
+                        for (auto person = 0u ; person < numberPeople ; person++)
+                            matchPtr[person] = (unsigned char)(lhsPtr[person] >= rhsValues[person]);
+                }
+                // 4. Phases (conjunction of their conditions)
+                for (auto phase = 0u ; phase < numberPhases ; phase++)
+                {
+                    auto* phaseMatchPtr = &phaseMatches[phase*numberPeople];
+                    std::fill(phaseMatchPtr, phaseMatchPtr + numberPeople, (unsigned char)1);
+                    for (auto i = mPhaseConditionOffsets[phase] ; i < mPhaseConditionOffsets[phase+1] ; i++)
+                    {
+                        const auto* matchPtr = &mConditionMatches[mPhaseConditions[i]*numberPeople];
+                        for (auto person = 0u ; person < numberPeople ; person++)
+                            phaseMatchPtr[person] &= matchPtr[person];
+                    }
+                }
+            }
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    const std::vector<std::string>& ExerciseRules::getExerciseNames() const
+    {
+        try
+        {
+            return mExerciseNames;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return mExerciseNames;
+        }
+    }
+
+    const std::vector<unsigned int>& ExerciseRules::getPhaseOffsets() const
+    {
+        try
+        {
+            return mPhaseOffsets;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return mPhaseOffsets;
+        }
+    }
+
+    void ExerciseRules::parse(const std::string& exerciseFilePath, const std::vector<std::string>& exerciseNames)
+    {
+        try
+        {
+            std::ifstream exerciseFile{exerciseFilePath};
+            if (!exerciseFile.is_open())
+                error("Exercise file could not be opened: " + exerciseFilePath + ".", __LINE__, __FUNCTION__, __FILE__);
+            mPhaseOffsets.emplace_back(0u);
+            mPhaseConditionOffsets.emplace_back(0u);
+            auto skipExercise = false;
+            // Each exercise must have at least 1 phase, and each phase at least 1 condition
+            const auto checkLastExercise = [&](const std::string& errorPrefix, const bool checkPhases)
+            {
+                if (!mExerciseNames.empty() && !skipExercise)
+                {
+                    const auto numberPhases = mPhaseOffsets.back() - mPhaseOffsets[mPhaseOffsets.size()-2];
+                    if (checkPhases && numberPhases == 0)
+                        error(errorPrefix + "Exercise `" + mExerciseNames.back() + "` has no phases.",
+                              __LINE__, __FUNCTION__, __FILE__);
+                    if (numberPhases > 0
+                        && mPhaseConditionOffsets.back() == mPhaseConditionOffsets[mPhaseConditionOffsets.size()-2])
+                        error(errorPrefix + "Exercise `" + mExerciseNames.back() + "` has a phase without conditions.",
+                              __LINE__, __FUNCTION__, __FILE__);
+                }
+            };
+            auto lineNumber = 0u;
+            std::string line;
+            while (std::getline(exerciseFile, line))
+            {
+                lineNumber++;
+                // Remove comments and split into tokens
+                line = line.substr(0, line.find('#'));
+                std::istringstream lineStream{line};
+                std::vector<std::string> tokens{std::istream_iterator<std::string>{lineStream},
+                                                std::istream_iterator<std::string>{}};
+                if (tokens.empty())
+                    continue;
+                const auto errorPrefix = exerciseFilePath + ":" + std::to_string(lineNumber) + ": ";
+                // New exercise
+                if (tokens[0] == "exercise")
+                {
+                    if (tokens.size() != 2)
+                        error(errorPrefix + "Expected `exercise <name>`.", __LINE__, __FUNCTION__, __FILE__);
+                    checkLastExercise(errorPrefix, true);
+                    skipExercise = (!exerciseNames.empty() && std::find(exerciseNames.begin(), exerciseNames.end(),
+                                                                        tokens[1]) == exerciseNames.end());
+                    if (!skipExercise)
+                    {
+                        if (std::find(mExerciseNames.begin(), mExerciseNames.end(), tokens[1])
+                            != mExerciseNames.end())
+                            error(errorPrefix + "Duplicated exercise `" + tokens[1] + "`.",
+                                  __LINE__, __FUNCTION__, __FILE__);
+                        mExerciseNames.emplace_back(tokens[1]);
+                        mPhaseOffsets.emplace_back(mPhaseOffsets.back());
+                    }
+                }
+                else if (skipExercise)
+                    continue;
+                else if (mExerciseNames.empty())
+                    error(errorPrefix + "Expected `exercise <name>` first.", __LINE__, __FUNCTION__, __FILE__);
+                // New phase
+                else if (tokens[0] == "phase")
+                {
+                    if (tokens.size() != 2)
+                        error(errorPrefix + "Expected `phase <name>`.", __LINE__, __FUNCTION__, __FILE__);
+                    checkLastExercise(errorPrefix, false);
+                    mPhaseOffsets.back()++;
+                    mPhaseConditionOffsets.emplace_back(mPhaseConditionOffsets.back());
+                }
+                // New condition of the last phase
+                else
+                {
+                    if (mPhaseOffsets.back() == mPhaseOffsets[mPhaseOffsets.size()-2])
+                        error(errorPrefix + "Expected `phase <name>` first.", __LINE__, __FUNCTION__, __FILE__);
+                    auto tokenIndex = std::size_t(0);
+                    Condition condition{addFeature(tokens, tokenIndex, errorPrefix), Comparison::Less, 1.f, -1};
+                    // Comparison
+                    const auto comparison = (tokenIndex < tokens.size() ? tokens[tokenIndex++] : "");
+                    if (comparison == "<")
+                        condition.comparison = Comparison::Less;
+                    else if (comparison == "<=")
+                        condition.comparison = Comparison::LessEqual;
+                    else if (comparison == ">")
+                        condition.comparison = Comparison::Greater;
+                    else if (comparison == ">=")
+                        condition.comparison = Comparison::GreaterEqual;
+                    else
+                        error(errorPrefix + "Expected `<`, `<=`, `>` or `>=` after the first feature.",
+                              __LINE__, __FUNCTION__, __FILE__);
+                    // Right hand side: [scale] [feature]
+                    if (tokenIndex < tokens.size() && parseFloat(condition.scale, tokens[tokenIndex]))
+                        tokenIndex++;
+                    else if (tokenIndex == tokens.size())
+                        error(errorPrefix + "Missing right hand side.", __LINE__, __FUNCTION__, __FILE__);
+                    if (tokenIndex < tokens.size())
+                        condition.rhsFeature = (int)addFeature(tokens, tokenIndex, errorPrefix);
+                    if (tokenIndex != tokens.size())
+                        error(errorPrefix + "Unexpected `" + tokens[tokenIndex] + "`.",
+                              __LINE__, __FUNCTION__, __FILE__);
+                    mPhaseConditions.emplace_back(addCondition(condition));
+                    mPhaseConditionOffsets.back()++;
+                }
+            }
+            // Security checks
+            if (mExerciseNames.empty())
+                error("No exercises found on " + exerciseFilePath + ".", __LINE__, __FUNCTION__, __FILE__);
+            checkLastExercise(exerciseFilePath + ": ", true);
+            for (const auto& exerciseName : exerciseNames)
+                if (std::find(mExerciseNames.begin(), mExerciseNames.end(), exerciseName) == mExerciseNames.end())
+                    error("Exercise `" + exerciseName + "` not found on " + exerciseFilePath + ".",
+                          __LINE__, __FUNCTION__, __FILE__);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    unsigned int ExerciseRules::addFeature(const std::vector<std::string>& tokens, std::size_t& tokenIndex,
+                                           const std::string& errorPrefix)
+    {
+        try
+        {
+            // Parse feature
+            const auto& typeString = tokens[tokenIndex++];
+            Feature feature{FeatureType::X, 0u, 0u};
+            auto numberBodyParts = 2u;
+            if (typeString == "x" || typeString == "y")
+            {
+                feature.type = (typeString == "x" ? FeatureType::X : FeatureType::Y);
+                numberBodyParts = 1u;
+            }
+            else if (typeString == "dx")
+                feature.type = FeatureType::DistanceX;
+            else if (typeString == "dy")
+                feature.type = FeatureType::DistanceY;
+            else if (typeString == "distance")
+                feature.type = FeatureType::Distance;
+            else
+                error(errorPrefix + "Unknown feature `" + typeString + "` (expected `x`, `y`, `dx`, `dy` or"
+                      " `distance`).", __LINE__, __FUNCTION__, __FILE__);
+            if (tokenIndex + numberBodyParts > tokens.size())
+                error(errorPrefix + "Feature `" + typeString + "` expects " + std::to_string(numberBodyParts)
+                      + " body part(s).", __LINE__, __FUNCTION__, __FILE__);
+            feature.bodyPartA = getBodyPartIndex(tokens[tokenIndex++]);
+            feature.bodyPartB = (numberBodyParts > 1 ? getBodyPartIndex(tokens[tokenIndex++]) : feature.bodyPartA);
+            // Reuse it if already used by any other condition
+            for (auto i = 0u ; i < mFeatures.size() ; i++)
+                if (mFeatures[i].type == feature.type && mFeatures[i].bodyPartA == feature.bodyPartA
+                    && mFeatures[i].bodyPartB == feature.bodyPartB)
+                    return i;
+            mFeatures.emplace_back(feature);
+            return (unsigned int)mFeatures.size() - 1;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return 0u;
+        }
+    }
+
+    unsigned int ExerciseRules::addCondition(const Condition& condition)
+    {
+        try
+        {
+            // Reuse it if already used by any other phase
+            for (auto i = 0u ; i < mConditions.size() ; i++)
+                if (mConditions[i].feature == condition.feature && mConditions[i].comparison == condition.comparison
+                    && mConditions[i].scale == condition.scale && mConditions[i].rhsFeature == condition.rhsFeature)
+                    return i;
+            mConditions.emplace_back(condition);
+            return (unsigned int)mConditions.size() - 1;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return 0u;
+        }
+    }
+
+    unsigned int ExerciseRules::getBodyPartIndex(const std::string& bodyPartNames)
+    {
+        try
+        {
+            // Index inside mBodyParts (only the used body parts are gathered)
+            const auto bodyPart = poseBodyPartMapStringToKey(mPoseModel, splitString(bodyPartNames, "|"));
+            const auto bodyPartIt = std::find(mBodyParts.begin(), mBodyParts.end(), bodyPart);
+            if (bodyPartIt != mBodyParts.end())
+                return (unsigned int)(bodyPartIt - mBodyParts.begin());
+            mBodyParts.emplace_back(bodyPart);
+            return (unsigned int)mBodyParts.size() - 1;
+        }
+        catch (const std::exception& e)
+        {
+            error("Body part `" + bodyPartNames + "`: " + e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return 0u;
+        }
+    }
+}
@@ -1,3 +1,5 @@
+#include <algorithm> // std::copy, std::fill
+#include <limits> // std::numeric_limits
 #include <thread>
 #include <openpose/experimental/tracking/pyramidalLK.hpp>
 #include <openpose/utilities/fastMath.hpp>
@@ -231,19 +233,136 @@ namespace op
         }
     }
 
+    const auto NON_MATCHABLE_COST = 1e6;
+
+    void getBoundingBoxes(std::vector<float>& boundingBoxes, const float* keypointsPtr, const int numberPeople,
+                          const int numberBodyParts, const float confidenceThreshold)
+    {
+        try
+        {
+            // (minX, minY, maxX, maxY) of the keypoints of each person with score >= confidenceThreshold
+            boundingBoxes.resize(4*numberPeople);
+            for (auto person = 0 ; person < numberPeople ; person++)
+            {
+                auto* boundingBoxPtr = &boundingBoxes[4*person];
+                boundingBoxPtr[0] = std::numeric_limits<float>::max();
+                boundingBoxPtr[1] = std::numeric_limits<float>::max();
+                boundingBoxPtr[2] = std::numeric_limits<float>::lowest();
+                boundingBoxPtr[3] = std::numeric_limits<float>::lowest();
+                const auto* personKeypointsPtr = keypointsPtr + 3 * person * numberBodyParts;
+                for (auto part = 0 ; part < numberBodyParts ; part++)
+                {
+                    if (personKeypointsPtr[3*part+2] >= confidenceThreshold)
+                    {
+                        boundingBoxPtr[0] = fastMin(boundingBoxPtr[0], personKeypointsPtr[3*part]);
+                        boundingBoxPtr[1] = fastMin(boundingBoxPtr[1], personKeypointsPtr[3*part+1]);
+                        boundingBoxPtr[2] = fastMax(boundingBoxPtr[2], personKeypointsPtr[3*part]);
+                        boundingBoxPtr[3] = fastMax(boundingBoxPtr[3], personKeypointsPtr[3*part+1]);
+                    }
+                }
+            }
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    std::vector<int> assignHungarian(const std::vector<double>& costs, const int numberRows, const int numberCols)
+    {
+        try
+        {
+            // Optimal assignment of each row to a different column (#rows <= #cols) minimizing the total cost
+            // (shortest augmenting paths, O(#rows^2 x #cols)). 1-based indexes: column potentials v and row
+            // potentials u, row assigned to each column (p, 0 if free) and previous column in the augmenting path
+            // (way)
+            std::vector<double> u(numberRows+1, 0.);
+            std::vector<double> v(numberCols+1, 0.);
+            std::vector<double> minv(numberCols+1);
+            std::vector<int> p(numberCols+1, 0);
+            std::vector<int> way(numberCols+1, 0);
+            std::vector<char> used(numberCols+1);
+            for (auto row = 1 ; row <= numberRows ; row++)
+            {
+                p[0] = row;
+                auto col0 = 0;
+                std::fill(minv.begin(), minv.end(), std::numeric_limits<double>::max());
+                std::fill(used.begin(), used.end(), 0);
+                // Find augmenting path
+                do
+                {
+                    used[col0] = 1;
+                    const auto row0 = p[col0];
+                    const auto* costRow = &costs[(row0-1)*numberCols];
+                    auto delta = std::numeric_limits<double>::max();
+                    auto col1 = 0;
+                    for (auto col = 1 ; col <= numberCols ; col++)
+                    {
+                        if (!used[col])
+                        {
+                            const auto reducedCost = costRow[col-1] - u[row0] - v[col];
+                            if (reducedCost < minv[col])
+                            {
+                                minv[col] = reducedCost;
+                                way[col] = col0;
+                            }
+                            if (minv[col] < delta)
+                            {
+                                delta = minv[col];
+                                col1 = col;
+                            }
+                        }
+                    }
+                    for (auto col = 0 ; col <= numberCols ; col++)
+                    {
+                        if (used[col])
+                        {
+                            u[p[col]] += delta;
+                            v[col] -= delta;
+                        }
+                        else
+                            minv[col] -= delta;
+                    }
+                    col0 = col1;
+                } while (p[col0] != 0);
+                // Update assignment along the path
+                do
+                {
+                    const auto col1 = way[col0];
+                    p[col0] = p[col1];
+                    col0 = col1;
+                } while (col0 != 0);
+            }
+            // Column of each row
+            std::vector<int> assignment(numberRows, -1);
+            for (auto col = 1 ; col <= numberCols ; col++)
+                if (p[col] > 0)
+                    assignment[p[col]-1] = col-1;
+            return assignment;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return {};
+        }
+    }
+
     PersonIdExtractor::PersonIdExtractor(const float confidenceThreshold, const float inlierRatioThreshold,
-                                         const float distanceThreshold, const int numberFramesToDeletePerson) :
+                                         const float distanceThreshold, const int numberFramesToDeletePerson,
+                                         const bool opticalFlow) :
         mConfidenceThreshold{confidenceThreshold},
         mInlierRatioThreshold{inlierRatioThreshold},
         mDistanceThreshold{distanceThreshold},
         mNumberFramesToDeletePerson{numberFramesToDeletePerson},
+        mOpticalFlow{opticalFlow},
         mNextPersonId{0ll},
         mLastFrameId{-1ll}
     {
         try
         {
-            error("PersonIdExtractor (`identification` flag) buggy and not working yet, but we are working on it!"
-                  " Coming soon!", __LINE__, __FUNCTION__, __FILE__);
+            if (mOpticalFlow)
+                error("PersonIdExtractor optical flow mode buggy and not working yet, but we are working on it!"
+                      " Coming soon!", __LINE__, __FUNCTION__, __FILE__);
         }
         catch (const std::exception& e)
         {
@@ -264,6 +383,10 @@ namespace op
             if (imageViewIndex > 0)
                 error(errorMessage, __LINE__, __FUNCTION__, __FILE__);
 
+            // Keypoint matching mode
+            if (!mOpticalFlow)
+                return matchKeypoints(poseKeypoints, cvMatInput);
+
             // Result initialization
             Array<long long> poseIds;
             const auto openposePersonEntries = captureKeypoints(poseKeypoints, mConfidenceThreshold);
@@ -328,4 +451,133 @@ namespace op
             return Array<long long>{};
         }
     }
+
+    Array<long long> PersonIdExtractor::matchKeypoints(const Array<float>& poseKeypoints, const cv::Mat& cvMatInput)
+    {
+        try
+        {
+            const auto numberPeople = (poseKeypoints.empty() ? 0 : poseKeypoints.getSize(0));
+            const auto numberBodyParts = (poseKeypoints.empty() ? 0 : poseKeypoints.getSize(1));
+            const auto personArea = 3 * numberBodyParts;
+            // Reset if the number of body parts changed
+            if (numberPeople > 0 && mTrackedKeypoints.size() != mTrackedIds.size() * personArea)
+            {
+                mTrackedIds.clear();
+                mTrackedKeypoints.clear();
+                mTrackedNumberFramesSinceDetection.clear();
+            }
+            // Maximum distance (scaled with the image size)
+            const auto distanceThreshold = (cvMatInput.empty() ? mDistanceThreshold
+                : fastMax(10.f, mDistanceThreshold*float(std::sqrt(cvMatInput.cols*cvMatInput.rows)) / 960.f));
+            // Cost of assigning each person to each tracked person (mean keypoint distance normalized by the
+            // threshold) or to a new ID (#tracked + #people columns, cost 1)
+            const auto numberTracked = (int)mTrackedIds.size();
+            const auto numberCols = numberTracked + numberPeople;
+            std::vector<double> costs(numberPeople * numberCols, 1.);
+            std::vector<float> boundingBoxes;
+            std::vector<float> trackedBoundingBoxes;
+            if (numberPeople > 0)
+            {
+                getBoundingBoxes(boundingBoxes, poseKeypoints.getConstPtr(), numberPeople, numberBodyParts,
+                                 mConfidenceThreshold);
+                getBoundingBoxes(trackedBoundingBoxes, mTrackedKeypoints.data(), numberTracked, numberBodyParts,
+                                 mConfidenceThreshold);
+            }
+            for (auto person = 0 ; person < numberPeople ; person++)
+            {
+                const auto* keypointsPtr = poseKeypoints.getConstPtr() + person * personArea;
+                const auto* boundingBoxPtr = &boundingBoxes[4*person];
+                auto* costPtr = &costs[person * numberCols];
+                for (auto tracked = 0 ; tracked < numberTracked ; tracked++)
+                {
+                    // The distance between bounding boxes is a lower bound of the mean keypoint distance, so most
+                    // pairs are discarded without computing it
+                    const auto maxDistance = distanceThreshold * (1 + mTrackedNumberFramesSinceDetection[tracked]);
+                    const auto* trackedBoundingBoxPtr = &trackedBoundingBoxes[4*tracked];
+                    if (boundingBoxPtr[0] - trackedBoundingBoxPtr[2] > maxDistance
+                        || trackedBoundingBoxPtr[0] - boundingBoxPtr[2] > maxDistance
+                        || boundingBoxPtr[1] - trackedBoundingBoxPtr[3] > maxDistance
+                        || trackedBoundingBoxPtr[1] - boundingBoxPtr[3] > maxDistance)
+                    {
+                        costPtr[tracked] = NON_MATCHABLE_COST;
+                        continue;
+                    }
+                    const auto* trackedKeypointsPtr = &mTrackedKeypoints[tracked * personArea];
+                    auto distance = 0.f;
+                    auto numberValidParts = 0;
+                    for (auto part = 0 ; part < numberBodyParts ; part++)
+                    {
+                        if (keypointsPtr[3*part+2] >= mConfidenceThreshold
+                            && trackedKeypointsPtr[3*part+2] >= mConfidenceThreshold)
+                        {
+                            const auto dx = keypointsPtr[3*part] - trackedKeypointsPtr[3*part];
+                            const auto dy = keypointsPtr[3*part+1] - trackedKeypointsPtr[3*part+1];
+                            distance += std::sqrt(dx*dx + dy*dy);
+                            numberValidParts++;
+                        }
+                    }
+                    const auto cost = (numberValidParts > 0
+                        ? distance / (numberValidParts * maxDistance) : NON_MATCHABLE_COST);
+                    costPtr[tracked] = (cost <= 1. ? cost : NON_MATCHABLE_COST);
+                }
+            }
+            // Optimal assignment
+            const auto assignment = (numberPeople > 0
+                ? assignHungarian(costs, numberPeople, numberCols) : std::vector<int>{});
+            // Update tracked people
+            for (auto& numberFramesSinceDetection : mTrackedNumberFramesSinceDetection)
+                numberFramesSinceDetection++;
+            Array<long long> poseIds;
+            if (numberPeople > 0)
+                poseIds.reset(numberPeople);
+            for (auto person = 0 ; person < numberPeople ; person++)
+            {
+                auto tracked = assignment[person];
+                // New person
+                if (tracked < 0 || tracked >= numberTracked
+                    || costs[person * numberCols + tracked] >= NON_MATCHABLE_COST)
+                {
+                    tracked = (int)mTrackedIds.size();
+                    mTrackedIds.emplace_back(mNextPersonId++);
+                    mTrackedKeypoints.resize(mTrackedKeypoints.size() + personArea, 0.f);
+                    mTrackedNumberFramesSinceDetection.emplace_back(0);
+                }
+                poseIds[person] = mTrackedIds[tracked];
+                mTrackedNumberFramesSinceDetection[tracked] = 0;
+                // Keypoints (non-detected ones keep their last position)
+                const auto* keypointsPtr = poseKeypoints.getConstPtr() + person * personArea;
+                auto* trackedKeypointsPtr = &mTrackedKeypoints[tracked * personArea];
+                for (auto part = 0 ; part < numberBodyParts ; part++)
+                    if (keypointsPtr[3*part+2] >= mConfidenceThreshold)
+                        std::copy(keypointsPtr + 3*part, keypointsPtr + 3*part + 3, trackedKeypointsPtr + 3*part);
+            }
+            // Remove people not detected in the last frames (personArea is 0 if there are no people on this frame)
+            const auto trackedPersonArea = (mTrackedIds.empty() ? 0u : mTrackedKeypoints.size() / mTrackedIds.size());
+            auto numberKept = 0u;
+            for (auto tracked = 0u ; tracked < mTrackedIds.size() ; tracked++)
+            {
+                if (mTrackedNumberFramesSinceDetection[tracked] <= mNumberFramesToDeletePerson)
+                {
+                    if (numberKept != tracked)
+                    {
+                        mTrackedIds[numberKept] = mTrackedIds[tracked];
+                        mTrackedNumberFramesSinceDetection[numberKept] = mTrackedNumberFramesSinceDetection[tracked];
+                        std::copy(mTrackedKeypoints.begin() + tracked * trackedPersonArea,
+                                  mTrackedKeypoints.begin() + (tracked+1) * trackedPersonArea,
+                                  mTrackedKeypoints.begin() + numberKept * trackedPersonArea);
+                    }
+                    numberKept++;
+                }
+            }
+            mTrackedIds.resize(numberKept);
+            mTrackedNumberFramesSinceDetection.resize(numberKept);
+            mTrackedKeypoints.resize(numberKept * trackedPersonArea);
+            return poseIds;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return Array<long long>{};
+        }
+    }
 }
@@ -7,7 +7,9 @@ namespace op
     DEFINE_TEMPLATE_DATUM(WHandSaver);
     DEFINE_TEMPLATE_DATUM(WHeatMapSaver);
     DEFINE_TEMPLATE_DATUM(WImageSaver);
+    DEFINE_TEMPLATE_DATUM(WKeypointLoader);
     DEFINE_TEMPLATE_DATUM(WPeopleJsonSaver);
     DEFINE_TEMPLATE_DATUM(WPoseSaver);
+    DEFINE_TEMPLATE_DATUM(WRepEventSaver);
     DEFINE_TEMPLATE_DATUM(WVideoSaver);
 }
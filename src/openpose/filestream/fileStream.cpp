@@ -1,4 +1,6 @@
+#include <cstdlib> // std::strtof
 #include <fstream> // std::ifstream, std::ofstream
+#include <iterator> // std::istreambuf_iterator
 #include <opencv2/highgui/highgui.hpp> // cv::imread
 #include <openpose/utilities/fastMath.hpp>
 #include <openpose/utilities/fileSystem.hpp>
@@ -337,6 +339,73 @@ namespace op
         }
     }
 
+    Array<float> loadPeopleJson(const std::string& fileName, const std::string& keypointName)
+    {
+        try
+        {
+            // Read whole file
+            std::ifstream jsonFile{fileName, std::ios::binary};
+            if (!jsonFile.is_open())
+                error("Unable to open file " + fileName + ".", __LINE__, __FUNCTION__, __FILE__);
+            const std::string json{std::istreambuf_iterator<char>(jsonFile), std::istreambuf_iterator<char>()};
+            jsonFile.close();
+            // Each person object contains the key exactly once, so each occurrence of the key is a new person
+            const auto key = "\"" + keypointName + "\"";
+            auto position = json.find("\"people\"");
+            std::vector<float> values;
+            auto numberPeople = 0;
+            auto numberValuesPerPerson = -1;
+            while (position != std::string::npos
+                   && (position = json.find(key, position)) != std::string::npos)
+            {
+                position = json.find('[', position + key.size());
+                if (position == std::string::npos)
+                    error("Wrong JSON format in " + fileName + ".", __LINE__, __FUNCTION__, __FILE__);
+                // Parse numbers until ']'
+                const auto numberValuesBefore = values.size();
+                const char* pointer = &json[position+1];
+                while (true)
+                {
+                    while (*pointer == ' ' || *pointer == ',' || *pointer == '\n' || *pointer == '\r'
+                           || *pointer == '\t')
+                        pointer++;
+                    if (*pointer == ']' || *pointer == '\0')
+                        break;
+                    char* end;
+                    const auto value = std::strtof(pointer, &end);
+                    if (end == pointer)
+                        error("Wrong JSON format in " + fileName + ".", __LINE__, __FUNCTION__, __FILE__);
+                    values.emplace_back(value);
+                    pointer = end;
+                }
+                position = pointer - json.data();
+                // Security checks
+                const auto numberValues = (int)(values.size() - numberValuesBefore);
+                if (numberValues % 3 != 0)
+                    error("Keypoints in " + fileName + " are not (x,y,score) triplets.",
+                          __LINE__, __FUNCTION__, __FILE__);
+                if (numberValuesPerPerson < 0)
+                    numberValuesPerPerson = numberValues;
+                else if (numberValuesPerPerson != numberValues)
+                    error("Inconsistent number of keypoints in " + fileName + ".", __LINE__, __FUNCTION__, __FILE__);
+                numberPeople++;
+            }
+            // Fill Array
+            Array<float> keypoints;
+            if (numberPeople > 0 && numberValuesPerPerson > 0)
+            {
+                keypoints.reset({numberPeople, numberValuesPerPerson / 3, 3});
+                std::copy(values.begin(), values.end(), keypoints.getPtr());
+            }
+            return keypoints;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return Array<float>{};
+        }
+    }
+
     void saveImage(const cv::Mat& cvMat, const std::string& fullFilePath,
                    const std::vector<int>& openCvCompressionParams)
     {
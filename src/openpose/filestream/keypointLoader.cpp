@@ -0,0 +1,160 @@
+#include <exception> // std::exception_ptr
+#include <thread>
+#include <openpose/utilities/fastMath.hpp>
+#include <openpose/utilities/fileSystem.hpp>
+#include <openpose/filestream/enumClasses.hpp>
+#include <openpose/filestream/fileStream.hpp>
+#include <openpose/filestream/keypointLoader.hpp>
+
+namespace op
+{
+    const std::string JSON_SUFFIX = "_keypoints";
+    const std::string KEYPOINT_SAVER_SUFFIX = "_pose";
+
+    std::string removeSuffix(const std::string& string, const std::string& suffix)
+    {
+        if (string.size() >= suffix.size()
+            && string.compare(string.size() - suffix.size(), suffix.size(), suffix) == 0)
+            return string.substr(0, string.size() - suffix.size());
+        return string;
+    }
+
+    Array<float> loadKeypointFile(const std::string& filePath)
+    {
+        try
+        {
+            const auto extension = getFileExtension(filePath);
+            const auto fileNameNoExtension = filePath.substr(0, filePath.size() - extension.size() - 1);
+            // KeypointSaver format (OpenCV cv::FileStorage, 1 matrix per frame)
+            if (getFileNameNoExtension(filePath) != removeSuffix(getFileNameNoExtension(filePath),
+                                                                 KEYPOINT_SAVER_SUFFIX))
+            {
+                Array<float> poseKeypoints;
+                const auto cvMat = loadData("pose_0", fileNameNoExtension, stringToDataFormat(extension));
+                if (!cvMat.empty())
+                    poseKeypoints.setFrom(cvMat);
+                return poseKeypoints;
+            }
+            // PeopleJsonSaver format
+            else
+                return loadPeopleJson(filePath, "pose_keypoints_2d");
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return Array<float>{};
+        }
+    }
+
+    std::vector<std::string> getKeypointFiles(const std::string& directoryPath)
+    {
+        try
+        {
+            // Keep only files written by PeopleJsonSaver or KeypointSaver (i.e., ignore face/hand files)
+            std::vector<std::string> filePaths;
+            for (const auto& filePath : getFilesOnDirectory(directoryPath, {"json", "xml", "yaml", "yml"}))
+            {
+                const auto fileName = getFileNameNoExtension(filePath);
+                if (fileName != removeSuffix(fileName, JSON_SUFFIX)
+                    || fileName != removeSuffix(fileName, KEYPOINT_SAVER_SUFFIX))
+                    filePaths.emplace_back(filePath);
+            }
+            if (filePaths.empty())
+                error("No keypoint files (`*" + JSON_SUFFIX + ".json` or `*" + KEYPOINT_SAVER_SUFFIX + ".*`) found"
+                      " on " + directoryPath + ".", __LINE__, __FUNCTION__, __FILE__);
+            return filePaths;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return {};
+        }
+    }
+
+    KeypointLoader::KeypointLoader(const std::string& directoryPath, const int numberThreads,
+                                   const unsigned int batchSize) :
+        mNumberThreads{(unsigned int)(numberThreads > 0
+                                      ? numberThreads : fastMax(1u, std::thread::hardware_concurrency()))},
+        mBatchSize{fastMax(1u, batchSize)},
+        mFilePaths{getKeypointFiles(directoryPath)},
+        mNextFileIndex{0ull}
+    {
+    }
+
+    std::vector<Array<float>> KeypointLoader::loadNextBatch(std::vector<std::string>& frameNames)
+    {
+        try
+        {
+            // Batch size
+            const auto firstIndex = mNextFileIndex;
+            const auto numberFiles = (unsigned int)fastMin((unsigned long long)mBatchSize,
+                                                           mFilePaths.size() - firstIndex);
+            mNextFileIndex += numberFiles;
+            // Frame names
+            frameNames.resize(numberFiles);
+            for (auto i = 0u ; i < numberFiles ; i++)
+                frameNames[i] = removeSuffix(removeSuffix(getFileNameNoExtension(mFilePaths[firstIndex+i]),
+                                                          JSON_SUFFIX), KEYPOINT_SAVER_SUFFIX);
+            // Parse files in parallel (interleaved, each thread writes its own elements)
+            std::vector<Array<float>> poseKeypoints(numberFiles);
+            const auto numberThreads = fastMin(mNumberThreads, numberFiles);
+            // Exceptions cannot cross threads, so they are re-thrown from this thread
+            std::vector<std::exception_ptr> exceptionPtrs(numberThreads);
+            const auto loadFiles = [&](const unsigned int threadIndex)
+            {
+                try
+                {
+                    for (auto i = threadIndex ; i < numberFiles ; i += numberThreads)
+                        poseKeypoints[i] = loadKeypointFile(mFilePaths[firstIndex+i]);
+                }
+                catch (const std::exception&)
+                {
+                    exceptionPtrs[threadIndex] = std::current_exception();
+                }
+            };
+            std::vector<std::thread> threads;
+            for (auto threadIndex = 1u ; threadIndex < numberThreads ; threadIndex++)
+                threads.emplace_back(loadFiles, threadIndex);
+            if (numberThreads > 0)
+                loadFiles(0u);
+            for (auto& thread : threads)
+                if (thread.joinable())
+                    thread.join();
+            for (const auto& exceptionPtr : exceptionPtrs)
+                if (exceptionPtr != nullptr)
+                    std::rethrow_exception(exceptionPtr);
+            return poseKeypoints;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return {};
+        }
+    }
+
+    bool KeypointLoader::isFinished() const
+    {
+        try
+        {
+            return mNextFileIndex >= mFilePaths.size();
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return true;
+        }
+    }
+
+    unsigned long long KeypointLoader::getNumberFrames() const
+    {
+        try
+        {
+            return mFilePaths.size();
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return 0ull;
+        }
+    }
+}
@@ -0,0 +1,180 @@
+#include <cstdint> // std::int32_t, std::int64_t, std::uint32_t, std::uint64_t
+#include <iomanip> // std::setprecision
+#include <openpose/filestream/repEventSaver.hpp>
+#include <openpose/utilities/string.hpp>
+
+namespace op
+{
+    const std::uint32_t BINARY_VERSION = 1u;
+
+    template<typename T>
+    inline void writeBinary(std::ofstream& ofstream, const T value)
+    {
+        ofstream.write(reinterpret_cast<const char*>(&value), sizeof(T));
+    }
+
+    bool isFileEmpty(const std::string& filePath)
+    {
+        try
+        {
+            std::ifstream ifstream{filePath, std::ios::binary | std::ios::ate};
+            return (!ifstream.is_open() || ifstream.tellg() <= 0);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return true;
+        }
+    }
+
+    RepEventSaver::RepEventSaver(const std::string& filePath, const std::vector<std::string>& exerciseNames,
+                                 const double fps, const RepEventFormat repEventFormat,
+                                 const double flushPeriodSeconds) :
+        mExerciseNames{exerciseNames},
+        mFps{fps},
+        mRepEventFormat{repEventFormat},
+        mFlushPeriod{(long long)(1e9 * flushPeriodSeconds)},
+        mLastFlush{std::chrono::steady_clock::now()},
+        mPendingFlush{false}
+    {
+        try
+        {
+            // Security checks
+            if (mFps <= 0.)
+                error("The fps (frame rate) must be positive.", __LINE__, __FUNCTION__, __FILE__);
+            // Open file (append-only)
+            const auto writeHeader = (mRepEventFormat == RepEventFormat::Binary && isFileEmpty(filePath));
+            mOfstream.open(filePath, std::ios::out | std::ios::app | std::ios::binary);
+            if (!mOfstream.is_open())
+                error("Repetition event file could not be opened as `" + filePath + "`.",
+                      __LINE__, __FUNCTION__, __FILE__);
+            // JSON times in seconds: sub-millisecond resolution for sessions of up to ~1 day (the default 6
+            // significant digits only give 0.1 s after ~3 hours)
+            if (mRepEventFormat == RepEventFormat::JsonLines)
+                mOfstream << std::setprecision(9);
+            // Binary header
+            if (writeHeader)
+            {
+                mOfstream.write("OPRE", 4);
+                writeBinary(mOfstream, BINARY_VERSION);
+                writeBinary(mOfstream, mFps);
+                writeBinary(mOfstream, (std::uint32_t)mExerciseNames.size());
+                for (const auto& exerciseName : mExerciseNames)
+                {
+                    writeBinary(mOfstream, (std::uint32_t)exerciseName.size());
+                    mOfstream.write(exerciseName.data(), exerciseName.size());
+                }
+                flush();
+            }
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    RepEventSaver::~RepEventSaver()
+    {
+        try
+        {
+            flush();
+        }
+        catch (const std::exception& e)
+        {
+            // Destructor: log instead of throwing
+            log(e.what(), Priority::High, __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    void RepEventSaver::save(const std::vector<RepetitionEvent>& repetitionEvents,
+                             const unsigned long long frameNumber)
+    {
+        try
+        {
+            // Write events
+            if (!repetitionEvents.empty())
+            {
+                const auto timestamp = (long long)std::chrono::duration_cast<std::chrono::milliseconds>(
+                    std::chrono::system_clock::now().time_since_epoch()).count();
+                for (const auto& repetitionEvent : repetitionEvents)
+                {
+                    if (mRepEventFormat == RepEventFormat::JsonLines)
+                        saveJsonLine(repetitionEvent, frameNumber, timestamp);
+                    else if (mRepEventFormat == RepEventFormat::Binary)
+                        saveBinary(repetitionEvent, frameNumber, timestamp);
+                    else
+                        error("Unknown RepEventFormat.", __LINE__, __FUNCTION__, __FILE__);
+                }
+                mPendingFlush = true;
+            }
+            // Periodic flush
+            if (mPendingFlush && std::chrono::steady_clock::now() - mLastFlush >= mFlushPeriod)
+                flush();
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    void RepEventSaver::flush()
+    {
+        try
+        {
+            mOfstream.flush();
+            if (!mOfstream.good())
+                error("Repetition events could not be written.", __LINE__, __FUNCTION__, __FILE__);
+            mLastFlush = std::chrono::steady_clock::now();
+            mPendingFlush = false;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    void RepEventSaver::saveJsonLine(const RepetitionEvent& repetitionEvent, const unsigned long long frameNumber,
+                                     const long long timestamp)
+    {
+        try
+        {
+            const auto& exerciseName = (repetitionEvent.exercise < mExerciseNames.size()
+                                        ? mExerciseNames[repetitionEvent.exercise] : std::string{});
+            mOfstream << "{\"person_id\":" << repetitionEvent.personId
+                      << ",\"exercise\":" << toJsonString(exerciseName)
+                      << ",\"repetition\":" << repetitionEvent.repetition
+                      << ",\"frame\":" << frameNumber
+                      << ",\"time\":" << frameNumber / mFps
+                      << ",\"timestamp\":" << timestamp
+                      << ",\"phase_durations\":[";
+            for (auto phase = 0u ; phase < repetitionEvent.phaseDurations.size() ; phase++)
+                mOfstream << (phase > 0 ? "," : "") << repetitionEvent.phaseDurations[phase] / mFps;
+            mOfstream << "],\"confidence\":" << repetitionEvent.confidence << "}\n";
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    void RepEventSaver::saveBinary(const RepetitionEvent& repetitionEvent, const unsigned long long frameNumber,
+                                   const long long timestamp)
+    {
+        try
+        {
+            writeBinary(mOfstream, (std::int64_t)repetitionEvent.personId);
+            writeBinary(mOfstream, (std::uint64_t)frameNumber);
+            writeBinary(mOfstream, (std::int64_t)timestamp);
+            writeBinary(mOfstream, (std::uint32_t)repetitionEvent.exercise);
+            writeBinary(mOfstream, (std::int32_t)repetitionEvent.repetition);
+            writeBinary(mOfstream, repetitionEvent.confidence);
+            writeBinary(mOfstream, (std::uint32_t)repetitionEvent.phaseDurations.size());
+            for (const auto phaseDuration : repetitionEvent.phaseDurations)
+                writeBinary(mOfstream, (std::uint32_t)phaseDuration);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+}
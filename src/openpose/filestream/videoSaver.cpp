@@ -1,3 +1,4 @@
+#include <utility> // std::move
 #include <openpose/filestream/videoSaver.hpp>
 
 namespace op
@@ -17,12 +18,17 @@ namespace op
     }
 
     VideoSaver::VideoSaver(const std::string& videoSaverPath, const int cvFourcc, const double fps,
-                           const Point<int>& cvSize) :
+                           const Point<int>& cvSize, const unsigned int asyncQueueSize, const bool dropFramesIfFull) :
         mVideoSaverPath{videoSaverPath},
         mCvFourcc{cvFourcc},
         mFps{fps},
         mCvSize{cvSize},
-        mNumberImages{1}
+        mIsOpened{false},
+        mNumberImages{1},
+        mAsyncQueueSize{asyncQueueSize},
+        mDropFramesIfFull{dropFramesIfFull},
+        mCloseThread{false},
+        mNumberDroppedFrames{0ull}
     {
         try
         {
@@ -33,8 +39,9 @@ namespace op
                 error("Desired fps (frame rate) to save the video is <= 0.", __LINE__, __FUNCTION__, __FILE__);
             // Open video-writter
             mVideoWriter = openVideo(mVideoSaverPath, mCvFourcc, mFps, mCvSize, mNumberImages);
+            mIsOpened = mVideoWriter.isOpened();
             // Check it was successfully opened
-            if (!mVideoWriter.isOpened())
+            if (!mIsOpened)
             {
                 const std::string errorMessage{"Video to write frames could not be opened as `" + videoSaverPath
                                                + "`. Please, check that:\n\t1. The path ends in `.avi`."
@@ -42,6 +49,33 @@ namespace op
                                                " compiled with the FFmpeg codecs in order to save video."};
                 error(errorMessage, __LINE__, __FUNCTION__, __FILE__);
             }
+            // Start encoding thread
+            if (mAsyncQueueSize > 0u)
+                mThread = std::thread{&VideoSaver::encodingThread, this};
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    VideoSaver::~VideoSaver()
+    {
+        try
+        {
+            // Encode remaining frames, close and join thread
+            if (mThread.joinable())
+            {
+                {
+                    const std::lock_guard<std::mutex> lock{mQueueMutex};
+                    mCloseThread = true;
+                }
+                mQueueConditionVariable.notify_all();
+                mThread.join();
+            }
+            if (mNumberDroppedFrames > 0ull)
+                log("Number of frames dropped by the video saver (encoder too slow): "
+                    + std::to_string(mNumberDroppedFrames) + ".", Priority::High, __LINE__, __FUNCTION__, __FILE__);
         }
         catch (const std::exception& e)
         {
@@ -53,7 +87,8 @@ namespace op
     {
         try
         {
-            return mVideoWriter.isOpened();
+            // mVideoWriter might be being re-opened by the encoding thread
+            return mIsOpened;
         }
         catch (const std::exception& e)
         {
@@ -83,19 +118,83 @@ namespace op
                 error("Video to write frames is not opened.", __LINE__, __FUNCTION__, __FILE__);
             if (cvMats.empty())
                 error("The image(s) to be saved cannot be empty.", __LINE__, __FUNCTION__, __FILE__);
+            // Synchronous
+            if (mAsyncQueueSize == 0u)
+            {
+                // Concat images
+                cv::Mat cvOutputData;
+                if (cvMats.size() > 1)
+                    cv::hconcat(cvMats.data(), cvMats.size(), cvOutputData);
+                else
+                    cvOutputData = cvMats.at(0);
+                // Save concatenated image
+                encode(cvOutputData, (unsigned int)cvMats.size());
+            }
+            // Asynchronous
+            else
+            {
+                std::unique_lock<std::mutex> lock{mQueueMutex};
+                // Errors on the encoding thread are reported to the caller
+                if (mThreadException)
+                    std::rethrow_exception(mThreadException);
+                // Queue full
+                if (mQueue.size() >= mAsyncQueueSize)
+                {
+                    if (mDropFramesIfFull)
+                    {
+                        mNumberDroppedFrames++;
+                        return;
+                    }
+                    mQueueConditionVariable.wait(
+                        lock, [this]{ return mQueue.size() < mAsyncQueueSize || mThreadException; });
+                    if (mThreadException)
+                        std::rethrow_exception(mThreadException);
+                }
+                lock.unlock();
+                // Concat or deep-copy images (the caller might modify them while they are queued)
+                cv::Mat cvOutputData;
+                if (cvMats.size() > 1)
+                    cv::hconcat(cvMats.data(), cvMats.size(), cvOutputData);
+                else
+                    cvOutputData = cvMats.at(0).clone();
+                // Push into queue
+                lock.lock();
+                mQueue.emplace_back(cvOutputData, (unsigned int)cvMats.size());
+                lock.unlock();
+                mQueueConditionVariable.notify_all();
+            }
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    unsigned long long VideoSaver::getNumberDroppedFrames() const
+    {
+        try
+        {
+            return mNumberDroppedFrames;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return 0ull;
+        }
+    }
+
+    void VideoSaver::encode(const cv::Mat& cvOutputData, const unsigned int numberImages)
+    {
+        try
+        {
             // Re-shape video writer if required
-            if (mNumberImages != cvMats.size())
+            if (mNumberImages != numberImages)
             {
-                mNumberImages = cvMats.size();
+                mNumberImages = numberImages;
                 mVideoWriter = openVideo(mVideoSaverPath, mCvFourcc, mFps, mCvSize, mNumberImages);
+                mIsOpened = mVideoWriter.isOpened();
             }
-            // Concat images
-            cv::Mat cvOutputData;
-            if (cvMats.size() > 1)
-                cv::hconcat(cvMats.data(), cvMats.size(), cvOutputData);
-            else
-                cvOutputData = cvMats.at(0);
-            // Save concatenated image
+            // Save image
             mVideoWriter.write(cvOutputData);
         }
         catch (const std::exception& e)
@@ -103,4 +202,35 @@ namespace op
             error(e.what(), __LINE__, __FUNCTION__, __FILE__);
         }
     }
+
+    void VideoSaver::encodingThread()
+    {
+        try
+        {
+            std::unique_lock<std::mutex> lock{mQueueMutex};
+            while (true)
+            {
+                mQueueConditionVariable.wait(lock, [this]{ return !mQueue.empty() || mCloseThread; });
+                // Closing and all frames encoded
+                if (mQueue.empty())
+                    break;
+                // Encode frame (without blocking write())
+                auto frame = std::move(mQueue.front());
+                mQueue.pop_front();
+                lock.unlock();
+                mQueueConditionVariable.notify_all();
+                encode(frame.first, frame.second);
+                lock.lock();
+            }
+        }
+        catch (const std::exception& e)
+        {
+            // The exception is rethrown on the next write() (the destructor cannot throw)
+            {
+                const std::lock_guard<std::mutex> lock{mQueueMutex};
+                mThreadException = std::current_exception();
+            }
+            mQueueConditionVariable.notify_all();
+        }
+    }
 }
@@ -1,6 +1,9 @@
 #include <numeric> // std::accumulate
 #ifdef USE_CAFFE
+    #include <algorithm> // std::find_if
     #include <atomic>
+    #include <iterator> // std::prev
+    #include <list>
     #include <mutex>
     #include <caffe/net.hpp>
     #include <glog/logging.h> // google::InitGoogleLogging
@@ -24,6 +27,43 @@ namespace op
         std::atomic<bool> sOpenCLInitialized{false};
     #endif
 
+    #ifdef USE_CAFFE
+        // Caffe mode and device must have been set on the calling thread
+        std::unique_ptr<caffe::Net<float>> newCaffeNet(const std::string& caffeProto)
+        {
+            try
+            {
+                #ifdef USE_OPENCL
+                    return std::unique_ptr<caffe::Net<float>>{
+                        new caffe::Net<float>{caffeProto, caffe::TEST, caffe::Caffe::GetDefaultDevice()}};
+                #else
+                    return std::unique_ptr<caffe::Net<float>>{new caffe::Net<float>{caffeProto, caffe::TEST}};
+                #endif
+            }
+            catch (const std::exception& e)
+            {
+                error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+                return nullptr;
+            }
+        }
+
+        inline void reshapeNetCaffe(caffe::Net<float>* caffeNet, const std::vector<int>& dimensions)
+        {
+            try
+            {
+                caffeNet->blobs()[0]->Reshape(dimensions);
+                caffeNet->Reshape();
+                #ifdef USE_CUDA
+                    cudaCheck(__LINE__, __FUNCTION__, __FILE__);
+                #endif
+            }
+            catch (const std::exception& e)
+            {
+                error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            }
+        }
+    #endif
+
     struct NetCaffe::ImplNetCaffe
     {
         #ifdef USE_CAFFE
@@ -32,17 +72,21 @@ namespace op
             const std::string mCaffeProto;
             const std::string mCaffeTrainedModel;
             const std::string mLastBlobName;
-            std::vector<int> mNetInputSize4D;
+            const unsigned int mNetCacheSize;
             // Init with thread
-            std::unique_ptr<caffe::Net<float>> upCaffeNet;
+            // Nets reshaped for the last used input sizes (most recent first, i.e., the one used by forwardPass),
+            // all sharing the same trained weights. Empty size = not reshaped yet
+            std::list<std::pair<std::vector<int>, std::unique_ptr<caffe::Net<float>>>> mCaffeNets;
             boost::shared_ptr<caffe::Blob<float>> spOutputBlob;
 
             ImplNetCaffe(const std::string& caffeProto, const std::string& caffeTrainedModel, const int gpuId,
-                         const bool enableGoogleLogging, const std::string& lastBlobName) :
+                         const bool enableGoogleLogging, const std::string& lastBlobName,
+                         const int netCacheSize) :
                 mGpuId{gpuId},
                 mCaffeProto{caffeProto},
                 mCaffeTrainedModel{caffeTrainedModel},
-                mLastBlobName{lastBlobName}
+                mLastBlobName{lastBlobName},
+                mNetCacheSize{(unsigned int)std::max(1, netCacheSize)}
             {
                 const std::string message{".\nPossible causes:\n\t1. Not downloading the OpenPose trained models."
                                           "\n\t2. Not running OpenPose from the same directory where the `model`"
@@ -82,32 +126,46 @@ namespace op
                     }
                 #endif
             }
-        #endif
-    };
 
-    #ifdef USE_CAFFE
-        inline void reshapeNetCaffe(caffe::Net<float>* caffeNet, const std::vector<int>& dimensions)
-        {
-            try
+            // Most recently used net reshaped for netInputSize4D (cached one if any, otherwise a new one sharing the
+            // trained weights, or the least recently used one reshaped if the cache is full)
+            void reshape(const std::vector<int>& netInputSize4D)
             {
-                caffeNet->blobs()[0]->Reshape(dimensions);
-                caffeNet->Reshape();
-                #ifdef USE_CUDA
-                    cudaCheck(__LINE__, __FUNCTION__, __FILE__);
-                #endif
-            }
-            catch (const std::exception& e)
-            {
-                error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+                if (mCaffeNets.empty())
+                    error("NetCaffe::initializationOnThread() must be called first.",
+                          __LINE__, __FUNCTION__, __FILE__);
+                if (vectorsAreEqual(mCaffeNets.front().first, netInputSize4D))
+                    return;
+                auto cachedNet = std::find_if(mCaffeNets.begin(), mCaffeNets.end(),
+                    [&](const std::pair<std::vector<int>, std::unique_ptr<caffe::Net<float>>>& caffeNet)
+                    {
+                        return vectorsAreEqual(caffeNet.first, netInputSize4D);
+                    });
+                if (cachedNet != mCaffeNets.end())
+                    mCaffeNets.splice(mCaffeNets.begin(), mCaffeNets, cachedNet);
+                else
+                {
+                    if (mCaffeNets.size() < mNetCacheSize && !mCaffeNets.back().first.empty())
+                    {
+                        auto caffeNet = newCaffeNet(mCaffeProto);
+                        caffeNet->ShareTrainedLayersWith(mCaffeNets.front().second.get());
+                        mCaffeNets.emplace_front(std::vector<int>{}, std::move(caffeNet));
+                    }
+                    else
+                        mCaffeNets.splice(mCaffeNets.begin(), mCaffeNets, std::prev(mCaffeNets.end()));
+                    mCaffeNets.front().first = netInputSize4D;
+                    reshapeNetCaffe(mCaffeNets.front().second.get(), netInputSize4D);
+                }
+                spOutputBlob = mCaffeNets.front().second->blob_by_name(mLastBlobName);
             }
-        }
-    #endif
+        #endif
+    };
 
     NetCaffe::NetCaffe(const std::string& caffeProto, const std::string& caffeTrainedModel, const int gpuId,
-                       const bool enableGoogleLogging, const std::string& lastBlobName)
+                       const bool enableGoogleLogging, const std::string& lastBlobName, const int netCacheSize)
         #ifdef USE_CAFFE
             : upImpl{new ImplNetCaffe{caffeProto, caffeTrainedModel, gpuId, enableGoogleLogging,
-                                      lastBlobName}}
+                                      lastBlobName, netCacheSize}}
         #endif
     {
         try
@@ -118,6 +176,7 @@ namespace op
                 UNUSED(caffeTrainedModel);
                 UNUSED(gpuId);
                 UNUSED(lastBlobName);
+                UNUSED(netCacheSize);
                 error("OpenPose must be compiled with the `USE_CAFFE` macro definition in order to use this"
                       " functionality.", __LINE__, __FUNCTION__, __FILE__);
             #endif
@@ -141,9 +200,8 @@ namespace op
                 #ifdef USE_OPENCL
                     caffe::Caffe::set_mode(caffe::Caffe::GPU);
                     caffe::Caffe::SelectDevice(upImpl->mGpuId, true);
-                    upImpl->upCaffeNet.reset(new caffe::Net<float>{upImpl->mCaffeProto, caffe::TEST,
-                                             caffe::Caffe::GetDefaultDevice()});
-                    upImpl->upCaffeNet->CopyTrainedLayersFrom(upImpl->mCaffeTrainedModel);
+                    upImpl->mCaffeNets.emplace_back(std::vector<int>{}, newCaffeNet(upImpl->mCaffeProto));
+                    upImpl->mCaffeNets.front().second->CopyTrainedLayersFrom(upImpl->mCaffeTrainedModel);
                     op::OpenCL::getInstance(upImpl->mGpuId, CL_DEVICE_TYPE_GPU, true);
                 #else
                     #ifdef USE_CUDA
@@ -152,14 +210,14 @@ namespace op
                     #else
                         caffe::Caffe::set_mode(caffe::Caffe::CPU);
                     #endif
-                    upImpl->upCaffeNet.reset(new caffe::Net<float>{upImpl->mCaffeProto, caffe::TEST});
-                    upImpl->upCaffeNet->CopyTrainedLayersFrom(upImpl->mCaffeTrainedModel);
+                    upImpl->mCaffeNets.emplace_back(std::vector<int>{}, newCaffeNet(upImpl->mCaffeProto));
+                    upImpl->mCaffeNets.front().second->CopyTrainedLayersFrom(upImpl->mCaffeTrainedModel);
                     #ifdef USE_CUDA
                         cudaCheck(__LINE__, __FUNCTION__, __FILE__);
                     #endif
                 #endif
                 // Set spOutputBlob
-                upImpl->spOutputBlob = upImpl->upCaffeNet->blob_by_name(upImpl->mLastBlobName);
+                upImpl->spOutputBlob = upImpl->mCaffeNets.front().second->blob_by_name(upImpl->mLastBlobName);
                 if (upImpl->spOutputBlob == nullptr)
                     error("The output blob is a nullptr. Did you use the same name than the prototxt? (Used: "
                           + upImpl->mLastBlobName + ").", __LINE__, __FUNCTION__, __FILE__);
@@ -185,29 +243,26 @@ namespace op
                 if (inputData.getNumberDimensions() != 4 || inputData.getSize(1) != 3)
                     error("The Array inputData must have 4 dimensions: [batch size, 3 (RGB), height, width].",
                           __LINE__, __FUNCTION__, __FILE__);
-                // Reshape Caffe net if required
-                if (!vectorsAreEqual(upImpl->mNetInputSize4D, inputData.getSize()))
-                {
-                    upImpl->mNetInputSize4D = inputData.getSize();
-                    reshapeNetCaffe(upImpl->upCaffeNet.get(), inputData.getSize());
-                }
+                // Reshape Caffe net (or select the cached one) if required
+                upImpl->reshape(inputData.getSize());
+                auto* const caffeNet = upImpl->mCaffeNets.front().second.get();
                 // Copy frame data to GPU memory
                 #ifdef USE_CUDA
-                    auto* gpuImagePtr = upImpl->upCaffeNet->blobs().at(0)->mutable_gpu_data();
+                    auto* gpuImagePtr = caffeNet->blobs().at(0)->mutable_gpu_data();
                     cudaMemcpy(gpuImagePtr, inputData.getConstPtr(), inputData.getVolume() * sizeof(float),
                                cudaMemcpyHostToDevice);
                 #elif defined USE_OPENCL
-                    auto* gpuImagePtr = upImpl->upCaffeNet->blobs().at(0)->mutable_gpu_data();
+                    auto* gpuImagePtr = caffeNet->blobs().at(0)->mutable_gpu_data();
                     cl::Buffer imageBuffer = cl::Buffer((cl_mem)gpuImagePtr, true);
                     op::OpenCL::getInstance(upImpl->mGpuId)->getQueue().enqueueWriteBuffer(imageBuffer, true, 0,
                                                                                            inputData.getVolume() * sizeof(float),
                                                                                            inputData.getConstPtr());
                 #else
-                    auto* cpuImagePtr = upImpl->upCaffeNet->blobs().at(0)->mutable_cpu_data();
+                    auto* cpuImagePtr = caffeNet->blobs().at(0)->mutable_cpu_data();
                     std::copy(inputData.getConstPtr(), inputData.getConstPtr() + inputData.getVolume(), cpuImagePtr);
                 #endif
                 // Perform deep network forward pass
-                upImpl->upCaffeNet->ForwardFrom(0);
+                caffeNet->ForwardFrom(0);
                 // Cuda checks
                 #ifdef USE_CUDA
                     cudaCheck(__LINE__, __FUNCTION__, __FILE__);
@@ -222,6 +277,28 @@ namespace op
         }
     }
 
+    void NetCaffe::reshape(const std::vector<int>& netInputSize4D)
+    {
+        try
+        {
+            #ifdef USE_CAFFE
+                // Security checks
+                if (netInputSize4D.size() != 4 || netInputSize4D[1] != 3)
+                    error("The net input size must have 4 dimensions: [batch size, 3 (RGB), height, width].",
+                          __LINE__, __FUNCTION__, __FILE__);
+                if (netInputSize4D[0] <= 0 || netInputSize4D[2] <= 0 || netInputSize4D[3] <= 0)
+                    error("The net input size must be positive.", __LINE__, __FUNCTION__, __FILE__);
+                upImpl->reshape(netInputSize4D);
+            #else
+                UNUSED(netInputSize4D);
+            #endif
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
     boost::shared_ptr<caffe::Blob<float>> NetCaffe::getOutputBlob() const
     {
         try
@@ -1,4 +1,10 @@
+#include <algorithm> // std::sort, std::unique
+#include <cmath> // std::ceil, std::floor
+#include <cstring> // std::memset
 #include <opencv2/opencv.hpp>
+#include <openpose/net/resizeAndMergeBase.hpp>
+#include <openpose/thread/threadPool.hpp>
+#include <openpose/utilities/fastMath.hpp>
 #include <openpose/net/nmsBase.hpp>
 
 namespace op
@@ -106,6 +112,89 @@ namespace op
         output[2] = sourcePtr[peakLocY*width + peakLocX];
     }
 
+    template <typename T>
+    int nmsRegisterKernelRowCPU(int* kernelPtr, const T* const sourcePtr, const int w, const int h,
+                                const T threshold, const int y)
+    {
+        // Equivalent to nmsRegisterKernelCPU for the whole row y, returning its number of peaks
+        auto* kernelRowPtr = &kernelPtr[y*w];
+        // Border rows/columns (2 pixels): Scalar special cases of nmsRegisterKernelCPU
+        if (y < 2 || y >= h-2 || w < 5)
+        {
+            auto numberPeaks = 0;
+            for (auto x = 0 ; x < w ; x++)
+            {
+                nmsRegisterKernelCPU(kernelPtr, sourcePtr, w, h, threshold, x, y);
+                numberPeaks += kernelRowPtr[x];
+            }
+            return numberPeaks;
+        }
+        const auto* const rowTop = &sourcePtr[(y-1)*w];
+        const auto* const rowMiddle = &sourcePtr[y*w];
+        const auto* const rowBottom = &sourcePtr[(y+1)*w];
+        // Most rows are background -> skipped after a single (vectorizable) pass
+        auto numberCandidates = 0;
+        for (auto x = 2 ; x < w-2 ; x++)
+            numberCandidates += int(rowMiddle[x] > threshold);
+        auto numberPeaks = 0;
+        if (numberCandidates == 0)
+            std::memset(&kernelRowPtr[2], 0, (w-4) * sizeof(int));
+        else
+        {
+            // Branchless comparison of the whole row against its 8 shifted neighbours (auto-vectorized)
+            for (auto x = 2 ; x < w-2 ; x++)
+            {
+                const auto value = rowMiddle[x];
+                const auto isPeak = int(value > threshold)
+                                  & int(value > rowTop[x-1]) & int(value > rowTop[x]) & int(value > rowTop[x+1])
+                                  & int(value > rowMiddle[x-1]) & int(value > rowMiddle[x+1])
+                                  & int(value > rowBottom[x-1]) & int(value > rowBottom[x])
+                                  & int(value > rowBottom[x+1]);
+                kernelRowPtr[x] = isPeak;
+                numberPeaks += isPeak;
+            }
+        }
+        for (const auto x : {0, 1, w-2, w-1})
+        {
+            nmsRegisterKernelCPU(kernelPtr, sourcePtr, w, h, threshold, x, y);
+            numberPeaks += kernelRowPtr[x];
+        }
+        return numberPeaks;
+    }
+
+    template <typename T>
+    void nmsChannelCpu(T* currTargetPtr, int* currKernelPtr, const T* const currSourcePtr, const T threshold,
+                       const int sourceWidth, const int sourceHeight, const int targetPeaks, const Point<T>& offset,
+                       std::vector<int>& rowPeaks)
+    {
+        // Peak mask, row by row
+        rowPeaks.resize(sourceHeight);
+        for (auto y = 0; y < sourceHeight; y++)
+            rowPeaks[y] = nmsRegisterKernelRowCPU(currKernelPtr, currSourcePtr, sourceWidth, sourceHeight, threshold,
+                                                  y);
+        // Compaction into the peaks (only rows with peaks are read)
+        auto currentPeakCount = 1;
+        for (auto y = 0; y < sourceHeight && currentPeakCount < targetPeaks; y++)
+        {
+            if (rowPeaks[y] > 0)
+            {
+                const auto* const currKernelRowPtr = &currKernelPtr[y*sourceWidth];
+                for (auto x = 0; x < sourceWidth && currentPeakCount < targetPeaks; x++)
+                {
+                    // Find high intensity points
+                    if (currKernelRowPtr[x] == 1)
+                    {
+                        // Accurate Peak Position
+                        nmsAccuratePeakPosition(&currTargetPtr[currentPeakCount*3], currSourcePtr, x, y,
+                                                sourceWidth, sourceHeight, offset);
+                        currentPeakCount++;
+                    }
+                }
+            }
+        }
+        currTargetPtr[0] = currentPeakCount-1;
+    }
+
     template <typename T>
     void nmsCpu(T* targetPtr, int* kernelPtr, const T* const sourcePtr, const T threshold,
                 const std::array<int, 4>& targetSize, const std::array<int, 4>& sourceSize,
@@ -130,40 +219,178 @@ namespace op
             const auto sourceChannelOffset = sourceWidth * sourceHeight;
             const auto targetChannelOffset = targetPeaks * targetPeakVec;
 
-            // Per channel operation
-            for (auto c = 0 ; c < channels ; c++)
+            // Per channel operation (channels are independent -> split among the ThreadPool threads, if enabled)
+            parallelFor(channels, [&](const int startChannel, const int endChannel)
             {
-                auto* currKernelPtr = &kernelPtr[c*sourceChannelOffset];
-                const T* currSourcePtr = &sourcePtr[c*sourceChannelOffset];
+                std::vector<int> rowPeaks;
+                for (auto c = startChannel ; c < endChannel ; c++)
+                    nmsChannelCpu(&targetPtr[c*targetChannelOffset], &kernelPtr[c*sourceChannelOffset],
+                                  &sourcePtr[c*sourceChannelOffset], threshold, sourceWidth, sourceHeight,
+                                  targetPeaks, offset, rowPeaks);
+            });
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
 
-                for (auto y = 0; y < sourceHeight; y++)
-                    for (auto x = 0; x < sourceWidth; x++)
-                        nmsRegisterKernelCPU(currKernelPtr, currSourcePtr, sourceWidth, sourceHeight, threshold, x, y);
+    template <typename T>
+    bool nmsIsPeakWindowCPU(const T* const windowPtr, const Rectangle<int>& window, const int w, const int h,
+                            const T threshold, const int x, const int y)
+    {
+        // Same rules than nmsRegisterKernelCPU, reading the w x h map from its window (containing the 8 neighbours)
+        if (x < 1 || x > w-2 || y < 1 || y > h-2)
+            return false;
+        const auto* const centerPtr = &windowPtr[(y-window.y)*window.width + x-window.x];
+        const auto value = *centerPtr;
+        if (!(value > threshold))
+            return false;
+        // 1st inner border: cv::resize artifacts -> non-strict maximum
+        const auto innerBorder = (x == 1 || x == w-2 || y == 1 || y == h-2);
+        for (auto dy = -1 ; dy <= 1 ; dy++)
+        {
+            for (auto dx = -1 ; dx <= 1 ; dx++)
+            {
+                if (dx != 0 || dy != 0)
+                {
+                    const auto neighbour = centerPtr[dy*window.width + dx];
+                    if (innerBorder ? value < neighbour : value <= neighbour)
+                        return false;
+                }
+            }
+        }
+        return true;
+    }
 
-                auto currentPeakCount = 1;
-                auto* currTargetPtr = &targetPtr[c*targetChannelOffset];
-                for (auto y = 0; y < sourceHeight; y++)
+    template <typename T>
+    void nmsCoarseToFineChannelCpu(T* currTargetPtr, const T* const currSourcePtr, const T threshold,
+                                   const int sourceWidth, const int sourceHeight, const Point<int>& upsampledSize,
+                                   const int targetPeaks, const Point<T>& offset, std::vector<T>& windowValues,
+                                   std::vector<std::pair<int, std::array<T, 3>>>& peaks)
+    {
+        // The cubic kernel (A = -0.75) weights sum at most ~1.41 in absolute value -> upsampled values above
+        // threshold can only be found around net-resolution values above ~threshold/1.41
+        const auto candidateThreshold = T(0.7)*threshold;
+        const auto scaleX = sourceWidth / (double)upsampledSize.x;
+        const auto scaleY = sourceHeight / (double)upsampledSize.y;
+        // Sub-pixel refinement radius of nmsAccuratePeakPosition
+        const auto refinementRadius = 3;
+        peaks.clear();
+        for (auto cy = 0 ; cy < sourceHeight ; cy++)
+        {
+            for (auto cx = 0 ; cx < sourceWidth ; cx++)
+            {
+                // Candidate: local maximum (non-strict) of the net-resolution map
+                const auto value = currSourcePtr[cy*sourceWidth + cx];
+                if (!(value > candidateThreshold))
+                    continue;
+                auto isCandidate = true;
+                for (auto dy = -1 ; dy <= 1 && isCandidate ; dy++)
                 {
-                    for (auto x = 0; x < sourceWidth; x++)
-                    {
-                        const auto index = y*sourceWidth + x;
-                        // Find high intensity points
-                        if (currentPeakCount < targetPeaks)
+                    const auto y = cy + dy;
+                    if (0 <= y && y < sourceHeight)
+                        for (auto dx = -1 ; dx <= 1 ; dx++)
                         {
-                            if (currKernelPtr[index] == 1)
+                            const auto x = cx + dx;
+                            if (0 <= x && x < sourceWidth && currSourcePtr[y*sourceWidth + x] > value)
                             {
-                                // Accurate Peak Position
-                                nmsAccuratePeakPosition(&currTargetPtr[currentPeakCount*3], currSourcePtr, x, y,
-                                                        sourceWidth, sourceHeight, offset);
-                                currentPeakCount++;
+                                isCandidate = false;
+                                break;
                             }
                         }
-
+                }
+                if (!isCandidate)
+                    continue;
+                // Upsampled pixels whose source coordinate is within 1 net-resolution pixel of the candidate (the
+                // outer border is never a peak)
+                const auto xMin = fastMax(1, (int)std::ceil((cx - 0.5) / scaleX - 0.5));
+                const auto xMax = fastMin(upsampledSize.x-2, (int)std::floor((cx + 1.5) / scaleX - 0.5));
+                const auto yMin = fastMax(1, (int)std::ceil((cy - 0.5) / scaleY - 0.5));
+                const auto yMax = fastMin(upsampledSize.y-2, (int)std::floor((cy + 1.5) / scaleY - 0.5));
+                if (xMin > xMax || yMin > yMax)
+                    continue;
+                // Upsampled values in that area + the NMS neighbours and refinement pixels
+                const auto windowX = fastMax(0, xMin - refinementRadius);
+                const auto windowY = fastMax(0, yMin - refinementRadius);
+                const Rectangle<int> window{
+                    windowX, windowY,
+                    fastMin(upsampledSize.x-1, xMax + refinementRadius) - windowX + 1,
+                    fastMin(upsampledSize.y-1, yMax + refinementRadius) - windowY + 1};
+                windowValues.resize(window.area());
+                resizeCubicRegionCpu(windowValues.data(), currSourcePtr, Point<int>{sourceWidth, sourceHeight},
+                                     upsampledSize, window);
+                // NMS + refinement in the window
+                const Point<T> windowOffset{offset.x + window.x, offset.y + window.y};
+                for (auto y = yMin ; y <= yMax ; y++)
+                {
+                    for (auto x = xMin ; x <= xMax ; x++)
+                    {
+                        if (nmsIsPeakWindowCPU(windowValues.data(), window, upsampledSize.x, upsampledSize.y,
+                                               threshold, x, y))
+                        {
+                            peaks.emplace_back(std::make_pair(y*upsampledSize.x + x, std::array<T, 3>{}));
+                            nmsAccuratePeakPosition(peaks.back().second.data(), windowValues.data(), x - window.x,
+                                                    y - window.y, window.width, window.height, windowOffset);
+                        }
                     }
                 }
-                currTargetPtr[0] = currentPeakCount-1;
             }
         }
+        // Same order than nmsCpu (row-major), without the duplicates of overlapping windows
+        std::sort(peaks.begin(), peaks.end(),
+                  [](const std::pair<int, std::array<T, 3>>& a, const std::pair<int, std::array<T, 3>>& b)
+                  {
+                      return a.first < b.first;
+                  });
+        peaks.erase(std::unique(peaks.begin(), peaks.end(),
+                                [](const std::pair<int, std::array<T, 3>>& a,
+                                   const std::pair<int, std::array<T, 3>>& b)
+                                {
+                                    return a.first == b.first;
+                                }),
+                    peaks.end());
+        const auto numberPeaks = fastMin((int)peaks.size(), targetPeaks-1);
+        for (auto p = 0 ; p < numberPeaks ; p++)
+            std::copy(peaks[p].second.begin(), peaks[p].second.end(), &currTargetPtr[(p+1)*3]);
+        currTargetPtr[0] = T(numberPeaks);
+    }
+
+    template <typename T>
+    void nmsCoarseToFineCpu(T* targetPtr, const T* const sourcePtr, const T threshold,
+                            const std::array<int, 4>& targetSize, const std::array<int, 4>& sourceSize,
+                            const Point<int>& upsampledSize, const Point<T>& offset)
+    {
+        try
+        {
+            // Security checks
+            if (threshold < 0 || threshold > 1.0)
+                error("threshold value invalid.", __LINE__, __FUNCTION__, __FILE__);
+            if (upsampledSize.x < sourceSize[3] || upsampledSize.y < sourceSize[2])
+                error("upsampledSize cannot be smaller than the source size.", __LINE__, __FUNCTION__, __FILE__);
+            if (targetSize[1] > sourceSize[1])
+                error("More target than source channels.", __LINE__, __FUNCTION__, __FILE__);
+
+            // Params
+            const auto channels = targetSize[1]; // 18
+            const auto sourceHeight = sourceSize[2]; // 46
+            const auto sourceWidth = sourceSize[3]; // 62
+            const auto targetPeaks = targetSize[2]; // 97
+            const auto targetPeakVec = targetSize[3]; // 3
+            const auto sourceChannelOffset = sourceWidth * sourceHeight;
+            const auto targetChannelOffset = targetPeaks * targetPeakVec;
+
+            // Per channel operation (channels are independent -> split among the ThreadPool threads, if enabled)
+            parallelFor(channels, [&](const int startChannel, const int endChannel)
+            {
+                std::vector<T> windowValues;
+                std::vector<std::pair<int, std::array<T, 3>>> peaks;
+                for (auto c = startChannel ; c < endChannel ; c++)
+                    nmsCoarseToFineChannelCpu(&targetPtr[c*targetChannelOffset], &sourcePtr[c*sourceChannelOffset],
+                                              threshold, sourceWidth, sourceHeight, upsampledSize, targetPeaks,
+                                              offset, windowValues, peaks);
+            });
+        }
         catch (const std::exception& e)
         {
             error(e.what(), __LINE__, __FUNCTION__, __FILE__);
@@ -176,4 +403,10 @@ namespace op
     template void nmsCpu(double* targetPtr, int* kernelPtr, const double* const sourcePtr, const double threshold,
                          const std::array<int, 4>& targetSize, const std::array<int, 4>& sourceSize,
                          const Point<double>& offset);
+    template void nmsCoarseToFineCpu(float* targetPtr, const float* const sourcePtr, const float threshold,
+                                     const std::array<int, 4>& targetSize, const std::array<int, 4>& sourceSize,
+                                     const Point<int>& upsampledSize, const Point<float>& offset);
+    template void nmsCoarseToFineCpu(double* targetPtr, const double* const sourcePtr, const double threshold,
+                                     const std::array<int, 4>& targetSize, const std::array<int, 4>& sourceSize,
+                                     const Point<int>& upsampledSize, const Point<double>& offset);
 }
@@ -1,11 +1,31 @@
+#include <cmath> // std::floor
 #include <opencv2/highgui/highgui.hpp>
 #include <opencv2/imgproc/imgproc.hpp>
+#include <openpose/thread/threadPool.hpp>
 #include <openpose/utilities/fastMath.hpp>
 #include <openpose/utilities/openCv.hpp>
 #include <openpose/net/resizeAndMergeBase.hpp>
 
 namespace op
 {
+    template <typename T>
+    inline void resizeCubicCoefficients(std::array<int, 4>& indexes, std::array<T, 4>& coefficients,
+                                        const int targetIndex, const double scale, const int sourceLength)
+    {
+        // Same sampling, coefficients (A = -0.75) and border replication than cv::resize with CV_INTER_CUBIC
+        auto sourceIndexFloat = (float)((targetIndex + 0.5) * scale - 0.5);
+        const auto sourceIndex = (int)std::floor(sourceIndexFloat);
+        sourceIndexFloat -= sourceIndex;
+        const auto A = -0.75f;
+        const auto x = sourceIndexFloat;
+        coefficients[0] = T(((A*(x + 1) - 5*A)*(x + 1) + 8*A)*(x + 1) - 4*A);
+        coefficients[1] = T(((A + 2)*x - (A + 3))*x*x + 1);
+        coefficients[2] = T(((A + 2)*(1 - x) - (A + 3))*(1 - x)*(1 - x) + 1);
+        coefficients[3] = T(1) - coefficients[0] - coefficients[1] - coefficients[2];
+        for (auto k = 0 ; k < 4 ; k++)
+            indexes[k] = fastMin(fastMax(sourceIndex + k - 1, 0), sourceLength - 1);
+    }
+
     template <typename T>
     void resizeAndMergeCpu(T* targetPtr, const std::vector<const T*>& sourcePtrs,
                            const std::array<int, 4>& targetSize,
@@ -21,6 +41,10 @@ namespace op
             // Security checks
             if (sourceSizes.empty())
                 error("sourceSizes cannot be empty.", __LINE__, __FUNCTION__, __FILE__);
+            for (const auto& sourceSize : sourceSizes)
+                if (sourceSize[0] != 1)
+                    error("It should never reache this point. Notify us otherwise.",
+                          __LINE__, __FUNCTION__, __FILE__);
 
             // Params
             const auto nums = (signed)sourceSizes.size();
@@ -29,83 +53,48 @@ namespace op
             const auto targetWidth = targetSize[3]; // 496
             const auto targetChannelOffset = targetWidth * targetHeight;
 
-            // No multi-scale merging or no merging required
-            if (sourceSizes.size() == 1)
+            // Per channel resize (+ merge of the different scales). Channels are independent -> split among the
+            // ThreadPool threads, if enabled
+            parallelFor(channels, [&](const int startChannel, const int endChannel)
             {
-                // Params
-                const auto& sourceSize = sourceSizes[0];
-                const auto sourceHeight = sourceSize[2]; // 368/8 ..
-                const auto sourceWidth = sourceSize[3]; // 496/8 ..
-                const auto sourceChannelOffset = sourceHeight * sourceWidth;
-                if (sourceSize[0] != 1)
-                    error("It should never reache this point. Notify us otherwise.",
-                          __LINE__, __FUNCTION__, __FILE__);
-
-                // Per channel resize
-                const T* sourcePtr = sourcePtrs[0];
-                for (auto c = 0 ; c < channels ; c++)
+                // Resized channel of the scales > 0 (one per thread, kept between frames)
+                thread_local std::vector<T> tempTarget;
+                if (nums > 1)
+                    tempTarget.resize(targetChannelOffset);
+                const auto averageFactor = T(1) / T(nums);
+                for (auto c = startChannel ; c < endChannel ; c++)
                 {
-                    cv::Mat source(cv::Size(sourceWidth, sourceHeight), CV_32FC1,
-                                   const_cast<T*>(&sourcePtr[c*sourceChannelOffset]));
-                    cv::Mat target(cv::Size(targetWidth, targetHeight), CV_32FC1,
-                                   (&targetPtr[c*targetChannelOffset]));
-                    cv::resize(source, target, {targetWidth, targetHeight}, 0, 0, CV_INTER_CUBIC);
-                }
-            }
-            // Multi-scale merging
-            else
-            {
-                // Construct temp targets. We resuse targetPtr to store first scale
-                std::vector<std::unique_ptr<T>> tempTargetPtrs;
-                for (auto n = 1; n < nums; n++){
-                    tempTargetPtrs.emplace_back(std::unique_ptr<T>(new T[targetChannelOffset * channels]()));
-                }
-
-                // Resize and sum
-                for (auto n = 0; n < nums; n++){
-
-                    // Params
-                    const auto& sourceSize = sourceSizes[n];
-                    const auto sourceHeight = sourceSize[2]; // 368/6 ..
-                    const auto sourceWidth = sourceSize[3]; // 496/8 ..
-                    const auto sourceChannelOffset = sourceHeight * sourceWidth;
-
-                    // Access pointers
-                    const T* sourcePtr = sourcePtrs[n];
-                    T* tempTargetPtr;
-                    if (n != 0)
-                        tempTargetPtr = tempTargetPtrs[n-1].get();
-                    else
-                        tempTargetPtr = targetPtr;
-
-                    T* firstTempTargetPtr = targetPtr;
-                    for (auto c = 0 ; c < channels ; c++)
+                    auto* currTargetPtr = &targetPtr[c*targetChannelOffset];
+                    cv::Mat target(cv::Size(targetWidth, targetHeight), CV_32FC1, currTargetPtr);
+                    for (auto n = 0 ; n < nums ; n++)
                     {
-                        // Resize
+                        // Params
+                        const auto& sourceSize = sourceSizes[n];
+                        const auto sourceHeight = sourceSize[2]; // 368/8 ..
+                        const auto sourceWidth = sourceSize[3]; // 496/8 ..
+                        const auto sourceChannelOffset = sourceHeight * sourceWidth;
                         cv::Mat source(cv::Size(sourceWidth, sourceHeight), CV_32FC1,
-                                       const_cast<T*>(&sourcePtr[c*sourceChannelOffset]));
-                        cv::Mat target(cv::Size(targetWidth, targetHeight), CV_32FC1,
-                                       (&tempTargetPtr[c*targetChannelOffset]));
-                        cv::resize(source, target, {targetWidth, targetHeight}, 0, 0, CV_INTER_CUBIC);
-
-                        // Add
-                        if (n != 0)
+                                       const_cast<T*>(&sourcePtrs[n][c*sourceChannelOffset]));
+                        // First scale: Resized directly into targetPtr
+                        if (n == 0)
+                            cv::resize(source, target, {targetWidth, targetHeight}, 0, 0, CV_INTER_CUBIC);
+                        // Other scales: Resized into tempTarget, and accumulated (and averaged with the last one)
+                        // in a single auto-vectorized pass
+                        else
                         {
-                            cv::Mat addTarget(cv::Size(targetWidth, targetHeight), CV_32FC1,
-                                              (&firstTempTargetPtr[c*targetChannelOffset]));
-                            cv::add(target, addTarget, addTarget);
+                            cv::Mat tempTargetMat(cv::Size(targetWidth, targetHeight), CV_32FC1, tempTarget.data());
+                            cv::resize(source, tempTargetMat, {targetWidth, targetHeight}, 0, 0, CV_INTER_CUBIC);
+                            const auto* const tempTargetPtr = tempTarget.data();
+                            if (n < nums-1)
+                                for (auto i = 0 ; i < targetChannelOffset ; i++)
+                                    currTargetPtr[i] += tempTargetPtr[i];
+                            else
+                                for (auto i = 0 ; i < targetChannelOffset ; i++)
+                                    currTargetPtr[i] = (currTargetPtr[i] + tempTargetPtr[i]) * averageFactor;
                         }
                     }
                 }
-
-                // Average
-                for (auto c = 0 ; c < channels ; c++)
-                {
-                    cv::Mat target(cv::Size(targetWidth, targetHeight), CV_32FC1, (&targetPtr[c*targetChannelOffset]));
-                    target /= (float)nums;
-                }
-
-            }
+            });
         }
         catch (const std::exception& e)
         {
@@ -121,4 +110,67 @@ namespace op
                                     const std::array<int, 4>& targetSize,
                                     const std::vector<std::array<int, 4>>& sourceSizes,
                                     const std::vector<double>& scaleInputToNetInputs);
+
+    template <typename T>
+    void resizeCubicRegionCpu(T* targetPtr, const T* const sourcePtr, const Point<int>& sourceSize,
+                              const Point<int>& targetSize, const Rectangle<int>& targetRegion)
+    {
+        try
+        {
+            // Security checks
+            if (targetRegion.x < 0 || targetRegion.y < 0 || targetRegion.x + targetRegion.width > targetSize.x
+                || targetRegion.y + targetRegion.height > targetSize.y)
+                error("targetRegion must be inside the target image.", __LINE__, __FUNCTION__, __FILE__);
+
+            // Params
+            const auto scaleX = sourceSize.x / (double)targetSize.x;
+            const auto scaleY = sourceSize.y / (double)targetSize.y;
+            // Column coefficients computed once per block of columns (no heap allocation for small regions)
+            const auto blockWidth = 64;
+            std::array<std::array<int, 4>, blockWidth> indexesX;
+            std::array<std::array<T, 4>, blockWidth> coefficientsX;
+            std::array<int, 4> indexesY;
+            std::array<T, 4> coefficientsY;
+
+            for (auto xBlock = 0 ; xBlock < targetRegion.width ; xBlock += blockWidth)
+            {
+                const auto xBlockEnd = fastMin(xBlock + blockWidth, targetRegion.width);
+                for (auto x = xBlock ; x < xBlockEnd ; x++)
+                    resizeCubicCoefficients(indexesX[x-xBlock], coefficientsX[x-xBlock], targetRegion.x + x,
+                                            scaleX, sourceSize.x);
+                // Horizontal interpolation of the 4 source rows, then vertical one (as cv::resize)
+                for (auto y = 0 ; y < targetRegion.height ; y++)
+                {
+                    resizeCubicCoefficients(indexesY, coefficientsY, targetRegion.y + y, scaleY, sourceSize.y);
+                    auto* targetRowPtr = &targetPtr[y*targetRegion.width];
+                    for (auto x = xBlock ; x < xBlockEnd ; x++)
+                    {
+                        const auto& indexes = indexesX[x-xBlock];
+                        const auto& coefficients = coefficientsX[x-xBlock];
+                        auto value = T(0);
+                        for (auto ky = 0 ; ky < 4 ; ky++)
+                        {
+                            const auto* const sourceRowPtr = &sourcePtr[indexesY[ky]*sourceSize.x];
+                            const auto rowValue = sourceRowPtr[indexes[0]]*coefficients[0]
+                                                + sourceRowPtr[indexes[1]]*coefficients[1]
+                                                + sourceRowPtr[indexes[2]]*coefficients[2]
+                                                + sourceRowPtr[indexes[3]]*coefficients[3];
+                            value += coefficientsY[ky]*rowValue;
+                        }
+                        targetRowPtr[x] = value;
+                    }
+                }
+            }
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    template void resizeCubicRegionCpu(float* targetPtr, const float* const sourcePtr, const Point<int>& sourceSize,
+                                       const Point<int>& targetSize, const Rectangle<int>& targetRegion);
+    template void resizeCubicRegionCpu(double* targetPtr, const double* const sourcePtr,
+                                       const Point<int>& sourceSize, const Point<int>& targetSize,
+                                       const Rectangle<int>& targetRegion);
 }
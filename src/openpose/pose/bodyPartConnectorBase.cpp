@@ -1,3 +1,5 @@
+#include <openpose/net/resizeAndMergeBase.hpp>
+#include <openpose/thread/threadPool.hpp>
 #include <openpose/utilities/check.hpp>
 #include <openpose/utilities/fastMath.hpp>
 #include <openpose/pose/poseParameters.hpp>
@@ -5,346 +7,444 @@
 
 namespace op
 {
+    struct BodyPartConnectorArena
+    {
+        std::vector<int> subsetParts;
+        std::vector<double> subsetScores;
+        std::vector<std::vector<int>> peakSubsets;
+        std::vector<int> subsetIndexes;
+        std::vector<std::vector<std::tuple<double, int, int>>> pairConnections;
+        std::vector<std::tuple<int, int, double>> connectionK;
+        std::vector<int> occurA;
+        std::vector<int> occurB;
+        std::vector<int> validSubsetIndexes;
+    };
+
     template <typename T>
-    void connectBodyPartsCpu(Array<T>& poseKeypoints, Array<T>& poseScores, const T* const heatMapPtr,
-                             const T* const peaksPtr, const PoseModel poseModel, const Point<int>& heatMapSize,
-                             const int maxPeaks, const T interMinAboveThreshold, const T interThreshold,
-                             const int minSubsetCnt, const T minSubsetScore, const T scaleFactor)
+    void scoreBodyPartPairCpu(std::vector<std::tuple<double, int, int>>& pairConnections, const T* const mapX,
+                              const T* const mapY, const T* const candidateAPtr, const T* const candidateBPtr,
+                              const Point<int>& heatMapSize, const Point<int>& upsampledHeatMapSize,
+                              const T interMinAboveThreshold, const T interThreshold)
     {
-        try
+        pairConnections.clear();
+        const auto numberA = intRound(candidateAPtr[0]);
+        const auto numberB = intRound(candidateBPtr[0]);
+        if (numberA == 0 || numberB == 0)
+            return;
+        // Coordinates of the peaks (upsampled ones if the heat maps were not upsampled)
+        const auto upsampleOnTheFly = (upsampledHeatMapSize.x > 0 && upsampledHeatMapSize.y > 0);
+        const auto peaksMapSize = (upsampleOnTheFly ? upsampledHeatMapSize : heatMapSize);
+        // Sampled points are between both peaks -> it is enough to check the peaks (not each point)
+        for (auto i = 1; i <= numberA; i++)
         {
-            // Parts Connection
-            const auto& bodyPartPairs = getPosePartPairs(poseModel);
-            const auto& mapIdx = getPoseMapIndex(poseModel);
-            const auto numberBodyParts = getPoseNumberBodyParts(poseModel);
-            const auto numberBodyPartPairs = bodyPartPairs.size() / 2;
-
-            // Vector<int> = Each body part + body parts counter; double = subsetScore
-            std::vector<std::pair<std::vector<int>, double>> subset;
-            const auto subsetCounterIndex = numberBodyParts;
-            const auto subsetSize = numberBodyParts+1;
-
-            const auto peaksOffset = 3*(maxPeaks+1);
-            const auto heatMapOffset = heatMapSize.area();
-
-            for (auto pairIndex = 0u; pairIndex < numberBodyPartPairs; pairIndex++)
+            checkGE(intRound(candidateAPtr[i*3]), 0, "", __LINE__, __FUNCTION__, __FILE__);
+            checkGE(intRound(candidateAPtr[i*3+1]), 0, "", __LINE__, __FUNCTION__, __FILE__);
+        }
+        for (auto j = 1; j <= numberB; j++)
+        {
+            checkGE(intRound(candidateBPtr[j*3]), 0, "", __LINE__, __FUNCTION__, __FILE__);
+            checkGE(intRound(candidateBPtr[j*3+1]), 0, "", __LINE__, __FUNCTION__, __FILE__);
+        }
+        // PAF values of the sampled points of each connection (padded to a multiple of numberLanes)
+        const auto maxPointsInLine = 25;
+        const auto numberLanes = 8;
+        const auto maxPointsInLinePadded = (maxPointsInLine + numberLanes - 1) / numberLanes * numberLanes;
+        std::array<T, maxPointsInLinePadded> valuesX{};
+        std::array<T, maxPointsInLinePadded> valuesY{};
+        for (auto i = 1; i <= numberA; i++)
+        {
+            for (auto j = 1; j <= numberB; j++)
             {
-                const auto bodyPartA = bodyPartPairs[2*pairIndex];
-                const auto bodyPartB = bodyPartPairs[2*pairIndex+1];
-                const auto* candidateAPtr = peaksPtr + bodyPartA*peaksOffset;
-                const auto* candidateBPtr = peaksPtr + bodyPartB*peaksOffset;
-                const auto numberA = intRound(candidateAPtr[0]);
-                const auto numberB = intRound(candidateBPtr[0]);
-
-                // Add parts into the subset in special case
-                if (numberA == 0 || numberB == 0)
+                const auto vectorAToBX = candidateBPtr[j*3] - candidateAPtr[i*3];
+                const auto vectorAToBY = candidateBPtr[j*3+1] - candidateAPtr[i*3+1];
+                const auto vectorAToBMax = fastMax(std::abs(vectorAToBX), std::abs(vectorAToBY));
+                const auto numberPointsInLine = fastMax(
+                    5, fastMin(maxPointsInLine, intRound(std::sqrt(5*vectorAToBMax))));
+                const auto vectorNorm = T(std::sqrt( vectorAToBX*vectorAToBX + vectorAToBY*vectorAToBY ));
+                // If the peaksPtr are coincident. Don't connect them.
+                if (vectorNorm > 1e-6)
                 {
-                    // Change w.r.t. other
-                    if (numberA == 0) // numberB == 0 or not
+                    const auto sX = candidateAPtr[i*3];
+                    const auto sY = candidateAPtr[i*3+1];
+                    const auto vectorAToBNormX = vectorAToBX/vectorNorm;
+                    const auto vectorAToBNormY = vectorAToBY/vectorNorm;
+                    const auto vectorAToBXInLine = vectorAToBX/numberPointsInLine;
+                    const auto vectorAToBYInLine = vectorAToBY/numberPointsInLine;
+                    // Gather
+                    for (auto lm = 0; lm < numberPointsInLine; lm++)
                     {
-                        if (numberBodyParts != 15)
+                        const auto mX = fastMin(peaksMapSize.x-1, intRound(sX + lm*vectorAToBXInLine));
+                        const auto mY = fastMin(peaksMapSize.y-1, intRound(sY + lm*vectorAToBYInLine));
+                        if (upsampleOnTheFly)
                         {
-                            for (auto i = 1; i <= numberB; i++)
-                            {
-                                bool num = false;
-                                const auto indexB = bodyPartB;
-                                for (auto j = 0u; j < subset.size(); j++)
-                                {
-                                    const auto off = (int)bodyPartB*peaksOffset + i*3 + 2;
-                                    if (subset[j].first[indexB] == off)
-                                    {
-                                        num = true;
-                                        break;
-                                    }
-                                }
-                                if (!num)
-                                {
-                                    std::vector<int> rowVector(subsetSize, 0);
-                                    // Store the index
-                                    rowVector[ bodyPartB ] = bodyPartB*peaksOffset + i*3 + 2;
-                                    // Last number in each row is the parts number of that person
-                                    rowVector[subsetCounterIndex] = 1;
-                                    const auto subsetScore = candidateBPtr[i*3+2];
-                                    // Second last number in each row is the total score
-                                    subset.emplace_back(std::make_pair(rowVector, subsetScore));
-                                }
-                            }
+                            const Rectangle<int> pixel{mX, mY, 1, 1};
+                            resizeCubicRegionCpu(&valuesX[lm], mapX, heatMapSize, upsampledHeatMapSize, pixel);
+                            resizeCubicRegionCpu(&valuesY[lm], mapY, heatMapSize, upsampledHeatMapSize, pixel);
                         }
                         else
                         {
-                            for (auto i = 1; i <= numberB; i++)
-                            {
-                                std::vector<int> rowVector(subsetSize, 0);
-                                // Store the index
-                                rowVector[ bodyPartB ] = bodyPartB*peaksOffset + i*3 + 2;
-                                // Last number in each row is the parts number of that person
-                                rowVector[subsetCounterIndex] = 1;
-                                // Second last number in each row is the total score
-                                const auto subsetScore = candidateBPtr[i*3+2];
-                                subset.emplace_back(std::make_pair(rowVector, subsetScore));
-                            }
+                            const auto idx = mY * heatMapSize.x + mX;
+                            valuesX[lm] = mapX[idx];
+                            valuesY[lm] = mapY[idx];
                         }
                     }
-                    else // if (numberA != 0 && numberB == 0)
+                    // Line integral: branchless, with independent partial sums per lane (so the compiler can
+                    // vectorize it without re-associating a single sum), padding points masked out
+                    std::array<T, numberLanes> sums{};
+                    std::array<int, numberLanes> counts{};
+                    const auto numberPointsInLinePadded = (numberPointsInLine + numberLanes - 1)
+                                                        / numberLanes * numberLanes;
+                    for (auto lm = 0; lm < numberPointsInLinePadded; lm += numberLanes)
                     {
-                        if (numberBodyParts != 15)
-                        {
-                            for (auto i = 1; i <= numberA; i++)
-                            {
-                                bool num = false;
-                                const auto indexA = bodyPartA;
-                                for (auto j = 0u; j < subset.size(); j++)
-                                {
-                                    const auto off = (int)bodyPartA*peaksOffset + i*3 + 2;
-                                    if (subset[j].first[indexA] == off)
-                                    {
-                                        num = true;
-                                        break;
-                                    }
-                                }
-                                if (!num)
-                                {
-                                    std::vector<int> rowVector(subsetSize, 0);
-                                    // Store the index
-                                    rowVector[ bodyPartA ] = bodyPartA*peaksOffset + i*3 + 2;
-                                    // Last number in each row is the parts number of that person
-                                    rowVector[subsetCounterIndex] = 1;
-                                    // Second last number in each row is the total score
-                                    const auto subsetScore = candidateAPtr[i*3+2];
-                                    subset.emplace_back(std::make_pair(rowVector, subsetScore));
-                                }
-                            }
-                        }
-                        else
+                        for (auto lane = 0; lane < numberLanes; lane++)
                         {
-                            for (auto i = 1; i <= numberA; i++)
-                            {
-                                std::vector<int> rowVector(subsetSize, 0);
-                                // Store the index
-                                rowVector[ bodyPartA ] = bodyPartA*peaksOffset + i*3 + 2;
-                                // Last number in each row is the parts number of that person
-                                rowVector[subsetCounterIndex] = 1;
-                                // Second last number in each row is the total score
-                                const auto subsetScore = candidateAPtr[i*3+2];
-                                subset.emplace_back(std::make_pair(rowVector, subsetScore));
-                            }
+                            const auto score = (vectorAToBNormX*valuesX[lm+lane] + vectorAToBNormY*valuesY[lm+lane]);
+                            const auto aboveThreshold = (score > interThreshold && lm + lane < numberPointsInLine);
+                            sums[lane] += (aboveThreshold ? score : T(0));
+                            counts[lane] += aboveThreshold;
                         }
                     }
-                }
-                else // if (numberA != 0 && numberB != 0)
-                {
-                    std::vector<std::tuple<double, int, int>> temp;
-                    const auto* mapX = heatMapPtr + mapIdx[2*pairIndex] * heatMapOffset;
-                    const auto* mapY = heatMapPtr + mapIdx[2*pairIndex+1] * heatMapOffset;
-                    for (auto i = 1; i <= numberA; i++)
+                    auto sum = 0.;
+                    auto count = 0;
+                    for (auto lane = 0; lane < numberLanes; lane++)
                     {
-                        for (auto j = 1; j <= numberB; j++)
-                        {
-                            const auto vectorAToBX = candidateBPtr[j*3] - candidateAPtr[i*3];
-                            const auto vectorAToBY = candidateBPtr[j*3+1] - candidateAPtr[i*3+1];
-                            const auto vectorAToBMax = fastMax(std::abs(vectorAToBX), std::abs(vectorAToBY));
-                            const auto numberPointsInLine = fastMax(5, fastMin(25, intRound(std::sqrt(5*vectorAToBMax))));
-                            const auto vectorNorm = T(std::sqrt( vectorAToBX*vectorAToBX + vectorAToBY*vectorAToBY ));
-                            // If the peaksPtr are coincident. Don't connect them.
-                            if (vectorNorm > 1e-6)
-                            {
-                                const auto sX = candidateAPtr[i*3];
-                                const auto sY = candidateAPtr[i*3+1];
-                                const auto vectorAToBNormX = vectorAToBX/vectorNorm;
-                                const auto vectorAToBNormY = vectorAToBY/vectorNorm;
+                        sum += sums[lane];
+                        count += counts[lane];
+                    }
 
-                                auto sum = 0.;
-                                auto count = 0;
-                                const auto vectorAToBXInLine = vectorAToBX/numberPointsInLine;
-                                const auto vectorAToBYInLine = vectorAToBY/numberPointsInLine;
-                                for (auto lm = 0; lm < numberPointsInLine; lm++)
-                                {
-                                    const auto mX = fastMin(heatMapSize.x-1, intRound(sX + lm*vectorAToBXInLine));
-                                    const auto mY = fastMin(heatMapSize.y-1, intRound(sY + lm*vectorAToBYInLine));
-                                    checkGE(mX, 0, "", __LINE__, __FUNCTION__, __FILE__);
-                                    checkGE(mY, 0, "", __LINE__, __FUNCTION__, __FILE__);
-                                    const auto idx = mY * heatMapSize.x + mX;
-                                    const auto score = (vectorAToBNormX*mapX[idx] + vectorAToBNormY*mapY[idx]);
-                                    if (score > interThreshold)
-                                    {
-                                        sum += score;
-                                        count++;
-                                    }
-                                }
+                    // parts score + connection score
+                    if (count/(float)numberPointsInLine > interMinAboveThreshold)
+                        pairConnections.emplace_back(std::make_tuple(sum/count, i, j));
+                }
+            }
+        }
+        // select the top minAB connection, assuming that each part occur only once
+        // sort rows in descending order based on parts + connection score
+        if (!pairConnections.empty())
+            std::sort(pairConnections.begin(), pairConnections.end(), std::greater<std::tuple<T, int, int>>());
+    }
 
-                                // parts score + connection score
-                                if (count/(float)numberPointsInLine > interMinAboveThreshold)
-                                    temp.emplace_back(std::make_tuple(sum/count, i, j));
-                            }
-                        }
+    // Topology of the models without compile-time one (see PoseTopologyCoco)
+    class PoseTopologyRuntime
+    {
+    public:
+        explicit PoseTopologyRuntime(const PoseModel poseModel) :
+            mPoseModel{poseModel},
+            mNumberBodyParts{getPoseNumberBodyParts(poseModel)},
+            mNumberBodyPartPairs{(unsigned int)getPosePartPairs(poseModel).size() / 2},
+            pBodyPartPairs{getPosePartPairs(poseModel).data()},
+            pMapIndex{getPoseMapIndex(poseModel).data()}
+        {
+        }
+
+        unsigned int numberBodyParts() const { return mNumberBodyParts; }
+        unsigned int numberBodyPartPairs() const { return mNumberBodyPartPairs; }
+        const unsigned int* bodyPartPairs() const { return pBodyPartPairs; }
+        const unsigned int* mapIndex() const { return pMapIndex; }
+
+        // Ears connections (in case person is looking to opposite direction to camera)
+        bool isEarPair(const unsigned int pairIndex) const
+        {
+            return (mNumberBodyParts == 18 && (pairIndex==17 || pairIndex==18))
+                || ((mNumberBodyParts == 19 || mNumberBodyParts == 59) && (pairIndex==18 || pairIndex==19))
+                || (mNumberBodyParts == 23 && (pairIndex==22 || pairIndex==23))
+                || (mPoseModel == PoseModel::BODY_19b
+                    && (pairIndex == mNumberBodyPartPairs-1 || pairIndex == mNumberBodyPartPairs-2));
+        }
+
+    private:
+        const PoseModel mPoseModel;
+        const unsigned int mNumberBodyParts;
+        const unsigned int mNumberBodyPartPairs;
+        const unsigned int* const pBodyPartPairs;
+        const unsigned int* const pMapIndex;
+    };
+
+    template <typename T, typename TPoseTopology>
+    void connectBodyPartsTopologyCpu(Array<T>& poseKeypoints, Array<T>& poseScores, const T* const heatMapPtr,
+                                     const T* const peaksPtr, const TPoseTopology& poseTopology,
+                                     const Point<int>& heatMapSize, const int maxPeaks,
+                                     const T interMinAboveThreshold, const T interThreshold, const int minSubsetCnt,
+                                     const T minSubsetScore, const T scaleFactor,
+                                     const Point<int>& upsampledHeatMapSize)
+    {
+        // Parts Connection (compile-time constants for PoseTopologyCoco and PoseTopologyMpi)
+        const auto* const bodyPartPairs = poseTopology.bodyPartPairs();
+        const auto* const mapIdx = poseTopology.mapIndex();
+        const auto numberBodyParts = poseTopology.numberBodyParts();
+        const auto numberBodyPartPairs = poseTopology.numberBodyPartPairs();
+
+        // Reusable per-thread memory (no allocations once it reaches the size of the most crowded frame)
+        thread_local BodyPartConnectorArena arena;
+        // Subsets (i.e., people), flat row-major matrix: each body part peak index + body parts counter
+        auto& subsetParts = arena.subsetParts;
+        auto& subsetScores = arena.subsetScores;
+        subsetParts.clear();
+        subsetScores.clear();
+        const auto subsetCounterIndex = numberBodyParts;
+        const auto subsetSize = numberBodyParts+1;
+
+        const auto peaksOffset = 3*(maxPeaks+1);
+        const auto heatMapOffset = heatMapSize.area();
+
+        // Reverse lookup: body part peak -> subsets containing it (peak index = bodyPart*peaksOffset + i*3 + 2)
+        auto& peakSubsets = arena.peakSubsets;
+        if (peakSubsets.size() < numberBodyParts*(maxPeaks+1))
+            peakSubsets.resize(numberBodyParts*(maxPeaks+1));
+        for (auto& peakSubsetsI : peakSubsets)
+            peakSubsetsI.clear();
+        const auto getPeakSubsets = [&](const int peakIndex) -> std::vector<int>&
+        {
+            return peakSubsets[(peakIndex-2)/3];
+        };
+        const auto setSubsetPart = [&](const int subsetIndex, const unsigned int bodyPart, const int peakIndex)
+        {
+            auto& subsetPart = subsetParts[subsetIndex*subsetSize + bodyPart];
+            if (subsetPart > 0)
+            {
+                auto& oldPeakSubsets = getPeakSubsets(subsetPart);
+                oldPeakSubsets.erase(std::find(oldPeakSubsets.begin(), oldPeakSubsets.end(), subsetIndex));
+            }
+            subsetPart = peakIndex;
+            getPeakSubsets(peakIndex).emplace_back(subsetIndex);
+        };
+        const auto addSubset = [&](const int subsetCounter, const double subsetScore)
+        {
+            const auto subsetIndex = (int)subsetScores.size();
+            subsetParts.resize(subsetParts.size() + subsetSize, 0);
+            subsetParts[subsetIndex*subsetSize + subsetCounterIndex] = subsetCounter;
+            subsetScores.emplace_back(subsetScore);
+            return subsetIndex;
+        };
+
+        // PAF scoring of all the candidate connections of each pair of body parts (independent pairs -> split
+        // among the ThreadPool threads, if enabled)
+        auto& pairConnections = arena.pairConnections;
+        if (pairConnections.size() < numberBodyPartPairs)
+            pairConnections.resize(numberBodyPartPairs);
+        parallelFor((int)numberBodyPartPairs, [&](const int startPair, const int endPair)
+        {
+            for (auto pairIndex = startPair ; pairIndex < endPair ; pairIndex++)
+            {
+                const auto* const candidateAPtr = peaksPtr + bodyPartPairs[2*pairIndex]*peaksOffset;
+                const auto* const candidateBPtr = peaksPtr + bodyPartPairs[2*pairIndex+1]*peaksOffset;
+                scoreBodyPartPairCpu(
+                    pairConnections[pairIndex], heatMapPtr + mapIdx[2*pairIndex] * heatMapOffset,
+                    heatMapPtr + mapIdx[2*pairIndex+1] * heatMapOffset, candidateAPtr, candidateBPtr,
+                    heatMapSize, upsampledHeatMapSize, interMinAboveThreshold, interThreshold);
+            }
+        });
+
+        // Sequential merge of the pairs into people
+        for (auto pairIndex = 0u; pairIndex < numberBodyPartPairs; pairIndex++)
+        {
+            const auto bodyPartA = bodyPartPairs[2*pairIndex];
+            const auto bodyPartB = bodyPartPairs[2*pairIndex+1];
+            const auto* candidateAPtr = peaksPtr + bodyPartA*peaksOffset;
+            const auto* candidateBPtr = peaksPtr + bodyPartB*peaksOffset;
+            const auto numberA = intRound(candidateAPtr[0]);
+            const auto numberB = intRound(candidateBPtr[0]);
+
+            // Add parts into the subset in special case
+            if (numberA == 0 || numberB == 0)
+            {
+                // Change w.r.t. other: new subset for each peak of the non-empty body part (if not already in
+                // a subset, except for 15-part models)
+                const auto bodyPartNonEmpty = (numberA == 0 ? bodyPartB : bodyPartA);
+                const auto* const candidateNonEmptyPtr = (numberA == 0 ? candidateBPtr : candidateAPtr);
+                const auto numberNonEmpty = (numberA == 0 ? numberB : numberA);
+                for (auto i = 1; i <= numberNonEmpty; i++)
+                {
+                    const auto peakIndex = (int)bodyPartNonEmpty*peaksOffset + i*3 + 2;
+                    if (numberBodyParts == 15 || getPeakSubsets(peakIndex).empty())
+                    {
+                        // Last number in each row is the parts number of that person, score = part score
+                        const auto subsetIndex = addSubset(1, candidateNonEmptyPtr[i*3+2]);
+                        setSubsetPart(subsetIndex, bodyPartNonEmpty, peakIndex);
                     }
+                }
+            }
+            else // if (numberA != 0 && numberB != 0)
+            {
+                // Scored connections, sorted in descending order based on parts + connection score
+                const auto& temp = arena.pairConnections[pairIndex];
 
-                    // select the top minAB connection, assuming that each part occur only once
-                    // sort rows in descending order based on parts + connection score
-                    if (!temp.empty())
-                        std::sort(temp.begin(), temp.end(), std::greater<std::tuple<T, int, int>>());
+                auto& connectionK = arena.connectionK;
+                connectionK.clear();
+                const auto minAB = fastMin(numberA, numberB);
+                auto& occurA = arena.occurA;
+                auto& occurB = arena.occurB;
+                occurA.assign(numberA, 0);
+                occurB.assign(numberB, 0);
+                auto counter = 0;
+                for (auto row = 0u; row < temp.size(); row++)
+                {
+                    const auto score = std::get<0>(temp[row]);
+                    const auto x = std::get<1>(temp[row]);
+                    const auto y = std::get<2>(temp[row]);
+                    if (!occurA[x-1] && !occurB[y-1])
+                    {
+                        connectionK.emplace_back(std::make_tuple(bodyPartA*peaksOffset + x*3 + 2,
+                                                                 bodyPartB*peaksOffset + y*3 + 2,
+                                                                 score));
+                        counter++;
+                        if (counter==minAB)
+                            break;
+                        occurA[x-1] = 1;
+                        occurB[y-1] = 1;
+                    }
+                }
 
-                    std::vector<std::tuple<int, int, double>> connectionK;
-                    const auto minAB = fastMin(numberA, numberB);
-                    std::vector<int> occurA(numberA, 0);
-                    std::vector<int> occurB(numberB, 0);
-                    auto counter = 0;
-                    for (auto row = 0u; row < temp.size(); row++)
+                // Cluster all the body part candidates into subset based on the part connection
+                if (!connectionK.empty())
+                {
+                    // initialize first body part connection 15&16
+                    if (pairIndex==0)
                     {
-                        const auto score = std::get<0>(temp[row]);
-                        const auto x = std::get<1>(temp[row]);
-                        const auto y = std::get<2>(temp[row]);
-                        if (!occurA[x-1] && !occurB[y-1])
+                        for (const auto& connectionKI : connectionK)
                         {
-                            connectionK.emplace_back(std::make_tuple(bodyPartA*peaksOffset + x*3 + 2,
-                                                                     bodyPartB*peaksOffset + y*3 + 2,
-                                                                     score));
-                            counter++;
-                            if (counter==minAB)
-                                break;
-                            occurA[x-1] = 1;
-                            occurB[y-1] = 1;
+                            const auto indexA = std::get<0>(connectionKI);
+                            const auto indexB = std::get<1>(connectionKI);
+                            const auto score = std::get<2>(connectionKI);
+                            // add the score of parts and the connection
+                            const auto subsetIndex = addSubset(2, peaksPtr[indexA] + peaksPtr[indexB] + score);
+                            setSubsetPart(subsetIndex, bodyPartPairs[0], indexA);
+                            setSubsetPart(subsetIndex, bodyPartPairs[1], indexB);
                         }
                     }
-
-                    // Cluster all the body part candidates into subset based on the part connection
-                    if (!connectionK.empty())
+                    // Add ears connections (in case person is looking to opposite direction to camera)
+                    else if (poseTopology.isEarPair(pairIndex))
                     {
-                        // initialize first body part connection 15&16
-                        if (pairIndex==0)
+                        auto& subsetIndexes = arena.subsetIndexes;
+                        for (const auto& connectionKI : connectionK)
                         {
-                            for (const auto connectionKI : connectionK)
-                            {
-                                std::vector<int> rowVector(numberBodyParts+3, 0);
-                                const auto indexA = std::get<0>(connectionKI);
-                                const auto indexB = std::get<1>(connectionKI);
-                                const auto score = std::get<2>(connectionKI);
-                                rowVector[bodyPartPairs[0]] = indexA;
-                                rowVector[bodyPartPairs[1]] = indexB;
-                                rowVector[subsetCounterIndex] = 2;
-                                // add the score of parts and the connection
-                                const auto subsetScore = peaksPtr[indexA] + peaksPtr[indexB] + score;
-                                subset.emplace_back(std::make_pair(rowVector, subsetScore));
-                            }
+                            const auto indexA = std::get<0>(connectionKI);
+                            const auto indexB = std::get<1>(connectionKI);
+                            // Subsets with A but no B (copied, setSubsetPart modifies the lookup)
+                            subsetIndexes = getPeakSubsets(indexA);
+                            for (const auto subsetIndex : subsetIndexes)
+                                if (subsetParts[subsetIndex*subsetSize + bodyPartB] == 0)
+                                    setSubsetPart(subsetIndex, bodyPartB, indexB);
+                            // Subsets with B but no A
+                            subsetIndexes = getPeakSubsets(indexB);
+                            for (const auto subsetIndex : subsetIndexes)
+                                if (subsetParts[subsetIndex*subsetSize + bodyPartA] == 0)
+                                    setSubsetPart(subsetIndex, bodyPartA, indexA);
                         }
-                        // Add ears connections (in case person is looking to opposite direction to camera)
-                        else if (
-                            (numberBodyParts == 18 && (pairIndex==17 || pairIndex==18))
-                            || ((numberBodyParts == 19 || numberBodyParts == 59)
-                                && (pairIndex==18 || pairIndex==19))
-                            || (numberBodyParts == 23 && (pairIndex==22 || pairIndex==23))
-                            || (poseModel == PoseModel::BODY_19b
-                                && (pairIndex == numberBodyPartPairs-1 || pairIndex == numberBodyPartPairs-2))
-                            )
+                    }
+                    else
+                    {
+                        // A is already in the subset, find its connection B
+                        auto& subsetIndexes = arena.subsetIndexes;
+                        for (const auto& connectionKI : connectionK)
                         {
-                            for (const auto& connectionKI : connectionK)
+                            const auto indexA = std::get<0>(connectionKI);
+                            const auto indexB = std::get<1>(connectionKI);
+                            const auto score = std::get<2>(connectionKI);
+                            subsetIndexes = getPeakSubsets(indexA);
+                            for (const auto subsetIndex : subsetIndexes)
                             {
-                                const auto indexA = std::get<0>(connectionKI);
-                                const auto indexB = std::get<1>(connectionKI);
-                                for (auto& subsetJ : subset)
-                                {
-                                    auto& subsetJFirst = subsetJ.first[bodyPartA];
-                                    auto& subsetJFirstPlus1 = subsetJ.first[bodyPartB];
-                                    if (subsetJFirst == indexA && subsetJFirstPlus1 == 0)
-                                        subsetJFirstPlus1 = indexB;
-                                    else if (subsetJFirstPlus1 == indexB && subsetJFirst == 0)
-                                        subsetJFirst = indexA;
-                                }
+                                setSubsetPart(subsetIndex, bodyPartB, indexB);
+                                subsetParts[subsetIndex*subsetSize + subsetCounterIndex]++;
+                                subsetScores[subsetIndex] += peaksPtr[indexB] + score;
                             }
-                        }
-                        else
-                        {
-                            // A is already in the subset, find its connection B
-                            for (const auto& connectionKI : connectionK)
+                            // if can not find partA in the subset, create a new subset
+                            if (subsetIndexes.empty())
                             {
-                                const auto indexA = std::get<0>(connectionKI);
-                                const auto indexB = std::get<1>(connectionKI);
-                                const auto score = std::get<2>(connectionKI);
-                                auto num = 0;
-                                for (auto& subsetJ : subset)
-                                {
-                                    if (subsetJ.first[bodyPartA] == indexA)
-                                    {
-                                        subsetJ.first[bodyPartB] = indexB;
-                                        num++;
-                                        subsetJ.first[subsetCounterIndex] = subsetJ.first[subsetCounterIndex] + 1;
-                                        subsetJ.second += peaksPtr[indexB] + score;
-                                    }
-                                }
-                                // if can not find partA in the subset, create a new subset
-                                if (num==0)
-                                {
-                                    std::vector<int> rowVector(subsetSize, 0);
-                                    rowVector[bodyPartA] = indexA;
-                                    rowVector[bodyPartB] = indexB;
-                                    rowVector[subsetCounterIndex] = 2;
-                                    const auto subsetScore = peaksPtr[indexA] + peaksPtr[indexB] + score;
-                                    subset.emplace_back(std::make_pair(rowVector, subsetScore));
-                                }
+                                const auto subsetIndex = addSubset(
+                                    2, peaksPtr[indexA] + peaksPtr[indexB] + score);
+                                setSubsetPart(subsetIndex, bodyPartA, indexA);
+                                setSubsetPart(subsetIndex, bodyPartB, indexB);
                             }
                         }
                     }
                 }
             }
+        }
 
-            // Delete people below the following thresholds:
-                // a) minSubsetCnt: removed if less than minSubsetCnt body parts
-                // b) minSubsetScore: removed if global score smaller than this
-                // c) POSE_MAX_PEOPLE: keep first POSE_MAX_PEOPLE people above thresholds
-            auto numberPeople = 0;
-            std::vector<int> validSubsetIndexes;
-            validSubsetIndexes.reserve(fastMin((size_t)POSE_MAX_PEOPLE, subset.size()));
-            for (auto index = 0u ; index < subset.size() ; index++)
+        // Delete people below the following thresholds:
+            // a) minSubsetCnt: removed if less than minSubsetCnt body parts
+            // b) minSubsetScore: removed if global score smaller than this
+            // c) POSE_MAX_PEOPLE: keep first POSE_MAX_PEOPLE people above thresholds
+        const auto numberSubsets = subsetScores.size();
+        auto numberPeople = 0;
+        auto& validSubsetIndexes = arena.validSubsetIndexes;
+        validSubsetIndexes.clear();
+        for (auto index = 0u ; index < numberSubsets ; index++)
+        {
+            const auto subsetCounter = subsetParts[index*subsetSize + subsetCounterIndex];
+            const auto subsetScore = subsetScores[index];
+            if (subsetCounter >= minSubsetCnt && (subsetScore/subsetCounter) >= minSubsetScore)
             {
-                const auto subsetCounter = subset[index].first[subsetCounterIndex];
-                const auto subsetScore = subset[index].second;
-                if (subsetCounter >= minSubsetCnt && (subsetScore/subsetCounter) >= minSubsetScore)
-                {
-                    numberPeople++;
-                    validSubsetIndexes.emplace_back(index);
-                    if (numberPeople == POSE_MAX_PEOPLE)
-                        break;
-                }
-                else if (subsetCounter < 1)
-                    error("Bad subsetCounter. Bug in this function if this happens.",
-                          __LINE__, __FUNCTION__, __FILE__);
+                numberPeople++;
+                validSubsetIndexes.emplace_back(index);
+                if (numberPeople == POSE_MAX_PEOPLE)
+                    break;
             }
+            else if (subsetCounter < 1)
+                error("Bad subsetCounter. Bug in this function if this happens.",
+                      __LINE__, __FUNCTION__, __FILE__);
+        }
 
-            // Fill and return poseKeypoints
-            if (numberPeople > 0)
-            {
-                poseKeypoints.reset({numberPeople, (int)numberBodyParts, 3});
-                poseScores.reset(numberPeople);
-            }
-            else
-            {
-                poseKeypoints.reset();
-                poseScores.reset();
-            }
-            const auto numberBodyPartsAndPAFs = numberBodyParts + numberBodyPartPairs;
-            for (auto person = 0u ; person < validSubsetIndexes.size() ; person++)
+        // Fill and return poseKeypoints
+        if (numberPeople > 0)
+        {
+            poseKeypoints.reset({numberPeople, (int)numberBodyParts, 3});
+            poseScores.reset(numberPeople);
+        }
+        else
+        {
+            poseKeypoints.reset();
+            poseScores.reset();
+        }
+        const auto numberBodyPartsAndPAFs = numberBodyParts + numberBodyPartPairs;
+        for (auto person = 0u ; person < validSubsetIndexes.size() ; person++)
+        {
+            const auto* const subsetI = &subsetParts[validSubsetIndexes[person]*subsetSize];
+            for (auto bodyPart = 0u; bodyPart < numberBodyParts; bodyPart++)
             {
-                const auto& subsetPair = subset[validSubsetIndexes[person]];
-                const auto& subsetI = subsetPair.first;
-                for (auto bodyPart = 0u; bodyPart < numberBodyParts; bodyPart++)
+                const auto baseOffset = (person*numberBodyParts + bodyPart) * 3;
+                const auto bodyPartIndex = subsetI[bodyPart];
+                if (bodyPartIndex > 0)
                 {
-                    const auto baseOffset = (person*numberBodyParts + bodyPart) * 3;
-                    const auto bodyPartIndex = subsetI[bodyPart];
-                    if (bodyPartIndex > 0)
-                    {
-                        poseKeypoints[baseOffset] = peaksPtr[bodyPartIndex-2] * scaleFactor;
-                        poseKeypoints[baseOffset + 1] = peaksPtr[bodyPartIndex-1] * scaleFactor;
-                        poseKeypoints[baseOffset + 2] = peaksPtr[bodyPartIndex];
-                    }
-                    else
-                    {
-                        poseKeypoints[baseOffset] = 0.f;
-                        poseKeypoints[baseOffset + 1] = 0.f;
-                        poseKeypoints[baseOffset + 2] = 0.f;
-                    }
+                    poseKeypoints[baseOffset] = peaksPtr[bodyPartIndex-2] * scaleFactor;
+                    poseKeypoints[baseOffset + 1] = peaksPtr[bodyPartIndex-1] * scaleFactor;
+                    poseKeypoints[baseOffset + 2] = peaksPtr[bodyPartIndex];
+                }
+                else
+                {
+                    poseKeypoints[baseOffset] = 0.f;
+                    poseKeypoints[baseOffset + 1] = 0.f;
+                    poseKeypoints[baseOffset + 2] = 0.f;
                 }
-                poseScores[person] = subsetPair.second / (float)(numberBodyPartsAndPAFs);
             }
+            poseScores[person] = subsetScores[validSubsetIndexes[person]] / (float)(numberBodyPartsAndPAFs);
+        }
+    }
+
+    template <typename T>
+    void connectBodyPartsCpu(Array<T>& poseKeypoints, Array<T>& poseScores, const T* const heatMapPtr,
+                             const T* const peaksPtr, const PoseModel poseModel, const Point<int>& heatMapSize,
+                             const int maxPeaks, const T interMinAboveThreshold, const T interThreshold,
+                             const int minSubsetCnt, const T minSubsetScore, const T scaleFactor,
+                             const Point<int>& upsampledHeatMapSize)
+    {
+        try
+        {
+            // Compile-time topology specializations of the main models
+            if (poseModel == PoseModel::COCO_18)
+                connectBodyPartsTopologyCpu(poseKeypoints, poseScores, heatMapPtr, peaksPtr, PoseTopologyCoco{},
+                                            heatMapSize, maxPeaks, interMinAboveThreshold, interThreshold,
+                                            minSubsetCnt, minSubsetScore, scaleFactor, upsampledHeatMapSize);
+            else if (poseModel == PoseModel::MPI_15 || poseModel == PoseModel::MPI_15_4)
+                connectBodyPartsTopologyCpu(poseKeypoints, poseScores, heatMapPtr, peaksPtr, PoseTopologyMpi{},
+                                            heatMapSize, maxPeaks, interMinAboveThreshold, interThreshold,
+                                            minSubsetCnt, minSubsetScore, scaleFactor, upsampledHeatMapSize);
+            else
+                connectBodyPartsTopologyCpu(poseKeypoints, poseScores, heatMapPtr, peaksPtr,
+                                            PoseTopologyRuntime{poseModel}, heatMapSize, maxPeaks,
+                                            interMinAboveThreshold, interThreshold, minSubsetCnt, minSubsetScore,
+                                            scaleFactor, upsampledHeatMapSize);
         }
         catch (const std::exception& e)
         {
@@ -357,11 +457,13 @@ namespace op
                                       const PoseModel poseModel, const Point<int>& heatMapSize,
                                       const int maxPeaks, const float interMinAboveThreshold,
                                       const float interThreshold, const int minSubsetCnt,
-                                      const float minSubsetScore, const float scaleFactor);
+                                      const float minSubsetScore, const float scaleFactor,
+                                      const Point<int>& upsampledHeatMapSize);
     template void connectBodyPartsCpu(Array<double>& poseKeypoints, Array<double>& poseScores,
                                       const double* const heatMapPtr, const double* const peaksPtr,
                                       const PoseModel poseModel, const Point<int>& heatMapSize,
                                       const int maxPeaks, const double interMinAboveThreshold,
                                       const double interThreshold, const int minSubsetCnt,
-                                      const double minSubsetScore, const double scaleFactor);
+                                      const double minSubsetScore, const double scaleFactor,
+                                      const Point<int>& upsampledHeatMapSize);
 }
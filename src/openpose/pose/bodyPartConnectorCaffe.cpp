@@ -7,7 +7,8 @@
 namespace op
 {
     template <typename T>
-    BodyPartConnectorCaffe<T>::BodyPartConnectorCaffe()
+    BodyPartConnectorCaffe<T>::BodyPartConnectorCaffe() :
+        mUpsampledHeatMapSize{0, 0}
     {
         try
         {
@@ -129,6 +130,19 @@ namespace op
         }
     }
 
+    template <typename T>
+    void BodyPartConnectorCaffe<T>::setUpsampledHeatMapSize(const Point<int>& upsampledHeatMapSize)
+    {
+        try
+        {
+            mUpsampledHeatMapSize = {upsampledHeatMapSize};
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
     template <typename T>
     void BodyPartConnectorCaffe<T>::Forward_cpu(const std::vector<caffe::Blob<T>*>& bottom, Array<T>& poseKeypoints,
                                                 Array<T>& poseScores)
@@ -143,7 +157,7 @@ namespace op
                 connectBodyPartsCpu(poseKeypoints, poseScores, heatMapsPtr, peaksPtr, mPoseModel,
                                     Point<int>{heatMapsBlob->shape(3), heatMapsBlob->shape(2)},
                                     maxPeaks, mInterMinAboveThreshold, mInterThreshold,
-                                    mMinSubsetCnt, mMinSubsetScore, mScaleNetToOutput);
+                                    mMinSubsetCnt, mMinSubsetScore, mScaleNetToOutput, mUpsampledHeatMapSize);
             #else
                 UNUSED(bottom);
                 UNUSED(poseKeypoints);
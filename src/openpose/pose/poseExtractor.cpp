@@ -9,14 +9,27 @@ namespace op
                                  const std::shared_ptr<KeepTopNPeople>& keepTopNPeople,
                                  const std::shared_ptr<PersonIdExtractor>& personIdExtractor,
                                  const std::shared_ptr<std::vector<std::shared_ptr<PersonTracker>>>& personTrackers,
-                                 const int numberPeopleMax, const int tracking) :
+                                 const int numberPeopleMax, const int tracking,
+                                 const std::shared_ptr<PoseNetScheduler>& poseNetScheduler) :
         mNumberPeopleMax{numberPeopleMax},
         mTracking{tracking},
         spPoseExtractorNet{poseExtractorNet},
         spKeepTopNPeople{keepTopNPeople},
         spPersonIdExtractor{personIdExtractor},
-        spPersonTrackers{personTrackers}
+        spPersonTrackers{personTrackers},
+        spPoseNetScheduler{poseNetScheduler}
     {
+        try
+        {
+            // Security checks
+            if (spPoseNetScheduler && (!spPersonTrackers || spPersonTrackers->empty()))
+                error("The adaptive net scheduler requires the person tracker (`--tracking` > 0).",
+                      __LINE__, __FUNCTION__, __FILE__);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
     }
 
     PoseExtractor::~PoseExtractor()
@@ -42,7 +55,7 @@ namespace op
     {
         try
         {
-            if (mTracking < 1 || frameId % (mTracking+1) == 0)
+            if (runNet(frameId))
                 spPoseExtractorNet->forwardPass(inputNetData, inputDataSize, scaleInputToNetInputs);
             else
                 spPoseExtractorNet->clear();
@@ -53,6 +66,59 @@ namespace op
         }
     }
 
+    void PoseExtractor::forwardPassBatch(const std::vector<std::vector<Array<float>>>& inputNetData,
+                                         const std::vector<Point<int>>& inputDataSizes,
+                                         const std::vector<std::vector<double>>& scaleInputToNetInputs,
+                                         const std::vector<long long>& frameIds)
+    {
+        try
+        {
+            // Security checks
+            if (inputNetData.size() != inputDataSizes.size() || inputNetData.size() != scaleInputToNetInputs.size()
+                || inputNetData.size() != frameIds.size())
+                error("All the input std::vectors must have the same size.", __LINE__, __FUNCTION__, __FILE__);
+            // Net batch with the frames on which the net is run
+            std::vector<std::vector<Array<float>>> netInputNetData;
+            std::vector<Point<int>> netInputDataSizes;
+            std::vector<std::vector<double>> netScaleInputToNetInputs;
+            mBatchNetFrameIndexes.resize(frameIds.size());
+            for (auto frame = 0u ; frame < frameIds.size() ; frame++)
+            {
+                if (runNet(frameIds[frame]))
+                {
+                    mBatchNetFrameIndexes[frame] = (int)netInputNetData.size();
+                    netInputNetData.emplace_back(inputNetData[frame]);
+                    netInputDataSizes.emplace_back(inputDataSizes[frame]);
+                    netScaleInputToNetInputs.emplace_back(scaleInputToNetInputs[frame]);
+                }
+                else
+                    mBatchNetFrameIndexes[frame] = -1;
+            }
+            if (!netInputNetData.empty())
+                spPoseExtractorNet->forwardPassBatch(netInputNetData, netInputDataSizes, netScaleInputToNetInputs);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    void PoseExtractor::postProcessBatchFrame(const int frameIndex)
+    {
+        try
+        {
+            const auto netFrameIndex = mBatchNetFrameIndexes.at(frameIndex);
+            if (netFrameIndex >= 0)
+                spPoseExtractorNet->postProcessBatchFrame(netFrameIndex);
+            else
+                spPoseExtractorNet->clear();
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
     Array<float> PoseExtractor::getHeatMapsCopy() const
     {
         try
@@ -228,4 +294,33 @@ namespace op
             error(e.what(), __LINE__, __FUNCTION__, __FILE__);
         }
     }
+
+    void PoseExtractor::updateNetScheduler(const Array<float>& poseKeypoints, const Array<long long>& poseIds,
+                                           const long long frameId)
+    {
+        try
+        {
+            if (spPoseNetScheduler)
+                spPoseNetScheduler->update(poseKeypoints, poseIds, frameId);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    bool PoseExtractor::runNet(const long long frameId) const
+    {
+        try
+        {
+            // Adaptive (if enabled) or fixed tracking interval
+            return (spPoseNetScheduler
+                ? spPoseNetScheduler->runNet(frameId) : (mTracking < 1 || frameId % (mTracking+1) == 0));
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return false;
+        }
+    }
 }
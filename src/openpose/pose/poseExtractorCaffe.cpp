@@ -1,8 +1,12 @@
 #ifdef USE_CAFFE
     #include <caffe/blob.hpp>
 #endif
+#ifdef USE_CUDA
+    #include <cuda_runtime_api.h>
+#endif
 #include <openpose/gpu/cuda.hpp>
 #include <openpose/net/netCaffe.hpp>
+#include <openpose/net/nmsBase.hpp>
 #include <openpose/net/nmsCaffe.hpp>
 #include <openpose/net/resizeAndMergeCaffe.hpp>
 #include <openpose/pose/bodyPartConnectorCaffe.hpp>
@@ -11,10 +15,18 @@
 #include <openpose/utilities/fastMath.hpp>
 #include <openpose/utilities/openCv.hpp>
 #include <openpose/utilities/standard.hpp>
+#include <openpose/utilities/tracer.hpp>
 #include <openpose/pose/poseExtractorCaffe.hpp>
 
 namespace op
 {
+    // Coarse-to-fine NMS only implemented for the CPU version
+    #if defined USE_CUDA || defined USE_OPENCL
+        const bool NMS_COARSE_TO_FINE_AVAILABLE = false;
+    #else
+        const bool NMS_COARSE_TO_FINE_AVAILABLE = true;
+    #endif
+
     struct PoseExtractorCaffe::ImplPoseExtractorCaffe
     {
         #ifdef USE_CAFFE
@@ -23,6 +35,10 @@ namespace op
             const int mGpuId;
             const std::string mModelFolder;
             const bool mEnableGoogleLogging;
+            const bool mNmsCoarseToFine;
+            const int mNetCacheSize;
+            const std::vector<Point<int>> mPrewarmNetInputSizes;
+            const int mPrewarmBatchSize;
             // General parameters
             std::vector<std::shared_ptr<NetCaffe>> spCaffeNets;
             std::shared_ptr<ResizeAndMergeCaffe<float>> spResizeAndMergeCaffe;
@@ -30,17 +46,27 @@ namespace op
             std::shared_ptr<BodyPartConnectorCaffe<float>> spBodyPartConnectorCaffe;
             std::vector<std::vector<int>> mNetInput4DSizes;
             std::vector<double> mScaleInputToNetInputs;
+            // Batch mode: frames concatenated for each scale
+            std::vector<Array<float>> mBatchNetInputs;
             // Init with thread
             std::vector<boost::shared_ptr<caffe::Blob<float>>> spCaffeNetOutputBlobs;
+            // Batch mode: net output of the frame being post-processed
+            std::vector<boost::shared_ptr<caffe::Blob<float>>> spBatchFrameOutputBlobs;
             std::shared_ptr<caffe::Blob<float>> spHeatMapsBlob;
             std::shared_ptr<caffe::Blob<float>> spPeaksBlob;
 
             ImplPoseExtractorCaffe(const PoseModel poseModel, const int gpuId,
-                                   const std::string& modelFolder, const bool enableGoogleLogging) :
+                                   const std::string& modelFolder, const bool enableGoogleLogging,
+                                   const bool nmsCoarseToFine, const int netCacheSize,
+                                   const std::vector<Point<int>>& prewarmNetInputSizes, const int prewarmBatchSize) :
                 mPoseModel{poseModel},
                 mGpuId{gpuId},
                 mModelFolder{modelFolder},
                 mEnableGoogleLogging{enableGoogleLogging},
+                mNmsCoarseToFine{nmsCoarseToFine},
+                mNetCacheSize{netCacheSize},
+                mPrewarmNetInputSizes{prewarmNetInputSizes},
+                mPrewarmBatchSize{fastMax(1, prewarmBatchSize)},
                 spResizeAndMergeCaffe{std::make_shared<ResizeAndMergeCaffe<float>>()},
                 spNmsCaffe{std::make_shared<NmsCaffe<float>>()},
                 spBodyPartConnectorCaffe{std::make_shared<BodyPartConnectorCaffe<float>>()}
@@ -105,7 +131,8 @@ namespace op
         void addCaffeNetOnThread(std::vector<std::shared_ptr<NetCaffe>>& netCaffe,
                                  std::vector<boost::shared_ptr<caffe::Blob<float>>>& caffeNetOutputBlob,
                                  const PoseModel poseModel, const int gpuId,
-                                 const std::string& modelFolder, const bool enableGoogleLogging)
+                                 const std::string& modelFolder, const bool enableGoogleLogging,
+                                 const int netCacheSize)
         {
             try
             {
@@ -113,7 +140,7 @@ namespace op
                 netCaffe.emplace_back(
                     std::make_shared<NetCaffe>(modelFolder + getPoseProtoTxt(poseModel),
                                                modelFolder + getPoseTrainedModel(poseModel),
-                                               gpuId, enableGoogleLogging)
+                                               gpuId, enableGoogleLogging, "net_output", netCacheSize)
                 );
                 // Initializing them on the thread
                 netCaffe.back()->initializationOnThread();
@@ -136,10 +163,15 @@ namespace op
     PoseExtractorCaffe::PoseExtractorCaffe(const PoseModel poseModel, const std::string& modelFolder,
                                            const int gpuId, const std::vector<HeatMapType>& heatMapTypes,
                                            const ScaleMode heatMapScale, const bool addPartCandidates,
-                                           const bool enableGoogleLogging) :
+                                           const bool enableGoogleLogging, const bool nmsCoarseToFine,
+                                           const int netCacheSize,
+                                           const std::vector<Point<int>>& prewarmNetInputSizes,
+                                           const int prewarmBatchSize) :
         PoseExtractorNet{poseModel, heatMapTypes, heatMapScale, addPartCandidates}
         #ifdef USE_CAFFE
-        , upImpl{new ImplPoseExtractorCaffe{poseModel, gpuId, modelFolder, enableGoogleLogging}}
+        , upImpl{new ImplPoseExtractorCaffe{poseModel, gpuId, modelFolder, enableGoogleLogging,
+                                            nmsCoarseToFine && NMS_COARSE_TO_FINE_AVAILABLE && heatMapTypes.empty(),
+                                            netCacheSize, prewarmNetInputSizes, prewarmBatchSize}}
         #endif
     {
         try
@@ -147,6 +179,20 @@ namespace op
             #ifdef USE_CAFFE
                 // Layers parameters
                 upImpl->spBodyPartConnectorCaffe->setPoseModel(upImpl->mPoseModel);
+                // Coarse-to-fine NMS
+                if (nmsCoarseToFine && !upImpl->mNmsCoarseToFine)
+                    log("Coarse-to-fine NMS disabled: it is only implemented for the CPU version of OpenPose and"
+                        " it is not compatible with the heat maps output.", Priority::High);
+                // Net cache pre-warm sizes (exact net input sizes, so no `-1` as in netInputSize)
+                for (const auto& netInputSize : prewarmNetInputSizes)
+                    if (netInputSize.x <= 0 || netInputSize.y <= 0
+                        || netInputSize.x % 16 != 0 || netInputSize.y % 16 != 0)
+                        error("Net input sizes to pre-warm must be positive multiples of 16 (e.g., 656x368), but `"
+                              + netInputSize.toString() + "` was given.", __LINE__, __FUNCTION__, __FILE__);
+                if ((int)prewarmNetInputSizes.size() > fastMax(1, netCacheSize))
+                    log("More net input sizes to pre-warm (" + std::to_string(prewarmNetInputSizes.size())
+                        + ") than the net cache size (" + std::to_string(fastMax(1, netCacheSize)) + "), so only"
+                        " the last " + std::to_string(fastMax(1, netCacheSize)) + " will be kept.", Priority::High);
             #else
                 UNUSED(poseModel);
                 UNUSED(modelFolder);
@@ -154,6 +200,11 @@ namespace op
                 UNUSED(heatMapTypes);
                 UNUSED(heatMapScale);
                 UNUSED(addPartCandidates);
+                UNUSED(enableGoogleLogging);
+                UNUSED(nmsCoarseToFine);
+                UNUSED(netCacheSize);
+                UNUSED(prewarmNetInputSizes);
+                UNUSED(prewarmBatchSize);
                 error("OpenPose must be compiled with the `USE_CAFFE` macro definition in order to use this"
                       " functionality.", __LINE__, __FUNCTION__, __FILE__);
             #endif
@@ -177,7 +228,11 @@ namespace op
                 log("Starting initialization on thread.", Priority::Low, __LINE__, __FUNCTION__, __FILE__);
                 // Initialize Caffe net
                 addCaffeNetOnThread(upImpl->spCaffeNets, upImpl->spCaffeNetOutputBlobs, upImpl->mPoseModel,
-                                    upImpl->mGpuId, upImpl->mModelFolder, upImpl->mEnableGoogleLogging);
+                                    upImpl->mGpuId, upImpl->mModelFolder, upImpl->mEnableGoogleLogging,
+                                    upImpl->mNetCacheSize);
+                // Pre-warm net cache (with the batch size of the forward passes)
+                for (const auto& netInputSize : upImpl->mPrewarmNetInputSizes)
+                    upImpl->spCaffeNets[0]->reshape({upImpl->mPrewarmBatchSize, 3, netInputSize.y, netInputSize.x});
                 #ifdef USE_CUDA
                     cudaCheck(__LINE__, __FUNCTION__, __FILE__);
                 #endif
@@ -216,97 +271,91 @@ namespace op
 
                 // Resize std::vectors if required
                 const auto numberScales = inputNetData.size();
-                upImpl->mNetInput4DSizes.resize(numberScales);
                 while (upImpl->spCaffeNets.size() < numberScales)
                     addCaffeNetOnThread(upImpl->spCaffeNets, upImpl->spCaffeNetOutputBlobs, upImpl->mPoseModel,
-                                        upImpl->mGpuId, upImpl->mModelFolder, false);
+                                        upImpl->mGpuId, upImpl->mModelFolder, false, upImpl->mNetCacheSize);
 
-                // Process each image
+                // 1. Caffe deep network
+                static const auto sTraceNetId = Tracer::getNameId("PoseExtractorCaffe::net");
                 for (auto i = 0u ; i < inputNetData.size(); i++)
                 {
-                    // 1. Caffe deep network
+                    const TracerScope tracerScope{sTraceNetId};
                     upImpl->spCaffeNets.at(i)->forwardPass(inputNetData[i]);                                   // ~80ms
-
-                    // Reshape blobs if required
-                    // Note: In order to resize to input size to have same results as Matlab, uncomment the commented
-                    // lines
-                    // Note: For dynamic sizes (e.g. a folder with images of different aspect ratio)
-                    if (!vectorsAreEqual(upImpl->mNetInput4DSizes.at(i), inputNetData[i].getSize()))
-                        // || !vectorsAreEqual(upImpl->mScaleInputToNetInputs, scaleInputToNetInputs))
-                    {
-                        upImpl->mNetInput4DSizes.at(i) = inputNetData[i].getSize();
-                        mNetOutputSize = Point<int>{upImpl->mNetInput4DSizes[0][3],
-                                                    upImpl->mNetInput4DSizes[0][2]};
-                        // upImpl->mScaleInputToNetInputs = scaleInputToNetInputs;
-                        reshapePoseExtractorCaffe(upImpl->spResizeAndMergeCaffe, upImpl->spNmsCaffe,
-                                                  upImpl->spBodyPartConnectorCaffe, upImpl->spCaffeNetOutputBlobs,
-                                                  upImpl->spHeatMapsBlob, upImpl->spPeaksBlob,
-                                                  1.f, upImpl->mPoseModel, upImpl->mGpuId);
-                                                  // scaleInputToNetInputs[i], upImpl->mPoseModel);
-                    }
+                    // Output blob of the cached net of this input size
+                    upImpl->spCaffeNetOutputBlobs.at(i) = upImpl->spCaffeNets.at(i)->getOutputBlob();
                 }
 
-                // 2. Resize heat maps + merge different scales
-                const auto caffeNetOutputBlobs = caffeNetSharedToPtr(upImpl->spCaffeNetOutputBlobs);
-                const std::vector<float> floatScaleRatios(scaleInputToNetInputs.begin(), scaleInputToNetInputs.end());
-                upImpl->spResizeAndMergeCaffe->setScaleRatios(floatScaleRatios);
-
-                #ifdef USE_CUDA
-                    //upImpl->spResizeAndMergeCaffe->Forward_cpu(caffeNetOutputBlobs, {upImpl->spHeatMapsBlob.get()}); // ~20ms
-                    upImpl->spResizeAndMergeCaffe->Forward_gpu(caffeNetOutputBlobs, {upImpl->spHeatMapsBlob.get()}); // ~5ms
-                #elif USE_OPENCL
-                    //upImpl->spResizeAndMergeCaffe->Forward_cpu(caffeNetOutputBlobs, {upImpl->spHeatMapsBlob.get()}); // ~20ms
-                    upImpl->spResizeAndMergeCaffe->Forward_ocl(caffeNetOutputBlobs, {upImpl->spHeatMapsBlob.get()});
-                #else
-                    upImpl->spResizeAndMergeCaffe->Forward_cpu(caffeNetOutputBlobs, {upImpl->spHeatMapsBlob.get()}); // ~20ms
-                #endif
-
-                // Get scale net to output (i.e. image input)
-                // Note: In order to resize to input size, (un)comment the following lines
-                const auto scaleProducerToNetInput = resizeGetScaleFactor(inputDataSize, mNetOutputSize);
-                const Point<int> netSize{intRound(scaleProducerToNetInput*inputDataSize.x),
-                                         intRound(scaleProducerToNetInput*inputDataSize.y)};
-                mScaleNetToOutput = {(float)resizeGetScaleFactor(netSize, inputDataSize)};
-                // mScaleNetToOutput = 1.f;
+                // 2-4. Resize heat maps + merge different scales, NMS and connecting body parts
+                postProcess(inputNetData, inputDataSize, scaleInputToNetInputs, false);
+            #else
+                UNUSED(inputNetData);
+                UNUSED(inputDataSize);
+                UNUSED(scaleInputToNetInputs);
+            #endif
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
 
-                // 3. Get peaks by Non-Maximum Suppression
-                upImpl->spNmsCaffe->setThreshold((float)get(PoseProperty::NMSThreshold));
-                const auto nmsOffset = float(0.5/double(mScaleNetToOutput));
-                upImpl->spNmsCaffe->setOffset(Point<float>{nmsOffset, nmsOffset});
-                #ifdef USE_CUDA
-                    //upImpl->spNmsCaffe->Forward_cpu({upImpl->spHeatMapsBlob.get()}, {upImpl->spPeaksBlob.get()}); // ~ 7ms
-                    upImpl->spNmsCaffe->Forward_gpu({upImpl->spHeatMapsBlob.get()}, {upImpl->spPeaksBlob.get()});// ~2ms
-                    cudaCheck(__LINE__, __FUNCTION__, __FILE__);
-                #elif USE_OPENCL
-                    //upImpl->spNmsCaffe->Forward_cpu({upImpl->spHeatMapsBlob.get()}, {upImpl->spPeaksBlob.get()}); // ~ 7ms
-                    upImpl->spNmsCaffe->Forward_ocl({upImpl->spHeatMapsBlob.get()}, {upImpl->spPeaksBlob.get()});
-                #else
-                    upImpl->spNmsCaffe->Forward_cpu({upImpl->spHeatMapsBlob.get()}, {upImpl->spPeaksBlob.get()}); // ~ 7ms
-                #endif
+    void PoseExtractorCaffe::forwardPassBatch(const std::vector<std::vector<Array<float>>>& inputNetData,
+                                              const std::vector<Point<int>>& inputDataSizes,
+                                              const std::vector<std::vector<double>>& scaleInputToNetInputs)
+    {
+        try
+        {
+            #ifdef USE_CAFFE
+                // Keep the frames for postProcessBatchFrame()
+                PoseExtractorNet::forwardPassBatch(inputNetData, inputDataSizes, scaleInputToNetInputs);
+                // Security checks
+                const auto batchSize = (int)inputNetData.size();
+                const auto numberScales = inputNetData[0].size();
+                if (numberScales == 0)
+                    error("Empty inputNetData.", __LINE__, __FUNCTION__, __FILE__);
+                for (auto frame = 0 ; frame < batchSize ; frame++)
+                {
+                    if (inputNetData[frame].size() != numberScales
+                        || scaleInputToNetInputs[frame].size() != numberScales)
+                        error("All the frames must have the same number of scales.",
+                              __LINE__, __FUNCTION__, __FILE__);
+                    for (auto i = 0u ; i < numberScales ; i++)
+                        if (inputNetData[frame][i].empty() || inputNetData[frame][i].getSize(0) != 1
+                            || !vectorsAreEqual(inputNetData[frame][i].getSize(), inputNetData[0][i].getSize()))
+                            error("All the frames must have the same net input sizes (with batch size 1).",
+                                  __LINE__, __FUNCTION__, __FILE__);
+                }
 
-                // 4. Connecting body parts
-                // Get scale net to output (i.e. image input)
-                upImpl->spBodyPartConnectorCaffe->setScaleNetToOutput(mScaleNetToOutput);
-                upImpl->spBodyPartConnectorCaffe->setInterMinAboveThreshold(
-                    (float)get(PoseProperty::ConnectInterMinAboveThreshold)
-                );
-                upImpl->spBodyPartConnectorCaffe->setInterThreshold((float)get(PoseProperty::ConnectInterThreshold));
-                upImpl->spBodyPartConnectorCaffe->setMinSubsetCnt((int)get(PoseProperty::ConnectMinSubsetCnt));
-                upImpl->spBodyPartConnectorCaffe->setMinSubsetScore((float)get(PoseProperty::ConnectMinSubsetScore));
+                // Resize std::vectors if required
+                while (upImpl->spCaffeNets.size() < numberScales)
+                    addCaffeNetOnThread(upImpl->spCaffeNets, upImpl->spCaffeNetOutputBlobs, upImpl->mPoseModel,
+                                        upImpl->mGpuId, upImpl->mModelFolder, false, upImpl->mNetCacheSize);
+                while (upImpl->spBatchFrameOutputBlobs.size() < numberScales)
+                    upImpl->spBatchFrameOutputBlobs.emplace_back(new caffe::Blob<float>(1,1,1,1));
+                upImpl->mBatchNetInputs.resize(numberScales);
 
-                // CUDA version not implemented yet
-                // #ifdef USE_CUDA
-                //     upImpl->spBodyPartConnectorCaffe->Forward_gpu({upImpl->spHeatMapsBlob.get(),
-                //                                                    upImpl->spPeaksBlob.get()},
-                //                                                   mPoseKeypoints, mPoseScores);
-                // #else
-                    upImpl->spBodyPartConnectorCaffe->Forward_cpu({upImpl->spHeatMapsBlob.get(),
-                                                                   upImpl->spPeaksBlob.get()},
-                                                                  mPoseKeypoints, mPoseScores);
-                // #endif
+                // 1. Caffe deep network: a single N-batch forward pass per scale
+                static const auto sTraceNetId = Tracer::getNameId("PoseExtractorCaffe::net");
+                for (auto i = 0u ; i < numberScales ; i++)
+                {
+                    const TracerScope tracerScope{sTraceNetId};
+                    // Frames concatenated into a [N x 3 x height x width] Array (reused while N and size are kept)
+                    auto batchInputSize = inputNetData[0][i].getSize();
+                    batchInputSize[0] = batchSize;
+                    auto& batchNetInput = upImpl->mBatchNetInputs[i];
+                    if (!vectorsAreEqual(batchNetInput.getSize(), batchInputSize))
+                        batchNetInput.reset(batchInputSize);
+                    const auto frameVolume = inputNetData[0][i].getVolume();
+                    for (auto frame = 0 ; frame < batchSize ; frame++)
+                        std::copy(inputNetData[frame][i].getConstPtr(),
+                                  inputNetData[frame][i].getConstPtr() + frameVolume,
+                                  batchNetInput.getPtr() + frame * frameVolume);
+                    upImpl->spCaffeNets.at(i)->forwardPass(batchNetInput);
+                    upImpl->spCaffeNetOutputBlobs.at(i) = upImpl->spCaffeNets.at(i)->getOutputBlob();
+                }
             #else
                 UNUSED(inputNetData);
-                UNUSED(inputDataSize);
+                UNUSED(inputDataSizes);
                 UNUSED(scaleInputToNetInputs);
             #endif
         }
@@ -316,6 +365,45 @@ namespace op
         }
     }
 
+    void PoseExtractorCaffe::postProcessBatchFrame(const int frameIndex)
+    {
+        try
+        {
+            #ifdef USE_CAFFE
+                const auto& inputNetData = mBatchInputNetData.at(frameIndex);
+                // Net output of frameIndex copied into its own 1-frame blobs (small compared to the heat maps)
+                for (auto i = 0u ; i < inputNetData.size() ; i++)
+                {
+                    const auto& netOutputBlob = upImpl->spCaffeNetOutputBlobs.at(i);
+                    auto& frameOutputBlob = upImpl->spBatchFrameOutputBlobs.at(i);
+                    if (frameIndex >= netOutputBlob->shape(0))
+                        error("frameIndex out of the last forwardPassBatch().", __LINE__, __FUNCTION__, __FILE__);
+                    frameOutputBlob->Reshape(1, netOutputBlob->shape(1), netOutputBlob->shape(2),
+                                             netOutputBlob->shape(3));
+                    const auto frameCount = frameOutputBlob->count();
+                    #ifdef USE_CUDA
+                        cudaMemcpy(frameOutputBlob->mutable_gpu_data(),
+                                   netOutputBlob->gpu_data() + frameIndex * frameCount,
+                                   frameCount * sizeof(float), cudaMemcpyDeviceToDevice);
+                        cudaCheck(__LINE__, __FUNCTION__, __FILE__);
+                    #else
+                        const auto* const frameOutputPtr = netOutputBlob->cpu_data() + frameIndex * frameCount;
+                        std::copy(frameOutputPtr, frameOutputPtr + frameCount, frameOutputBlob->mutable_cpu_data());
+                    #endif
+                }
+                // 2-4. Resize heat maps + merge different scales, NMS and connecting body parts
+                postProcess(inputNetData, mBatchInputDataSizes.at(frameIndex),
+                            mBatchScaleInputToNetInputs.at(frameIndex), true);
+            #else
+                UNUSED(frameIndex);
+            #endif
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
     const float* PoseExtractorCaffe::getCandidatesCpuConstPtr() const
     {
         try
@@ -424,4 +512,148 @@ namespace op
             return nullptr;
         }
     }
+
+    void PoseExtractorCaffe::postProcess(const std::vector<Array<float>>& inputNetData,
+                                         const Point<int>& inputDataSize,
+                                         const std::vector<double>& scaleInputToNetInputs, const bool batchFrame)
+    {
+        try
+        {
+            #ifdef USE_CAFFE
+                // Net output of the frame (its own blobs in batch mode, so the layers below see a 1-frame output)
+                auto& netOutputBlobs = (batchFrame
+                    ? upImpl->spBatchFrameOutputBlobs : upImpl->spCaffeNetOutputBlobs);
+                const auto numberScales = inputNetData.size();
+                upImpl->mNetInput4DSizes.resize(numberScales);
+
+                // Tracer spans (host time, i.e., asynchronous GPU work is attributed to the next synchronizing step)
+                static const auto sTraceResizeAndMergeId = Tracer::getNameId("PoseExtractorCaffe::resizeAndMerge");
+                static const auto sTraceNmsId = Tracer::getNameId("PoseExtractorCaffe::nms");
+                static const auto sTraceBodyPartConnectorId = Tracer::getNameId(
+                    "PoseExtractorCaffe::bodyPartConnector");
+
+                // Process each image
+                for (auto i = 0u ; i < numberScales ; i++)
+                {
+                    // Reshape blobs if required
+                    // Note: In order to resize to input size to have same results as Matlab, uncomment the commented
+                    // lines
+                    // Note: For dynamic sizes (e.g. a folder with images of different aspect ratio)
+                    if (!vectorsAreEqual(upImpl->mNetInput4DSizes.at(i), inputNetData[i].getSize()))
+                        // || !vectorsAreEqual(upImpl->mScaleInputToNetInputs, scaleInputToNetInputs))
+                    {
+                        upImpl->mNetInput4DSizes.at(i) = inputNetData[i].getSize();
+                        mNetOutputSize = Point<int>{upImpl->mNetInput4DSizes[0][3],
+                                                    upImpl->mNetInput4DSizes[0][2]};
+                        // upImpl->mScaleInputToNetInputs = scaleInputToNetInputs;
+                        reshapePoseExtractorCaffe(upImpl->spResizeAndMergeCaffe, upImpl->spNmsCaffe,
+                                                  upImpl->spBodyPartConnectorCaffe, netOutputBlobs,
+                                                  upImpl->spHeatMapsBlob, upImpl->spPeaksBlob,
+                                                  1.f, upImpl->mPoseModel, upImpl->mGpuId);
+                                                  // scaleInputToNetInputs[i], upImpl->mPoseModel);
+                    }
+                }
+
+                // 2. Resize heat maps + merge different scales
+                const auto caffeNetOutputBlobs = caffeNetSharedToPtr(netOutputBlobs);
+                const std::vector<float> floatScaleRatios(scaleInputToNetInputs.begin(), scaleInputToNetInputs.end());
+                upImpl->spResizeAndMergeCaffe->setScaleRatios(floatScaleRatios);
+                // Coarse-to-fine NMS: Heat maps only upsampled around the peaks (1 scale only)
+                const auto nmsCoarseToFine = (upImpl->mNmsCoarseToFine && numberScales == 1);
+                const Point<int> upsampledHeatMapSize{upImpl->spHeatMapsBlob->shape(3),
+                                                      upImpl->spHeatMapsBlob->shape(2)};
+
+                if (!nmsCoarseToFine)
+                {
+                    const TracerScope tracerScope{sTraceResizeAndMergeId};
+                    #ifdef USE_CUDA
+                        //upImpl->spResizeAndMergeCaffe->Forward_cpu(caffeNetOutputBlobs, {upImpl->spHeatMapsBlob.get()}); // ~20ms
+                        upImpl->spResizeAndMergeCaffe->Forward_gpu(caffeNetOutputBlobs, {upImpl->spHeatMapsBlob.get()}); // ~5ms
+                    #elif USE_OPENCL
+                        //upImpl->spResizeAndMergeCaffe->Forward_cpu(caffeNetOutputBlobs, {upImpl->spHeatMapsBlob.get()}); // ~20ms
+                        upImpl->spResizeAndMergeCaffe->Forward_ocl(caffeNetOutputBlobs, {upImpl->spHeatMapsBlob.get()});
+                    #else
+                        upImpl->spResizeAndMergeCaffe->Forward_cpu(caffeNetOutputBlobs, {upImpl->spHeatMapsBlob.get()}); // ~20ms
+                    #endif
+                }
+
+                // Get scale net to output (i.e. image input)
+                // Note: In order to resize to input size, (un)comment the following lines
+                const auto scaleProducerToNetInput = resizeGetScaleFactor(inputDataSize, mNetOutputSize);
+                const Point<int> netSize{intRound(scaleProducerToNetInput*inputDataSize.x),
+                                         intRound(scaleProducerToNetInput*inputDataSize.y)};
+                mScaleNetToOutput = {(float)resizeGetScaleFactor(netSize, inputDataSize)};
+                // mScaleNetToOutput = 1.f;
+
+                // 3. Get peaks by Non-Maximum Suppression
+                upImpl->spNmsCaffe->setThreshold((float)get(PoseProperty::NMSThreshold));
+                const auto nmsOffset = float(0.5/double(mScaleNetToOutput));
+                upImpl->spNmsCaffe->setOffset(Point<float>{nmsOffset, nmsOffset});
+                if (nmsCoarseToFine)
+                {
+                    const TracerScope tracerScope{sTraceNmsId};
+                    const auto& netOutputBlob = netOutputBlobs.at(0);
+                    const auto& peaksBlob = upImpl->spPeaksBlob;
+                    nmsCoarseToFineCpu(peaksBlob->mutable_cpu_data(), netOutputBlob->cpu_data(),
+                                       (float)get(PoseProperty::NMSThreshold),
+                                       std::array<int, 4>{peaksBlob->shape(0), peaksBlob->shape(1),
+                                                          peaksBlob->shape(2), peaksBlob->shape(3)},
+                                       std::array<int, 4>{netOutputBlob->shape(0), netOutputBlob->shape(1),
+                                                          netOutputBlob->shape(2), netOutputBlob->shape(3)},
+                                       upsampledHeatMapSize, Point<float>{nmsOffset, nmsOffset});
+                }
+                else
+                {
+                    const TracerScope tracerScope{sTraceNmsId};
+                    #ifdef USE_CUDA
+                        //upImpl->spNmsCaffe->Forward_cpu({upImpl->spHeatMapsBlob.get()}, {upImpl->spPeaksBlob.get()}); // ~ 7ms
+                        upImpl->spNmsCaffe->Forward_gpu({upImpl->spHeatMapsBlob.get()}, {upImpl->spPeaksBlob.get()});// ~2ms
+                        cudaCheck(__LINE__, __FUNCTION__, __FILE__);
+                    #elif USE_OPENCL
+                        //upImpl->spNmsCaffe->Forward_cpu({upImpl->spHeatMapsBlob.get()}, {upImpl->spPeaksBlob.get()}); // ~ 7ms
+                        upImpl->spNmsCaffe->Forward_ocl({upImpl->spHeatMapsBlob.get()}, {upImpl->spPeaksBlob.get()});
+                    #else
+                        upImpl->spNmsCaffe->Forward_cpu({upImpl->spHeatMapsBlob.get()}, {upImpl->spPeaksBlob.get()}); // ~ 7ms
+                    #endif
+                }
+
+                // 4. Connecting body parts
+                // Get scale net to output (i.e. image input)
+                upImpl->spBodyPartConnectorCaffe->setScaleNetToOutput(mScaleNetToOutput);
+                upImpl->spBodyPartConnectorCaffe->setInterMinAboveThreshold(
+                    (float)get(PoseProperty::ConnectInterMinAboveThreshold)
+                );
+                upImpl->spBodyPartConnectorCaffe->setInterThreshold((float)get(PoseProperty::ConnectInterThreshold));
+                upImpl->spBodyPartConnectorCaffe->setMinSubsetCnt((int)get(PoseProperty::ConnectMinSubsetCnt));
+                upImpl->spBodyPartConnectorCaffe->setMinSubsetScore((float)get(PoseProperty::ConnectMinSubsetScore));
+                upImpl->spBodyPartConnectorCaffe->setUpsampledHeatMapSize(
+                    nmsCoarseToFine ? upsampledHeatMapSize : Point<int>{0, 0});
+                auto* const heatMapsOrNetOutputBlob = (nmsCoarseToFine
+                    ? netOutputBlobs.at(0).get() : upImpl->spHeatMapsBlob.get());
+
+                {
+                    const TracerScope tracerScope{sTraceBodyPartConnectorId};
+                    // CUDA version not implemented yet
+                    // #ifdef USE_CUDA
+                    //     upImpl->spBodyPartConnectorCaffe->Forward_gpu({upImpl->spHeatMapsBlob.get(),
+                    //                                                    upImpl->spPeaksBlob.get()},
+                    //                                                   mPoseKeypoints, mPoseScores);
+                    // #else
+                        upImpl->spBodyPartConnectorCaffe->Forward_cpu({heatMapsOrNetOutputBlob,
+                                                                       upImpl->spPeaksBlob.get()},
+                                                                      mPoseKeypoints, mPoseScores);
+                    // #endif
+                }
+            #else
+                UNUSED(inputNetData);
+                UNUSED(inputDataSize);
+                UNUSED(scaleInputToNetInputs);
+                UNUSED(batchFrame);
+            #endif
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
 }
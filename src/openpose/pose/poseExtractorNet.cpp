@@ -94,6 +94,44 @@ namespace op
         }
     }
 
+    void PoseExtractorNet::forwardPassBatch(const std::vector<std::vector<Array<float>>>& inputNetData,
+                                            const std::vector<Point<int>>& inputDataSizes,
+                                            const std::vector<std::vector<double>>& scaleInputToNetInputs)
+    {
+        try
+        {
+            // Security checks
+            if (inputNetData.empty())
+                error("Empty inputNetData.", __LINE__, __FUNCTION__, __FILE__);
+            if (inputNetData.size() != inputDataSizes.size()
+                || inputNetData.size() != scaleInputToNetInputs.size())
+                error("Size(inputNetData) must be same than size(inputDataSizes) and size(scaleInputToNetInputs).",
+                      __LINE__, __FUNCTION__, __FILE__);
+            // Shallow copies (Array<T> data is shared)
+            mBatchInputNetData = inputNetData;
+            mBatchInputDataSizes = inputDataSizes;
+            mBatchScaleInputToNetInputs = scaleInputToNetInputs;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    void PoseExtractorNet::postProcessBatchFrame(const int frameIndex)
+    {
+        try
+        {
+            // No batch support -> frame forward pass
+            forwardPass(mBatchInputNetData.at(frameIndex), mBatchInputDataSizes.at(frameIndex),
+                        mBatchScaleInputToNetInputs.at(frameIndex));
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
     Array<float> PoseExtractorNet::getHeatMapsCopy() const
     {
         try
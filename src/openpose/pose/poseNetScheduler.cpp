@@ -0,0 +1,138 @@
+#include <cmath> // std::sqrt
+#include <openpose/utilities/fastMath.hpp>
+#include <openpose/pose/poseNetScheduler.hpp>
+
+namespace op
+{
+    const auto SPEED_SMOOTHING = 0.5f;
+
+    float getMaxPersonSpeed(const Array<float>& poseKeypoints, const Array<long long>& poseIds,
+                            const Array<float>& lastPoseKeypoints, const Array<long long>& lastPoseIds)
+    {
+        try
+        {
+            // Mean keypoint displacement of the fastest person (people matched by ID)
+            auto maxSpeed = 0.f;
+            if (!poseKeypoints.empty() && !lastPoseKeypoints.empty()
+                && poseKeypoints.getSize(1) == lastPoseKeypoints.getSize(1))
+            {
+                const auto numberBodyParts = poseKeypoints.getSize(1);
+                const auto personArea = numberBodyParts * poseKeypoints.getSize(2);
+                const auto useIds = (poseIds.getVolume() == (size_t)poseKeypoints.getSize(0)
+                                     && lastPoseIds.getVolume() == (size_t)lastPoseKeypoints.getSize(0));
+                for (auto person = 0 ; person < poseKeypoints.getSize(0) ; person++)
+                {
+                    // Find same person on the last frame
+                    auto lastPerson = (useIds ? -1 : person);
+                    if (useIds)
+                    {
+                        for (auto i = 0 ; i < lastPoseKeypoints.getSize(0) ; i++)
+                        {
+                            if (lastPoseIds[i] == poseIds[person])
+                            {
+                                lastPerson = i;
+                                break;
+                            }
+                        }
+                    }
+                    if (lastPerson < 0 || lastPerson >= lastPoseKeypoints.getSize(0))
+                        continue;
+                    // Mean displacement
+                    const auto* keypointPtr = poseKeypoints.getConstPtr() + person * personArea;
+                    const auto* lastKeypointPtr = lastPoseKeypoints.getConstPtr() + lastPerson * personArea;
+                    auto displacement = 0.f;
+                    auto numberValidParts = 0;
+                    for (auto part = 0 ; part < numberBodyParts ; part++)
+                    {
+                        if (keypointPtr[3*part+2] > 0.f && lastKeypointPtr[3*part+2] > 0.f)
+                        {
+                            const auto dx = keypointPtr[3*part] - lastKeypointPtr[3*part];
+                            const auto dy = keypointPtr[3*part+1] - lastKeypointPtr[3*part+1];
+                            displacement += std::sqrt(dx*dx + dy*dy);
+                            numberValidParts++;
+                        }
+                    }
+                    if (numberValidParts > 0)
+                        maxSpeed = fastMax(maxSpeed, displacement / numberValidParts);
+                }
+            }
+            return maxSpeed;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return 0.f;
+        }
+    }
+
+    PoseNetScheduler::PoseNetScheduler(const int maxFramesWithoutNet, const float maxDisplacement) :
+        mMaxFramesWithoutNet{fastMax(0, maxFramesWithoutNet)},
+        mMaxDisplacement{maxDisplacement},
+        mLastNetFrameId{-1ll},
+        mLastDecisionFrameId{-1ll},
+        mLastDecision{true},
+        mSpeed{-1.f},
+        mLastUpdateFrameId{-1ll}
+    {
+        try
+        {
+            if (mMaxDisplacement <= 0.f)
+                error("maxDisplacement must be positive.", __LINE__, __FUNCTION__, __FILE__);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    bool PoseNetScheduler::runNet(const long long frameId)
+    {
+        try
+        {
+            const std::lock_guard<std::mutex> lock{mMutex};
+            if (frameId != mLastDecisionFrameId)
+            {
+                const auto framesSinceNet = frameId - mLastNetFrameId;
+                mLastDecision = (mLastNetFrameId < 0 || mSpeed < 0.f || framesSinceNet <= 0
+                                 || framesSinceNet > mMaxFramesWithoutNet
+                                 || mSpeed * framesSinceNet > mMaxDisplacement);
+                if (mLastDecision)
+                    mLastNetFrameId = frameId;
+                mLastDecisionFrameId = frameId;
+            }
+            return mLastDecision;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return true;
+        }
+    }
+
+    void PoseNetScheduler::update(const Array<float>& poseKeypoints, const Array<long long>& poseIds,
+                                  const long long frameId)
+    {
+        try
+        {
+            const std::lock_guard<std::mutex> lock{mMutex};
+            // Only the first view of each frame is used, and frames processed out of order are ignored
+            if (frameId > mLastUpdateFrameId)
+            {
+                // Speed (pixels/frame)
+                if (mLastUpdateFrameId >= 0)
+                {
+                    const auto speed = getMaxPersonSpeed(poseKeypoints, poseIds, mLastPoseKeypoints, mLastPoseIds)
+                                     / float(frameId - mLastUpdateFrameId);
+                    mSpeed = (mSpeed < 0.f ? speed : SPEED_SMOOTHING * speed + (1.f - SPEED_SMOOTHING) * mSpeed);
+                }
+                mLastPoseKeypoints = poseKeypoints.clone();
+                mLastPoseIds = poseIds.clone();
+                mLastUpdateFrameId = frameId;
+            }
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+}
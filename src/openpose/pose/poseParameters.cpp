@@ -1,8 +1,15 @@
+#include <iterator> // std::begin, std::end
 #include <openpose/pose/poseParametersRender.hpp>
 #include <openpose/pose/poseParameters.hpp>
 
 namespace op
 {
+    // Compile-time topologies (single definition of their tables, declared in poseParameters.hpp)
+    constexpr unsigned int PoseTopologyCoco::BODY_PART_PAIRS[];
+    constexpr unsigned int PoseTopologyCoco::MAP_INDEX[];
+    constexpr unsigned int PoseTopologyMpi::BODY_PART_PAIRS[];
+    constexpr unsigned int PoseTopologyMpi::MAP_INDEX[];
+
     // Body parts mapping
     const std::map<unsigned int, std::string> POSE_MPI_BODY_PARTS {
         {0,  "Head"},
@@ -140,17 +147,14 @@ namespace op
     // More information: Page 6 of http://www.mccc.edu/~behrensb/documents/TheHandbig.pdf
     const std::array<std::vector<unsigned int>, (int)PoseModel::Size> POSE_MAP_INDEX{
         // COCO
-        std::vector<unsigned int>{
-            31,32, 39,40, 33,34, 35,36, 41,42, 43,44, 19,20, 21,22, 23,24, 25,26, 27,28, 29,30, 47,48, 49,50, 53,54, 51,52, 55,56, 37,38, 45,46
-        },
+        std::vector<unsigned int>(std::begin(PoseTopologyCoco::MAP_INDEX),
+                                  std::end(PoseTopologyCoco::MAP_INDEX)),
         // MPI_15
-        std::vector<unsigned int>{
-            16,17, 18,19, 20,21, 22,23, 24,25, 26,27, 28,29, 30,31, 32,33, 34,35, 36,37, 38,39, 40,41, 42,43
-        },
+        std::vector<unsigned int>(std::begin(PoseTopologyMpi::MAP_INDEX),
+                                  std::end(PoseTopologyMpi::MAP_INDEX)),
         // MPI_15_4
-        std::vector<unsigned int>{
-            16,17, 18,19, 20,21, 22,23, 24,25, 26,27, 28,29, 30,31, 32,33, 34,35, 36,37, 38,39, 40,41, 42,43
-        },
+        std::vector<unsigned int>(std::begin(PoseTopologyMpi::MAP_INDEX),
+                                  std::end(PoseTopologyMpi::MAP_INDEX)),
         // BODY_18
         std::vector<unsigned int>{
             31,32, 39,40, 33,34, 35,36, 41,42, 43,44, 19,20, 21,22, 23,24, 25,26, 27,28, 29,30, 47,48, 49,50, 53,54, 51,52, 55,56, 37,38, 45,46
@@ -223,13 +227,14 @@ namespace op
     };
     const std::array<std::vector<unsigned int>, (int)PoseModel::Size> POSE_BODY_PART_PAIRS{
         // COCO
-        std::vector<unsigned int>{
-            1,2,   1,5,   2,3,   3,4,   5,6,   6,7,   1,8,   8,9,   9,10,  1,11,  11,12, 12,13,  1,0,   0,14, 14,16,  0,15, 15,17,  2,16,  5,17
-        },
+        std::vector<unsigned int>(std::begin(PoseTopologyCoco::BODY_PART_PAIRS),
+                                  std::end(PoseTopologyCoco::BODY_PART_PAIRS)),
         // MPI_15
-        std::vector<unsigned int>{POSE_MPI_PAIRS_RENDER_GPU},
+        std::vector<unsigned int>(std::begin(PoseTopologyMpi::BODY_PART_PAIRS),
+                                  std::end(PoseTopologyMpi::BODY_PART_PAIRS)),
         // MPI_15_4
-        std::vector<unsigned int>{POSE_MPI_PAIRS_RENDER_GPU},
+        std::vector<unsigned int>(std::begin(PoseTopologyMpi::BODY_PART_PAIRS),
+                                  std::end(PoseTopologyMpi::BODY_PART_PAIRS)),
         // BODY_18
         std::vector<unsigned int>{
             1,2,   1,5,   2,3,   3,4,   5,6,   6,7,   1,8,   8,9,   9,10,  1,11,  11,12, 12,13,  1,0,   0,14, 14,16,  0,15, 15,17,  2,16,  5,17
@@ -6,6 +6,7 @@ namespace op
     DEFINE_TEMPLATE_DATUM(Queue);
     template class OP_API QueueBase<DATUM_BASE, std::queue<DATUM_BASE>>;
     template class OP_API QueueBase<DATUM_BASE, std::priority_queue<DATUM_BASE, std::vector<DATUM_BASE>, std::greater<DATUM_BASE>>>;
+    DEFINE_TEMPLATE_DATUM(RingQueue);
     DEFINE_TEMPLATE_DATUM(SubThread);
     DEFINE_TEMPLATE_DATUM(SubThreadNoQueue);
     DEFINE_TEMPLATE_DATUM(SubThreadQueueIn);
@@ -0,0 +1,301 @@
+#include <exception> // std::exception_ptr, std::current_exception, std::rethrow_exception
+#include <openpose/utilities/fastMath.hpp>
+#include <openpose/thread/threadPool.hpp>
+
+namespace op
+{
+    // Pool and deque index of the current thread (if it belongs to a ThreadPool)
+    thread_local const ThreadPool* tlsThreadPool = nullptr;
+    thread_local unsigned int tlsThreadIndex = 0u;
+
+    // Default ThreadPool of parallelFor
+    std::mutex sDefaultThreadPoolMutex;
+    std::shared_ptr<ThreadPool> spDefaultThreadPool;
+
+    // Chunks per thread, so faster threads can take over the remaining work
+    const auto CHUNKS_PER_THREAD = 4;
+
+    struct ParallelForState
+    {
+        std::function<void(const int, const int)> function;
+        int size;
+        int chunkSize;
+        int numberChunks;
+        std::atomic<int> nextChunk;
+        std::atomic<int> numberRemainingChunks;
+        std::mutex exceptionMutex;
+        std::exception_ptr exceptionPtr;
+    };
+
+    void runChunks(ParallelForState& parallelForState)
+    {
+        // Each thread takes the next chunk until there are none left
+        for (auto chunk = parallelForState.nextChunk++ ; chunk < parallelForState.numberChunks ;
+             chunk = parallelForState.nextChunk++)
+        {
+            try
+            {
+                const auto startIndex = chunk * parallelForState.chunkSize;
+                const auto endIndex = fastMin(parallelForState.size, startIndex + parallelForState.chunkSize);
+                parallelForState.function(startIndex, endIndex);
+            }
+            catch (...)
+            {
+                const std::lock_guard<std::mutex> lock{parallelForState.exceptionMutex};
+                if (!parallelForState.exceptionPtr)
+                    parallelForState.exceptionPtr = std::current_exception();
+            }
+            parallelForState.numberRemainingChunks--;
+        }
+    }
+
+    ThreadPool::ThreadPool(const int numberThreads) :
+        mStop{false},
+        mNumberPendingTasks{0ll}
+    {
+        try
+        {
+            const auto finalNumberThreads = (unsigned int)(numberThreads >= 0
+                ? numberThreads : fastMax(1, (int)std::thread::hardware_concurrency() - 1));
+            for (auto i = 0u ; i < finalNumberThreads + 1 ; i++)
+                mTaskDeques.emplace_back(new TaskDeque{});
+            for (auto i = 0u ; i < finalNumberThreads ; i++)
+                mThreads.emplace_back(&ThreadPool::threadFunction, this, i);
+            log("ThreadPool with " + std::to_string(finalNumberThreads) + " threads.", Priority::Low,
+                __LINE__, __FUNCTION__, __FILE__);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    ThreadPool::~ThreadPool()
+    {
+        try
+        {
+            {
+                const std::lock_guard<std::mutex> lock{mSleepMutex};
+                mStop = true;
+            }
+            mSleepConditionVariable.notify_all();
+            for (auto& thread : mThreads)
+                if (thread.joinable())
+                    thread.join();
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    unsigned int ThreadPool::getNumberThreads() const
+    {
+        try
+        {
+            return (unsigned int)mThreads.size();
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return 0u;
+        }
+    }
+
+    void ThreadPool::submit(const std::function<void()>& task)
+    {
+        try
+        {
+            const auto dequeIndex = (tlsThreadPool == this ? tlsThreadIndex : (unsigned int)mThreads.size());
+            {
+                const std::lock_guard<std::mutex> lock{mTaskDeques[dequeIndex]->mutex};
+                mTaskDeques[dequeIndex]->tasks.emplace_back(task);
+            }
+            mNumberPendingTasks++;
+            // Wake up a sleeping thread (the lock avoids missing a thread about to sleep)
+            {
+                const std::lock_guard<std::mutex> lock{mSleepMutex};
+            }
+            mSleepConditionVariable.notify_one();
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    void ThreadPool::parallelFor(const int size, const std::function<void(const int, const int)>& function,
+                                 const int minChunkSize)
+    {
+        try
+        {
+            if (size <= 0)
+                return;
+            // Split into chunks
+            const auto maxNumberChunks = fastMax(1, size / fastMax(1, minChunkSize));
+            const auto numberChunks = fastMin(maxNumberChunks, CHUNKS_PER_THREAD * (int)(mThreads.size() + 1));
+            if (numberChunks < 2)
+            {
+                function(0, size);
+                return;
+            }
+            // Shared with the helper tasks, which might start after this function returned
+            auto parallelForState = std::make_shared<ParallelForState>();
+            parallelForState->function = function;
+            parallelForState->size = size;
+            parallelForState->chunkSize = (size + numberChunks - 1) / numberChunks;
+            parallelForState->numberChunks = (size + parallelForState->chunkSize - 1) / parallelForState->chunkSize;
+            parallelForState->nextChunk = 0;
+            parallelForState->numberRemainingChunks = parallelForState->numberChunks;
+            // Helper tasks (any idle thread can steal them)
+            const auto numberHelpers = fastMin((int)mThreads.size(), parallelForState->numberChunks - 1);
+            for (auto i = 0 ; i < numberHelpers ; i++)
+                submit([parallelForState]{ runChunks(*parallelForState); });
+            // This thread also works, and then it runs other pending tasks until all chunks are done
+            runChunks(*parallelForState);
+            while (parallelForState->numberRemainingChunks > 0)
+                if (!runPendingTask())
+                    std::this_thread::yield();
+            if (parallelForState->exceptionPtr)
+                std::rethrow_exception(parallelForState->exceptionPtr);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    bool ThreadPool::runPendingTask()
+    {
+        try
+        {
+            std::function<void()> task;
+            const auto dequeIndex = (tlsThreadPool == this ? tlsThreadIndex : (unsigned int)mThreads.size());
+            if (!popTask(dequeIndex, task))
+                return false;
+            task();
+            return true;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return false;
+        }
+    }
+
+    void ThreadPool::threadFunction(const unsigned int threadIndex)
+    {
+        try
+        {
+            tlsThreadPool = this;
+            tlsThreadIndex = threadIndex;
+            while (true)
+            {
+                std::function<void()> task;
+                if (popTask(threadIndex, task))
+                    task();
+                else
+                {
+                    std::unique_lock<std::mutex> lock{mSleepMutex};
+                    mSleepConditionVariable.wait(lock, [this]{ return mStop || mNumberPendingTasks > 0; });
+                    if (mStop && mNumberPendingTasks == 0)
+                        break;
+                }
+            }
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    bool ThreadPool::popTask(const unsigned int dequeIndex, std::function<void()>& task)
+    {
+        try
+        {
+            if (mNumberPendingTasks <= 0)
+                return false;
+            // Own deque (newest task first, its data is more likely in cache)
+            {
+                auto& taskDeque = *mTaskDeques[dequeIndex];
+                const std::lock_guard<std::mutex> lock{taskDeque.mutex};
+                if (!taskDeque.tasks.empty())
+                {
+                    task = std::move(taskDeque.tasks.back());
+                    taskDeque.tasks.pop_back();
+                    mNumberPendingTasks--;
+                    return true;
+                }
+            }
+            // Steal the oldest task of another deque
+            for (auto i = 1u ; i < mTaskDeques.size() ; i++)
+            {
+                auto& taskDeque = *mTaskDeques[(dequeIndex + i) % mTaskDeques.size()];
+                const std::lock_guard<std::mutex> lock{taskDeque.mutex};
+                if (!taskDeque.tasks.empty())
+                {
+                    task = std::move(taskDeque.tasks.front());
+                    taskDeque.tasks.pop_front();
+                    mNumberPendingTasks--;
+                    return true;
+                }
+            }
+            return false;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return false;
+        }
+    }
+
+    void setDefaultThreadPool(const std::shared_ptr<ThreadPool>& threadPool)
+    {
+        try
+        {
+            const std::lock_guard<std::mutex> lock{sDefaultThreadPoolMutex};
+            spDefaultThreadPool = threadPool;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    std::shared_ptr<ThreadPool> getDefaultThreadPool()
+    {
+        try
+        {
+            const std::lock_guard<std::mutex> lock{sDefaultThreadPoolMutex};
+            return spDefaultThreadPool;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return nullptr;
+        }
+    }
+
+    void parallelFor(const int size, const std::function<void(const int, const int)>& function,
+                     const int minChunkSize)
+    {
+        try
+        {
+            if (size >= 2 * fastMax(1, minChunkSize))
+            {
+                const auto threadPool = getDefaultThreadPool();
+                if (threadPool != nullptr && threadPool->getNumberThreads() > 0)
+                {
+                    threadPool->parallelFor(size, function, minChunkSize);
+                    return;
+                }
+            }
+            if (size > 0)
+                function(0, size);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+}
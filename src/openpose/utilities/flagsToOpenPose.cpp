@@ -6,6 +6,7 @@
 #include <openpose/producer/webcamReader.hpp>
 #include <openpose/utilities/check.hpp>
 #include <openpose/utilities/flagsToOpenPose.hpp>
+#include <openpose/utilities/string.hpp>
 
 namespace op
 {
@@ -297,6 +298,22 @@ namespace op
         }
     }
 
+    QueuePolicy flagsToQueuePolicy(const int queuePolicy)
+    {
+        try
+        {
+            if (queuePolicy < 0 || queuePolicy >= (int)QueuePolicy::Size)
+                error("Undefined QueuePolicy selected (it must be in the range [0, "
+                      + std::to_string((int)QueuePolicy::Size - 1) + "]).", __LINE__, __FUNCTION__, __FILE__);
+            return (QueuePolicy)queuePolicy;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return QueuePolicy::Block;
+        }
+    }
+
     Point<int> flagsToPoint(const std::string& pointString, const std::string& pointExample)
     {
         try
@@ -313,4 +330,22 @@ namespace op
             return Point<int>{};
         }
     }
+
+    std::vector<Point<int>> flagsToPoints(const std::string& pointsString, const std::string& pointExample)
+    {
+        try
+        {
+            // Comma-separated points (empty string = no points)
+            std::vector<Point<int>> points;
+            for (const auto& pointString : splitString(pointsString, ","))
+                if (!pointString.empty())
+                    points.emplace_back(flagsToPoint(pointString, pointExample));
+            return points;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return {};
+        }
+    }
 }
@@ -0,0 +1,411 @@
+#include <cmath> // std::ceil
+#include <condition_variable>
+#include <cstdlib> // std::free
+#include <fstream> // std::ofstream
+#include <map>
+#include <mutex>
+#include <sstream> // std::stringstream
+#include <thread>
+#ifdef __GNUG__
+    #include <cxxabi.h> // abi::__cxa_demangle
+#endif
+#include <openpose/utilities/fastMath.hpp>
+#include <openpose/utilities/metrics.hpp>
+#include <openpose/utilities/string.hpp>
+
+namespace op
+{
+    // Registered metrics
+    std::mutex sMetricsMutex;
+    std::map<std::string, std::shared_ptr<std::atomic<unsigned long long>>> sCounters;
+    std::map<std::string, std::shared_ptr<Histogram>> sHistograms;
+    std::atomic<bool> sMetricsEnabled{false};
+
+    // Periodic dump (declared after the metrics, so it is destroyed (and its thread joined) before them)
+    struct MetricsDumper
+    {
+        std::mutex mutex;
+        std::condition_variable conditionVariable;
+        std::thread thread;
+        bool stop = false;
+
+        void start(const std::string& filePath, const double dumpIntervalSeconds)
+        {
+            stopAndJoin();
+            const std::lock_guard<std::mutex> lock{mutex};
+            stop = false;
+            thread = std::thread{[this, filePath, dumpIntervalSeconds]
+            {
+                const auto interval = std::chrono::duration<double>{fastMax(0.001, dumpIntervalSeconds)};
+                std::unique_lock<std::mutex> lock{mutex};
+                while (!stop)
+                {
+                    conditionVariable.wait_for(lock, interval, [this]{ return stop; });
+                    // Exceptions must not leave the thread (std::terminate), so the dump stops instead
+                    try
+                    {
+                        Metrics::writeToFile(filePath);
+                    }
+                    catch (const std::exception& e)
+                    {
+                        log("Metrics could not be written into `" + filePath + "`, periodic dump stopped: "
+                            + std::string{e.what()}, Priority::High, __LINE__, __FUNCTION__, __FILE__);
+                        break;
+                    }
+                }
+            }};
+        }
+
+        void stopAndJoin()
+        {
+            {
+                const std::lock_guard<std::mutex> lock{mutex};
+                stop = true;
+            }
+            conditionVariable.notify_all();
+            if (thread.joinable())
+                thread.join();
+        }
+
+        ~MetricsDumper()
+        {
+            stopAndJoin();
+        }
+    };
+    MetricsDumper sMetricsDumper;
+
+    unsigned int getBucketIndex(const unsigned long long value, const int subBucketBits)
+    {
+        // Values < 2^subBucketBits: 1 bucket per value
+        const auto numberSubBuckets = 1ull << subBucketBits;
+        if (value < numberSubBuckets)
+            return (unsigned int)value;
+        // Otherwise: numberSubBuckets buckets for each power of 2
+        auto shift = 0u;
+        while ((value >> shift) >= 2 * numberSubBuckets)
+            shift++;
+        return (unsigned int)((shift + 1) * numberSubBuckets + ((value >> shift) - numberSubBuckets));
+    }
+
+    unsigned long long getBucketUpperBound(const unsigned int bucketIndex, const int subBucketBits)
+    {
+        const auto numberSubBuckets = 1ull << subBucketBits;
+        if (bucketIndex < numberSubBuckets)
+            return bucketIndex;
+        const auto shift = bucketIndex / numberSubBuckets - 1;
+        const auto lowerBound = (numberSubBuckets + bucketIndex % numberSubBuckets) << shift;
+        return lowerBound + ((1ull << shift) - 1);
+    }
+
+    Histogram::Histogram() :
+        mCount{0ull},
+        mSum{0ull},
+        mMax{0ull}
+    {
+        try
+        {
+            for (auto& bucket : mBuckets)
+                bucket = 0ull;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    void Histogram::record(const unsigned long long value)
+    {
+        try
+        {
+            mBuckets[getBucketIndex(value, SUB_BUCKET_BITS)].fetch_add(1ull, std::memory_order_relaxed);
+            mCount.fetch_add(1ull, std::memory_order_relaxed);
+            mSum.fetch_add(value, std::memory_order_relaxed);
+            auto currentMax = mMax.load(std::memory_order_relaxed);
+            while (value > currentMax
+                   && !mMax.compare_exchange_weak(currentMax, value, std::memory_order_relaxed))
+            {
+            }
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    unsigned long long Histogram::getCount() const
+    {
+        try
+        {
+            return mCount.load(std::memory_order_relaxed);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return 0ull;
+        }
+    }
+
+    double Histogram::getMean() const
+    {
+        try
+        {
+            const auto count = getCount();
+            return (count > 0 ? mSum.load(std::memory_order_relaxed) / (double)count : 0.);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return 0.;
+        }
+    }
+
+    unsigned long long Histogram::getMax() const
+    {
+        try
+        {
+            return mMax.load(std::memory_order_relaxed);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return 0ull;
+        }
+    }
+
+    unsigned long long Histogram::getPercentile(const double percentile) const
+    {
+        try
+        {
+            // Bucket counts might be updated meanwhile, so they are added up rather than using mCount
+            std::array<unsigned long long, NUMBER_BUCKETS> buckets;
+            auto count = 0ull;
+            for (auto i = 0u ; i < buckets.size() ; i++)
+            {
+                buckets[i] = mBuckets[i].load(std::memory_order_relaxed);
+                count += buckets[i];
+            }
+            if (count == 0)
+                return 0ull;
+            const auto rank = fastMax(1ull, (unsigned long long)std::ceil(
+                fastTruncate(percentile, 0., 100.) / 100. * count));
+            auto accumulated = 0ull;
+            for (auto i = 0u ; i < buckets.size() ; i++)
+            {
+                accumulated += buckets[i];
+                if (accumulated >= rank)
+                    return fastMin(getBucketUpperBound(i, SUB_BUCKET_BITS), getMax());
+            }
+            return getMax();
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return 0ull;
+        }
+    }
+
+    void Histogram::reset()
+    {
+        try
+        {
+            for (auto& bucket : mBuckets)
+                bucket = 0ull;
+            mCount = 0ull;
+            mSum = 0ull;
+            mMax = 0ull;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    void Metrics::enable(const std::string& filePath, const double dumpIntervalSeconds)
+    {
+        try
+        {
+            sMetricsEnabled = true;
+            if (!filePath.empty())
+                sMetricsDumper.start(filePath, dumpIntervalSeconds);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    void Metrics::disable()
+    {
+        try
+        {
+            sMetricsEnabled = false;
+            sMetricsDumper.stopAndJoin();
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    bool Metrics::isEnabled()
+    {
+        try
+        {
+            return sMetricsEnabled;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return false;
+        }
+    }
+
+    std::shared_ptr<std::atomic<unsigned long long>> Metrics::getCounter(const std::string& name)
+    {
+        try
+        {
+            const std::lock_guard<std::mutex> lock{sMetricsMutex};
+            auto& spCounter = sCounters[name];
+            if (spCounter == nullptr)
+                spCounter = std::make_shared<std::atomic<unsigned long long>>(0ull);
+            return spCounter;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return nullptr;
+        }
+    }
+
+    std::shared_ptr<Histogram> Metrics::getHistogram(const std::string& name)
+    {
+        try
+        {
+            const std::lock_guard<std::mutex> lock{sMetricsMutex};
+            auto& spHistogram = sHistograms[name];
+            if (spHistogram == nullptr)
+                spHistogram = std::make_shared<Histogram>();
+            return spHistogram;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return nullptr;
+        }
+    }
+
+    std::string Metrics::toJson()
+    {
+        try
+        {
+            std::stringstream json;
+            const auto timeMs = std::chrono::duration_cast<std::chrono::milliseconds>(
+                std::chrono::system_clock::now().time_since_epoch()).count();
+            json << "{\"time_ms\":" << timeMs << ",\"counters\":{";
+            const std::lock_guard<std::mutex> lock{sMetricsMutex};
+            auto first = true;
+            for (const auto& counter : sCounters)
+            {
+                json << (first ? "" : ",") << toJsonString(counter.first) << ":" << counter.second->load();
+                first = false;
+            }
+            json << "},\"histograms\":{";
+            first = true;
+            for (const auto& histogram : sHistograms)
+            {
+                const auto& spHistogram = histogram.second;
+                json << (first ? "" : ",") << toJsonString(histogram.first)
+                     << ":{\"count\":" << spHistogram->getCount() << ",\"mean\":" << spHistogram->getMean()
+                     << ",\"p50\":" << spHistogram->getPercentile(50.)
+                     << ",\"p90\":" << spHistogram->getPercentile(90.)
+                     << ",\"p99\":" << spHistogram->getPercentile(99.)
+                     << ",\"max\":" << spHistogram->getMax() << "}";
+                first = false;
+            }
+            json << "}}";
+            return json.str();
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return "";
+        }
+    }
+
+    void Metrics::writeToFile(const std::string& filePath)
+    {
+        try
+        {
+            std::ofstream outputFile{filePath, std::ios::app};
+            if (!outputFile.is_open())
+                error("Metrics file could not be opened: " + filePath, __LINE__, __FUNCTION__, __FILE__);
+            outputFile << toJson() << "\n";
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    void Metrics::reset()
+    {
+        try
+        {
+            const std::lock_guard<std::mutex> lock{sMetricsMutex};
+            for (auto& counter : sCounters)
+                *counter.second = 0ull;
+            for (auto& histogram : sHistograms)
+                histogram.second->reset();
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    std::chrono::high_resolution_clock::time_point Metrics::now()
+    {
+        return std::chrono::high_resolution_clock::now();
+    }
+
+    unsigned long long Metrics::microsecondsSince(const std::chrono::high_resolution_clock::time_point& start)
+    {
+        try
+        {
+            return (unsigned long long)fastMax(0ll, (long long)std::chrono::duration_cast<std::chrono::microseconds>(
+                std::chrono::high_resolution_clock::now() - start).count());
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return 0ull;
+        }
+    }
+
+    std::string Metrics::getTypeName(const std::type_info& typeInfo)
+    {
+        try
+        {
+            std::string typeName;
+            #ifdef __GNUG__
+                auto status = 0;
+                std::unique_ptr<char, void(*)(void*)> demangledName{
+                    abi::__cxa_demangle(typeInfo.name(), nullptr, nullptr, &status), std::free};
+                typeName = (status == 0 && demangledName != nullptr ? demangledName.get() : typeInfo.name());
+            #else
+                // MSVC: "class op::WName<...>"
+                typeName = typeInfo.name();
+                for (const auto& prefix : {std::string{"class "}, std::string{"struct "}})
+                    if (typeName.compare(0, prefix.size(), prefix) == 0)
+                        typeName = typeName.substr(prefix.size());
+            #endif
+            // Template arguments removed (they are the same TDatums for all the Workers)
+            return typeName.substr(0, typeName.find('<'));
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return "";
+        }
+    }
+}
@@ -1,4 +1,5 @@
 #include <algorithm> // std::transform
+#include <cstdio> // std::snprintf
 #include <openpose/utilities/string.hpp>
 
 namespace op
@@ -100,6 +101,41 @@ namespace op
         }
     }
 
+    std::string toJsonString(const std::string& text)
+    {
+        try
+        {
+            std::string jsonString{"\""};
+            for (const auto character : text)
+            {
+                if (character == '"' || character == '\\')
+                {
+                    jsonString += '\\';
+                    jsonString += character;
+                }
+                else if (character == '\n')
+                    jsonString += "\\n";
+                else if (character == '\t')
+                    jsonString += "\\t";
+                // Remaining control characters
+                else if ((unsigned char)character < 0x20)
+                {
+                    char escaped[7];
+                    std::snprintf(escaped, sizeof(escaped), "\\u%04x", (unsigned int)(unsigned char)character);
+                    jsonString += escaped;
+                }
+                else
+                    jsonString += character;
+            }
+            return jsonString + "\"";
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return "\"\"";
+        }
+    }
+
 
     // Signed
     template std::string toFixedLengthString<char>(const char number, const unsigned long long stringLength);
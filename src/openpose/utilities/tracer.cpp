@@ -0,0 +1,228 @@
+#include <atomic>
+#include <fstream> // std::ofstream
+#include <iomanip> // std::setprecision
+#include <map>
+#include <mutex>
+#include <vector>
+#include <openpose/utilities/fastMath.hpp>
+#include <openpose/utilities/string.hpp>
+#include <openpose/utilities/tracer.hpp>
+
+namespace op
+{
+    struct TracerEvent
+    {
+        unsigned int nameId;
+        unsigned long long datumId;
+        long long startNs;
+        long long durationNs;
+    };
+
+    // Ring buffer of a thread (only that thread writes into it)
+    struct TracerThreadBuffer
+    {
+        unsigned int threadIndex;
+        std::string threadName;
+        std::vector<TracerEvent> events;
+        std::atomic<unsigned long long> numberEvents;
+    };
+
+    std::mutex sTracerMutex;
+    std::atomic<bool> sTracerEnabled{false};
+    std::atomic<unsigned long long> sTracerSession{0ull};
+    std::string sTracerFilePath;
+    unsigned long long sTracerMaxEventsPerThread = 0ull;
+    std::chrono::high_resolution_clock::time_point sTracerStart;
+    std::vector<std::string> sTracerNames;
+    std::map<std::string, unsigned int> sTracerNameIds;
+    std::vector<std::shared_ptr<TracerThreadBuffer>> sTracerThreadBuffers;
+    // Shared with sTracerThreadBuffers, so a new Tracer::enable() call (which releases the buffers of the previous one)
+    // does not free the buffer a thread might be recording into
+    thread_local std::shared_ptr<TracerThreadBuffer> tlsTracerThreadBuffer;
+    // Tracer::enable() call that created tlsTracerThreadBuffer
+    thread_local unsigned long long tlsTracerSession = 0ull;
+
+    TracerThreadBuffer& getThreadBuffer()
+    {
+        // Created once per thread and session (the only lock while recording)
+        if (tlsTracerThreadBuffer == nullptr || tlsTracerSession != sTracerSession)
+        {
+            const std::lock_guard<std::mutex> lock{sTracerMutex};
+            tlsTracerThreadBuffer = std::make_shared<TracerThreadBuffer>();
+            sTracerThreadBuffers.emplace_back(tlsTracerThreadBuffer);
+            tlsTracerThreadBuffer->threadIndex = (unsigned int)sTracerThreadBuffers.size();
+            tlsTracerThreadBuffer->events.resize(sTracerMaxEventsPerThread);
+            tlsTracerThreadBuffer->numberEvents = 0ull;
+            tlsTracerSession = sTracerSession;
+        }
+        return *tlsTracerThreadBuffer;
+    }
+
+    void Tracer::enable(const std::string& filePath, const unsigned long long maxEventsPerThread)
+    {
+        try
+        {
+            const std::lock_guard<std::mutex> lock{sTracerMutex};
+            sTracerFilePath = filePath;
+            sTracerMaxEventsPerThread = fastMax(1ull, maxEventsPerThread);
+            sTracerStart = std::chrono::high_resolution_clock::now();
+            sTracerThreadBuffers.clear();
+            sTracerSession++;
+            sTracerEnabled = true;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    void Tracer::disable()
+    {
+        try
+        {
+            if (sTracerEnabled)
+            {
+                writeToFile();
+                sTracerEnabled = false;
+            }
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    bool Tracer::isEnabled()
+    {
+        return sTracerEnabled.load(std::memory_order_relaxed);
+    }
+
+    unsigned int Tracer::getNameId(const std::string& name)
+    {
+        try
+        {
+            const std::lock_guard<std::mutex> lock{sTracerMutex};
+            const auto nameIdIterator = sTracerNameIds.find(name);
+            if (nameIdIterator != sTracerNameIds.end())
+                return nameIdIterator->second;
+            sTracerNames.emplace_back(name);
+            sTracerNameIds[name] = (unsigned int)(sTracerNames.size() - 1);
+            return (unsigned int)(sTracerNames.size() - 1);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return 0u;
+        }
+    }
+
+    void Tracer::setThreadName(const std::string& name)
+    {
+        try
+        {
+            if (isEnabled())
+            {
+                auto& threadBuffer = getThreadBuffer();
+                const std::lock_guard<std::mutex> lock{sTracerMutex};
+                threadBuffer.threadName = (threadBuffer.threadName.empty() ? name
+                                                                           : threadBuffer.threadName + " + " + name);
+            }
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    void Tracer::addSpan(const unsigned int nameId, const unsigned long long datumId,
+                         const std::chrono::high_resolution_clock::time_point& start,
+                         const std::chrono::high_resolution_clock::time_point& end)
+    {
+        try
+        {
+            if (isEnabled())
+            {
+                auto& threadBuffer = getThreadBuffer();
+                const auto numberEvents = threadBuffer.numberEvents.load(std::memory_order_relaxed);
+                auto& event = threadBuffer.events[numberEvents % threadBuffer.events.size()];
+                event.nameId = nameId;
+                event.datumId = datumId;
+                event.startNs = std::chrono::duration_cast<std::chrono::nanoseconds>(start - sTracerStart).count();
+                event.durationNs = std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
+                threadBuffer.numberEvents.store(numberEvents + 1, std::memory_order_release);
+            }
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    void Tracer::writeToFile()
+    {
+        try
+        {
+            const std::lock_guard<std::mutex> lock{sTracerMutex};
+            if (sTracerFilePath.empty())
+                return;
+            std::ofstream outputFile{sTracerFilePath};
+            if (!outputFile.is_open())
+                error("Trace file could not be opened: " + sTracerFilePath, __LINE__, __FUNCTION__, __FILE__);
+            // Microseconds with nanosecond resolution (no scientific notation for long runs)
+            outputFile << std::fixed << std::setprecision(3);
+            outputFile << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+            auto first = true;
+            for (const auto& threadBuffer : sTracerThreadBuffers)
+            {
+                // Thread name
+                const auto tid = std::to_string(threadBuffer->threadIndex);
+                const auto threadName = (threadBuffer->threadName.empty() ? "thread_" + tid : threadBuffer->threadName);
+                outputFile << (first ? "" : ",") << "\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":"
+                           << tid << ",\"args\":{\"name\":" << toJsonString(threadName) << "}}";
+                first = false;
+                // Spans (oldest first), complete events in microseconds
+                const auto numberEvents = threadBuffer->numberEvents.load(std::memory_order_acquire);
+                const auto bufferSize = (unsigned long long)threadBuffer->events.size();
+                for (auto i = (numberEvents > bufferSize ? numberEvents - bufferSize : 0ull) ; i < numberEvents ; i++)
+                {
+                    const auto& event = threadBuffer->events[i % bufferSize];
+                    outputFile << ",\n{\"name\":" << toJsonString(sTracerNames.at(event.nameId))
+                               << ",\"cat\":\"openpose\",\"ph\":\"X\",\"pid\":1,\"tid\":" << tid
+                               << ",\"ts\":" << event.startNs / 1e3 << ",\"dur\":" << event.durationNs / 1e3;
+                    if (event.datumId != (unsigned long long)-1)
+                        outputFile << ",\"args\":{\"id\":" << event.datumId << "}";
+                    outputFile << "}";
+                }
+            }
+            outputFile << "\n]}\n";
+            log("Trace written in " + sTracerFilePath + ".", Priority::High, __LINE__, __FUNCTION__, __FILE__);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    TracerScope::TracerScope(const unsigned int nameId, const unsigned long long datumId) :
+        mNameId{nameId},
+        mDatumId{datumId},
+        mEnabled{Tracer::isEnabled()}
+    {
+        if (mEnabled)
+            mStart = std::chrono::high_resolution_clock::now();
+    }
+
+    TracerScope::~TracerScope()
+    {
+        try
+        {
+            if (mEnabled)
+                Tracer::addSpan(mNameId, mDatumId, mStart, std::chrono::high_resolution_clock::now());
+        }
+        catch (const std::exception& e)
+        {
+            // Destructor: log instead of throwing
+            log(e.what(), Priority::High, __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+}
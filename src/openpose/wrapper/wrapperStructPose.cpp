@@ -15,7 +15,10 @@ namespace op
                                          const float renderThreshold_, const int numberPeopleMax_,
                                          const bool enableGoogleLogging_, const bool reconstruct3d_,
                                          const int minViews3d_, const bool identification_,
-                                         const int tracking_) :
+                                         const int tracking_, const bool filterKeypoints_,
+                                         const float trackingMaxDisplacement_, const bool nmsCoarseToFine_,
+                                         const int netBatchSize_, const int netCacheSize_,
+                                         const std::vector<Point<int>>& netCacheResolutions_) :
         enable{enable_},
         netInputSize{netInputSize_},
         outputSize{outputSize_},
@@ -40,7 +43,13 @@ namespace op
         reconstruct3d{reconstruct3d_},
         minViews3d{minViews3d_},
         identification{identification_},
-        tracking{tracking_}
+        tracking{tracking_},
+        filterKeypoints{filterKeypoints_},
+        trackingMaxDisplacement{trackingMaxDisplacement_},
+        nmsCoarseToFine{nmsCoarseToFine_},
+        netBatchSize{netBatchSize_},
+        netCacheSize{netCacheSize_},
+        netCacheResolutions{netCacheResolutions_}
     {
     }
 }